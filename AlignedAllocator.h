@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Allocator returning Alignment-byte aligned storage (default: one cache line),
+// so SIMD loops over std::vector data start on a vector boundary.
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t count)
+    {
+        if (count == 0) return nullptr;
+        if (count > size_t(-1) / sizeof(T)) throw std::bad_alloc();
+
+        // aligned_alloc needs the size to be a multiple of the alignment
+        size_t bytes = (count * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+#ifdef _WIN32
+        void* ptr = _aligned_malloc(bytes, Alignment);
+#else
+        void* ptr = std::aligned_alloc(Alignment, bytes);
+#endif
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
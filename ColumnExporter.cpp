@@ -0,0 +1,245 @@
+#include "ColumnExporter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+// Like mkdir -p
+bool makeDirectory(const std::string& path)
+{
+    for (size_t end = path.find_first_of("/\\", 1); ; end = path.find_first_of("/\\", end + 1)) {
+        const std::string prefix = path.substr(0, end);
+#ifdef _WIN32
+        const bool made = _mkdir(prefix.c_str()) == 0;
+#else
+        const bool made = mkdir(prefix.c_str(), 0755) == 0;
+#endif
+        if (!made && errno != EEXIST) return false;
+        if (end == std::string::npos) return true;
+    }
+}
+
+} // namespace
+
+ColumnExporter::ColumnExporter()
+    : m_bytesWritten(0)
+    , m_writeFailed(false)
+{
+    close();
+}
+
+ColumnExporter::~ColumnExporter()
+{
+    close();
+}
+
+bool ColumnExporter::open(const std::string& directory, int tables, std::string* error)
+{
+    close();
+    m_bytesWritten = 0;
+    m_writeFailed = false;
+
+    if (!makeDirectory(directory)) {
+        if (error) *error = "cannot create " + directory + ": " + std::strerror(errno);
+        return false;
+    }
+
+    bool ok = true;
+    auto column = [&](const char* name, Columns::ValueType type) -> Column* {
+        Column* created = ok ? addColumn(directory, name, type, error) : nullptr;
+        ok = created != nullptr;
+        return created;
+    };
+
+    if (tables & Tracks) {
+        m_trackTimestamp = column("tracks.timestamp", Columns::TypeUInt64);
+        m_trackFrame = column("tracks.frame", Columns::TypeUInt64);
+        m_trackId = column("tracks.target_id", Columns::TypeUInt32);
+        m_trackLevel = column("tracks.level", Columns::TypeFloat32);
+        m_trackRadius = column("tracks.radius", Columns::TypeFloat32);
+        m_trackAzimuth = column("tracks.azimuth", Columns::TypeFloat32);
+        m_trackElevation = column("tracks.elevation", Columns::TypeFloat32);
+        m_trackRadialSpeed = column("tracks.radial_speed", Columns::TypeFloat32);
+        m_trackAzimuthSpeed = column("tracks.azimuth_speed", Columns::TypeFloat32);
+        m_trackElevationSpeed = column("tracks.elevation_speed", Columns::TypeFloat32);
+    }
+    if (tables & Detections) {
+        m_detectionTimestamp = column("detections.timestamp", Columns::TypeUInt64);
+        m_detectionFrame = column("detections.frame", Columns::TypeUInt64);
+        m_detectionRange = column("detections.range", Columns::TypeFloat32);
+        m_detectionAzimuth = column("detections.azimuth", Columns::TypeFloat32);
+        m_detectionRadialSpeed = column("detections.radial_speed", Columns::TypeFloat32);
+        m_detectionLevel = column("detections.level", Columns::TypeFloat32);
+    }
+    if (tables & RangeProfiles) {
+        m_profileTimestamp = column("profiles.timestamp", Columns::TypeUInt64);
+        m_profileBinRange = column("profiles.bin_range", Columns::TypeFloat32);
+        m_profileOffset = column("profiles.offset", Columns::TypeUInt64);
+        m_profileDb = column("profiles.db", Columns::TypeFloat32);
+        if (ok) appendUInt64(m_profileOffset, 0, 1);
+    }
+
+    if (!ok || m_columns.empty()) {
+        if (ok && error) *error = "no tables selected";
+        close();
+        return false;
+    }
+    return true;
+}
+
+ColumnExporter::Column* ColumnExporter::addColumn(const std::string& directory, const std::string& name,
+                                                  Columns::ValueType type, std::string* error)
+{
+    const std::string path = directory + "/" + name + ".col";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        if (error) *error = "cannot create " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);   // Writes are already large
+
+    std::unique_ptr<Column> column(new Column());
+    column->file = file;
+    column->type = type;
+    column->elementSize = type == Columns::TypeUInt64 ? 8 : 4;
+    column->name = name;
+    column->buffer.resize(BUFFER_BYTES);
+    column->used = sizeof(ColumnFileHeader);  // Placeholder header, rewritten on close
+    std::memset(column->buffer.data(), 0, column->used);
+    column->count = 0;
+    m_columns.push_back(std::move(column));
+    return m_columns.back().get();
+}
+
+void ColumnExporter::close()
+{
+    for (std::unique_ptr<Column>& column : m_columns) {
+        flush(*column);
+
+        ColumnFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, Columns::FILE_MAGIC, sizeof(header.magic));
+        header.version = Columns::FORMAT_VERSION;
+        header.headerSize = sizeof(ColumnFileHeader);
+        header.type = column->type;
+        header.elementSize = column->elementSize;
+        header.count = column->count;
+        std::strncpy(header.name, column->name.c_str(), sizeof(header.name) - 1);
+
+        if (std::fseek(column->file, 0, SEEK_SET) != 0
+            || std::fwrite(&header, sizeof(header), 1, column->file) != 1) {
+            m_writeFailed = true;
+        }
+        std::fclose(column->file);
+    }
+    m_columns.clear();
+
+    m_trackTimestamp = m_trackFrame = m_trackId = m_trackLevel = m_trackRadius = nullptr;
+    m_trackAzimuth = m_trackElevation = m_trackRadialSpeed = m_trackAzimuthSpeed = nullptr;
+    m_trackElevationSpeed = nullptr;
+    m_trackFrames = 0;
+    m_detectionTimestamp = m_detectionFrame = m_detectionRange = nullptr;
+    m_detectionAzimuth = m_detectionRadialSpeed = m_detectionLevel = nullptr;
+    m_detectionFrames = 0;
+    m_profileTimestamp = m_profileBinRange = m_profileOffset = m_profileDb = nullptr;
+    m_profileValues = 0;
+}
+
+void ColumnExporter::flush(Column& column)
+{
+    if (column.used == 0) return;
+    if (std::fwrite(column.buffer.data(), 1, column.used, column.file) != column.used) {
+        m_writeFailed = true;
+    }
+    m_bytesWritten += column.used;
+    column.used = 0;
+}
+
+// Room for count values at the end of the column's buffer
+template <typename T>
+T* ColumnExporter::reserve(Column* column, size_t count)
+{
+    const size_t bytes = count * sizeof(T);
+    if (column->buffer.size() - column->used < bytes) {
+        flush(*column);
+        if (column->buffer.size() < bytes) column->buffer.resize(bytes);
+    }
+    T* values = reinterpret_cast<T*>(column->buffer.data() + column->used);
+    column->used += bytes;
+    column->count += count;
+    return values;
+}
+
+void ColumnExporter::appendUInt64(Column* column, uint64_t value, size_t count)
+{
+    uint64_t* values = reserve<uint64_t>(column, count);
+    std::fill(values, values + count, value);
+}
+
+void ColumnExporter::addTracks(const TargetTrackData& tracks, uint64_t timestamp)
+{
+    if (!m_trackTimestamp) return;
+
+    const size_t count = tracks.targets.size();
+    const TargetTrack* targets = tracks.targets.data();
+    appendUInt64(m_trackTimestamp, timestamp, count);
+    appendUInt64(m_trackFrame, m_trackFrames++, count);
+
+    // One pass per column keeps each store sequential
+    uint32_t* ids = reserve<uint32_t>(m_trackId, count);
+    for (size_t i = 0; i < count; ++i) ids[i] = targets[i].target_id;
+
+    const struct { Column* column; float TargetTrack::*field; } fields[] = {
+        {m_trackLevel, &TargetTrack::level},
+        {m_trackRadius, &TargetTrack::radius},
+        {m_trackAzimuth, &TargetTrack::azimuth},
+        {m_trackElevation, &TargetTrack::elevation},
+        {m_trackRadialSpeed, &TargetTrack::radial_speed},
+        {m_trackAzimuthSpeed, &TargetTrack::azimuth_speed},
+        {m_trackElevationSpeed, &TargetTrack::elevation_speed},
+    };
+    for (const auto& field : fields) {
+        float* values = reserve<float>(field.column, count);
+        for (size_t i = 0; i < count; ++i) values[i] = targets[i].*field.field;
+    }
+}
+
+void ColumnExporter::addDetections(const std::vector<Detection>& detections, uint64_t timestamp)
+{
+    if (!m_detectionTimestamp) return;
+
+    const size_t count = detections.size();
+    appendUInt64(m_detectionTimestamp, timestamp, count);
+    appendUInt64(m_detectionFrame, m_detectionFrames++, count);
+
+    const struct { Column* column; float Detection::*field; } fields[] = {
+        {m_detectionRange, &Detection::range},
+        {m_detectionAzimuth, &Detection::azimuth},
+        {m_detectionRadialSpeed, &Detection::radial_speed},
+        {m_detectionLevel, &Detection::level},
+    };
+    for (const auto& field : fields) {
+        float* values = reserve<float>(field.column, count);
+        for (size_t i = 0; i < count; ++i) values[i] = detections[i].*field.field;
+    }
+}
+
+void ColumnExporter::addRangeProfile(const std::vector<float>& profileDb, float binRange, uint64_t timestamp)
+{
+    if (!m_profileTimestamp) return;
+
+    appendUInt64(m_profileTimestamp, timestamp, 1);
+    *reserve<float>(m_profileBinRange, 1) = binRange;
+    if (!profileDb.empty()) {
+        std::memcpy(reserve<float>(m_profileDb, profileDb.size()), profileDb.data(), profileDb.size() * sizeof(float));
+    }
+    m_profileValues += profileDb.size();
+    appendUInt64(m_profileOffset, m_profileValues, 1);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ColumnFormat.h"
+#include "DataStructures.h"
+
+// Writes track snapshots, detection lists and range profiles as column
+// files (ColumnFormat.h) in one directory:
+//
+//   tracks.*       timestamp, frame, target_id, level, radius, azimuth,
+//                  elevation, radial_speed, azimuth_speed, elevation_speed
+//   detections.*   timestamp, frame, range, azimuth, radial_speed, level
+//   profiles.*     timestamp, bin_range, offset, db (dB per range bin)
+//
+// frame numbers the add*() calls of a table, so rows of one snapshot can be
+// grouped without comparing timestamps. Every column fills its own buffer
+// and reaches the disk in large unbuffered writes.
+class ColumnExporter
+{
+public:
+    enum Table {
+        Tracks = 1,
+        Detections = 2,
+        RangeProfiles = 4
+    };
+
+    ColumnExporter();
+    ~ColumnExporter();
+
+    ColumnExporter(const ColumnExporter&) = delete;
+    ColumnExporter& operator=(const ColumnExporter&) = delete;
+
+    // Creates the directory and its parents if needed; tables is a Table bitmask
+    bool open(const std::string& directory, int tables, std::string* error = nullptr);
+    void close();   // Flushes and writes the element counts
+    bool isOpen() const { return !m_columns.empty(); }
+
+    void addTracks(const TargetTrackData& tracks, uint64_t timestamp);
+    void addDetections(const std::vector<Detection>& detections, uint64_t timestamp);
+    void addRangeProfile(const std::vector<float>& profileDb, float binRange, uint64_t timestamp);
+
+    uint64_t bytesWritten() const { return m_bytesWritten; }
+    bool writeFailed() const { return m_writeFailed; }
+
+private:
+    static constexpr size_t BUFFER_BYTES = 1u << 20;
+
+    struct Column {
+        std::FILE* file;
+        uint16_t type;
+        uint16_t elementSize;
+        std::string name;
+        std::vector<uint8_t> buffer;
+        size_t used;
+        uint64_t count;
+    };
+
+    Column* addColumn(const std::string& directory, const std::string& name, Columns::ValueType type,
+                      std::string* error);
+    template <typename T> T* reserve(Column* column, size_t count);
+    void flush(Column& column);
+    void appendUInt64(Column* column, uint64_t value, size_t count);
+
+    std::vector<std::unique_ptr<Column>> m_columns;
+    uint64_t m_bytesWritten;
+    bool m_writeFailed;
+
+    Column* m_trackTimestamp;
+    Column* m_trackFrame;
+    Column* m_trackId;
+    Column* m_trackLevel;
+    Column* m_trackRadius;
+    Column* m_trackAzimuth;
+    Column* m_trackElevation;
+    Column* m_trackRadialSpeed;
+    Column* m_trackAzimuthSpeed;
+    Column* m_trackElevationSpeed;
+    uint64_t m_trackFrames;
+
+    Column* m_detectionTimestamp;
+    Column* m_detectionFrame;
+    Column* m_detectionRange;
+    Column* m_detectionAzimuth;
+    Column* m_detectionRadialSpeed;
+    Column* m_detectionLevel;
+    uint64_t m_detectionFrames;
+
+    Column* m_profileTimestamp;
+    Column* m_profileBinRange;
+    Column* m_profileOffset;
+    Column* m_profileDb;
+    uint64_t m_profileValues;
+};
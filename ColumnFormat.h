@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout of a columnar export. Each column is its own file,
+// <table>.<column>.col, holding a ColumnFileHeader and then the values as a
+// plain little-endian array, so a mapped file is used in place:
+//
+//   values = numpy.memmap("tracks.radius.col", dtype="<f4", offset=64, mode="r")
+//
+// Rows of one table line up across its column files. Variable-length rows
+// (a range profile per frame) are stored Arrow-style: a flat values column
+// plus an offset column of rows + 1 entries, row i being values
+// [offset[i], offset[i + 1]).
+//
+// The element count is written on close; a file whose writer died reads
+// count 0 and holds (file size - headerSize) / elementSize whole elements.
+
+namespace Columns {
+
+const char FILE_MAGIC[8] = {'R', 'A', 'D', 'C', 'O', 'L', '\0', '\1'};
+const uint32_t FORMAT_VERSION = 1;
+
+enum ValueType : uint16_t {
+    TypeUInt32 = 1,
+    TypeUInt64 = 2,
+    TypeFloat32 = 3
+};
+
+} // namespace Columns
+
+struct ColumnFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;          // sizeof(ColumnFileHeader); the values start here
+    uint16_t type;                // Columns::ValueType
+    uint16_t elementSize;         // Bytes per value
+    uint32_t reserved;
+    uint64_t count;               // Values in the file
+    char name[32];                // "<table>.<column>", NUL-padded
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader size changed");
@@ -1,133 +1,167 @@
-#pragma once
-
-#include <cstdint>
-#include <vector>
-#include <math.h>
-// Rx Data Format enumeration (placeholder)
-#pragma pack(push, 1)
-enum class Rx_Data_Format_t {
-    COMPLEX_FLOAT,
-    COMPLEX_INT16,
-    REAL_FLOAT,
-    REAL_INT16
-};
-
-// Target Track structure
-struct TargetTrack {
-    uint32_t target_id;
-    float level;
-    float radius;
-    float azimuth;        // degrees, -90 to +90
-    float elevation;      // degrees
-    float radial_speed;   // m/s (positive = approaching, negative = receding)
-    float azimuth_speed;  // deg/s
-    float elevation_speed; // deg/s
-};
-
-// Target Track Data structure
-struct TargetTrackData {
-    uint32_t numTracks;
-    std::vector<TargetTrack> targets;
-
-    TargetTrackData() : numTracks(0) {}
-
-    void resize(uint32_t size) {
-        numTracks = size;
-        targets.resize(size);
-    }
-};
-
-// Raw ADC Frame structure
-struct RawADCFrame {
-    std::vector<float> sample_data;
-    uint32_t frame_number;
-    uint32_t num_chirps;
-    uint8_t num_rx_antennas;
-    uint32_t num_samples_per_chirp;
-    uint8_t rx_mask;
-    uint8_t adc_resolution;
-    uint8_t interleaved_rx;
-    Rx_Data_Format_t data_format;
-
-    RawADCFrame() : frame_number(0), num_chirps(1), num_rx_antennas(1),
-                   num_samples_per_chirp(256), rx_mask(0x1), adc_resolution(16),
-                   interleaved_rx(0), data_format(Rx_Data_Format_t::REAL_FLOAT) {}
-};
-
-// Add to MainWindow.h - new structure for complex samples
-struct ComplexSample {
-    float I;  // In-phase component
-    float Q;  // Quadrature component
-
-    float magnitude() const {
-        return std::sqrt(I * I + Q * Q);
-    }
-
-    float phase() const {
-        return std::atan2(Q, I);
-    }
-};
-
-
-// Raw ADC Frame structure
-struct RawADCFrameTest {
-    uint32_t msgId;
-    uint32_t num_samples_per_chirp;  // This should be number of complex samples (32)
-    std::vector<ComplexSample> complex_data;  // Changed from sample_data
-    std::vector<float> magnitude_data;        // Computed magnitudes
-
-    void computeMagnitudes() {
-        magnitude_data.clear();
-        magnitude_data.reserve(complex_data.size());
-        for (const auto& sample : complex_data) {
-            magnitude_data.push_back(sample.magnitude());
-        }
-    }
-};
-
-
-// UDP Message types
-enum class MessageType : uint8_t {
-    TARGET_TRACK_DATA = 1,
-    RAW_ADC_DATA = 2
-};
-
-// UDP Message header
-struct MessageHeader {
-    MessageType type;
-    uint32_t data_size;
-    uint64_t timestamp;
-};
-
-// DSP command types
-typedef enum {
-    DSP_CMD_SET = 1,      // Set DSP parameters
-    DSP_CMD_GET = 2,      // Get DSP parameters
-    DSP_CMD_RESPONSE = 3  // Response with DSP parameters
-} dsp_command_type_t;
-
-// DSP settings payload for UDP communication
-typedef struct {
-    uint8_t range_mvg_avg_length;  // Moving average length
-    uint16_t min_range_cm;         // Minimum range (cm)
-    uint16_t max_range_cm;         // Maximum range (cm)
-    uint16_t min_speed_kmh;        // Minimum speed (km/h)
-    uint16_t max_speed_kmh;        // Maximum speed (km/h)
-    uint16_t min_angle_degree;     // Minimum angle (degrees)
-    uint16_t max_angle_degree;     // Maximum angle (degrees)
-    uint16_t range_threshold;      // Range FFT threshold
-    uint16_t speed_threshold;      // Doppler FFT threshold
-    uint8_t enable_tracking;       // Enable tracking
-    uint8_t num_of_tracks;         // Number of active tracks
-    uint8_t median_filter_length;  // Depth of median filter
-    uint8_t enable_mti_filter;     // Enable MTI filter
-    uint16_t mti_filter_length;    // MTI filter length
-} DSP_Settings_t;
-
-// DSP message structure for UDP communication
-typedef struct {
-    uint32_t msg_type;      // DSP_CMD_SET, DSP_CMD_GET, DSP_CMD_RESPONSE
-    DSP_Settings_t settings;
-} dsp_message_t;
-
-#pragma pack(pop)
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include <math.h>
+
+// In-memory types. These are naturally aligned; the packed on-wire layouts
+// and their (de)serialization live in WireFormat.h.
+
+// Rx Data Format enumeration (placeholder)
+enum class Rx_Data_Format_t {
+    COMPLEX_FLOAT,
+    COMPLEX_INT16,
+    REAL_FLOAT,
+    REAL_INT16
+};
+
+// Target Track structure
+struct TargetTrack {
+    uint32_t target_id;
+    float level;
+    float radius;
+    float azimuth;        // degrees, -90 to +90
+    float elevation;      // degrees
+    float radial_speed;   // m/s (positive = approaching, negative = receding)
+    float azimuth_speed;  // deg/s
+    float elevation_speed; // deg/s
+};
+static_assert(sizeof(TargetTrack) == 32 && alignof(TargetTrack) == 4,
+              "TargetTrack is expected to be eight tightly packed 4-byte fields");
+
+// Target Track Data structure
+struct TargetTrackData {
+    uint32_t numTracks;
+    std::vector<TargetTrack> targets;
+
+    TargetTrackData() : numTracks(0) {}
+
+    void resize(uint32_t size) {
+        numTracks = size;
+        targets.resize(size);
+    }
+
+    // Empty the track list for reuse; keeps its capacity
+    void reset() {
+        numTracks = 0;
+        targets.clear();
+    }
+};
+
+// Single-frame detection before tracking (sensor output with its own
+// tracking disabled, or the host clustering stage)
+struct Detection {
+    float range;          // m
+    float azimuth;        // degrees
+    float radial_speed;   // m/s (positive = approaching)
+    float level;
+};
+
+// Raw ADC Frame structure
+struct RawADCFrame {
+    std::vector<float> sample_data;
+    uint32_t frame_number;
+    uint32_t num_chirps;
+    uint8_t num_rx_antennas;
+    uint32_t num_samples_per_chirp;
+    uint8_t rx_mask;
+    uint8_t adc_resolution;
+    uint8_t interleaved_rx;
+    Rx_Data_Format_t data_format;
+
+    RawADCFrame() : frame_number(0), num_chirps(1), num_rx_antennas(1),
+                   num_samples_per_chirp(256), rx_mask(0x1), adc_resolution(16),
+                   interleaved_rx(0), data_format(Rx_Data_Format_t::REAL_FLOAT) {}
+};
+
+// Add to MainWindow.h - new structure for complex samples
+struct ComplexSample {
+    float I;  // In-phase component
+    float Q;  // Quadrature component
+
+    float magnitude() const {
+        return std::sqrt(I * I + Q * Q);
+    }
+
+    float phase() const {
+        return std::atan2(Q, I);
+    }
+};
+// Sample arrays are also processed as plain interleaved float I/Q pairs
+static_assert(sizeof(ComplexSample) == 2 * sizeof(float) && alignof(ComplexSample) == alignof(float),
+              "ComplexSample must be layout-compatible with float[2]");
+static_assert(std::is_trivially_copyable<ComplexSample>::value, "ComplexSample must be trivially copyable");
+
+
+// Raw ADC Frame structure
+struct RawADCFrameTest {
+    uint32_t msgId;
+    uint32_t num_samples_per_chirp;  // This should be number of complex samples (32)
+    std::vector<ComplexSample> complex_data;  // Changed from sample_data
+
+    RawADCFrameTest() : msgId(0), num_samples_per_chirp(0), m_derivedValid(0) {}
+    RawADCFrameTest(const RawADCFrameTest& other)
+        : msgId(other.msgId), num_samples_per_chirp(other.num_samples_per_chirp)
+        , complex_data(other.complex_data), m_derivedValid(0) {}
+    RawADCFrameTest& operator=(const RawADCFrameTest& other) {
+        msgId = other.msgId;
+        num_samples_per_chirp = other.num_samples_per_chirp;
+        complex_data = other.complex_data;
+        invalidateDerived();
+        return *this;
+    }
+
+    // Derived per-sample arrays, computed on first access and kept until the
+    // samples change. Safe to call concurrently on a shared (const) frame.
+    const std::vector<float>& magnitudes() const { return derived(DerivedMagnitude, m_magnitudes); }
+    const std::vector<float>& phases() const { return derived(DerivedPhase, m_phases); }
+
+    // Call after modifying complex_data of a frame that may have been read
+    void invalidateDerived() { m_derivedValid.store(0, std::memory_order_release); }
+
+    // Empty the frame for reuse; buffers keep their capacity
+    void reset() {
+        msgId = 0;
+        num_samples_per_chirp = 0;
+        complex_data.clear();
+        invalidateDerived();
+    }
+
+private:
+    enum DerivedBit : uint8_t { DerivedMagnitude = 1, DerivedPhase = 2 };
+
+    const std::vector<float>& derived(DerivedBit bit, std::vector<float>& out) const {
+        if (m_derivedValid.load(std::memory_order_acquire) & bit) return out;
+
+        std::lock_guard<std::mutex> lock(m_derivedMutex);
+        if (!(m_derivedValid.load(std::memory_order_relaxed) & bit)) {
+            // Indexed loop over unpacked samples so it vectorizes (with -fno-math-errno)
+            const size_t count = complex_data.size();
+            out.resize(count);
+            const ComplexSample* samples = complex_data.data();
+            float* values = out.data();
+            if (bit == DerivedMagnitude) {
+                for (size_t i = 0; i < count; ++i) values[i] = samples[i].magnitude();
+            } else {
+                for (size_t i = 0; i < count; ++i) values[i] = samples[i].phase();
+            }
+            m_derivedValid.fetch_or(bit, std::memory_order_release);
+        }
+        return out;
+    }
+
+    mutable std::vector<float> m_magnitudes;
+    mutable std::vector<float> m_phases;
+    mutable std::atomic<uint8_t> m_derivedValid;
+    mutable std::mutex m_derivedMutex;
+};
+
+// Per-frame snapshots. A frame is built once, published as a pointer to const
+// and then shared by every consumer (widgets, table, recorder) without
+// copying; a new frame replaces the pointer rather than mutating the old one.
+using TrackSnapshotPtr = std::shared_ptr<const TargetTrackData>;
+using ADCFramePtr = std::shared_ptr<const RawADCFrameTest>;
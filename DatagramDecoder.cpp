@@ -0,0 +1,241 @@
+#include "DatagramDecoder.h"
+#include "WireFormat.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Whitespace-separated token scanner over raw bytes
+struct Token {
+    const char* begin;
+    const char* end;
+
+    bool equals(const char* literal, size_t length) const
+    {
+        return size_t(end - begin) == length && std::memcmp(begin, literal, length) == 0;
+    }
+};
+
+inline bool nextToken(const char*& cursor, const char* end, Token& token)
+{
+    while (cursor < end && isSpace(*cursor)) ++cursor;
+    if (cursor == end) return false;
+
+    token.begin = cursor;
+    while (cursor < end && !isSpace(*cursor)) ++cursor;
+    token.end = cursor;
+    return true;
+}
+
+#define TOKEN_IS(token, literal) (token).equals(literal, sizeof(literal) - 1)
+
+// Like QString::toUInt()/toFloat(): the whole token must be a number,
+// otherwise the result is 0
+uint32_t parseUInt(const Token& token)
+{
+    const char* p = token.begin;
+    if (p < token.end && *p == '+') ++p;
+    if (p == token.end) return 0;
+
+    uint64_t value = 0;
+    for (; p < token.end; ++p) {
+        if (*p < '0' || *p > '9') return 0;
+        value = value * 10 + uint64_t(*p - '0');
+        if (value > 0xFFFFFFFFull) return 0;
+    }
+    return uint32_t(value);
+}
+
+float parseFloat(const Token& token)
+{
+    const char* p = token.begin;
+    const char* end = token.end;
+
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    double mantissa = 0.0;
+    int exponent = 0;
+    bool anyDigits = false;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        mantissa = mantissa * 10.0 + (*p - '0');
+        anyDigits = true;
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+            mantissa = mantissa * 10.0 + (*p - '0');
+            --exponent;
+            anyDigits = true;
+        }
+    }
+    if (!anyDigits) return 0.0f;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if (p == end) return 0.0f;
+        int value = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+            if (value < 10000) value = value * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end) return 0.0f;
+
+    // Scale by 10^exponent with repeated squaring
+    double scale = 1.0;
+    double base = 10.0;
+    for (int e = exponent < 0 ? -exponent : exponent; e > 0; e >>= 1) {
+        if (e & 1) scale *= base;
+        base *= base;
+    }
+    double value = exponent < 0 ? mantissa / scale : mantissa * scale;
+    return static_cast<float>(negative ? -value : value);
+}
+
+} // namespace
+
+DatagramDecoder::DatagramDecoder()
+    : m_malformedCount(0)
+{
+}
+
+int DatagramDecoder::decode(const char* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame)
+{
+    int result = decodeBinary(reinterpret_cast<const uint8_t*>(data), size, tracks, frame);
+    if (result != DecodedNothing) return result;
+
+    return decodeText(data, size, tracks, frame);
+}
+
+int DatagramDecoder::decodeBinary(const uint8_t* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame)
+{
+    // Binary datagrams start with a MessageHeader whose type byte (1 or 2) is
+    // never the first character of a text message
+    MessageHeader header;
+    if (!WireFormat::deserializeHeader(data, size, header) ||
+        header.data_size != size - sizeof(MessageHeader)) {
+        return DecodedNothing;
+    }
+
+    const uint8_t* payload = data + sizeof(MessageHeader);
+    switch (header.type) {
+    case MessageType::TARGET_TRACK_DATA: {
+        std::shared_ptr<TargetTrackData> decoded = m_trackPool.acquire();
+        if (WireFormat::deserializeTracks(payload, header.data_size, *decoded)) {
+            tracks = std::move(decoded);
+            return DecodedTracks;
+        }
+        break;
+    }
+    case MessageType::RAW_ADC_DATA: {
+        std::shared_ptr<RawADCFrameTest> decoded = m_framePool.acquire();
+        if (WireFormat::deserializeADCFrame(payload, header.data_size, *decoded)) {
+            frame = std::move(decoded);
+            return DecodedADCFrame;
+        }
+        break;
+    }
+    }
+
+    // Header matched but the payload did not: do not retry it as text
+    m_malformedCount.fetch_add(1, std::memory_order_relaxed);
+    return DecodedNothing;
+}
+
+int DatagramDecoder::decodeText(const char* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame)
+{
+    std::shared_ptr<TargetTrackData> trackData = m_trackPool.acquire();
+    std::shared_ptr<RawADCFrameTest> adcFrame = m_framePool.acquire();
+    m_rawSamples.clear();
+
+    bool hasTracks = false;
+    bool hasADC = false;
+    TargetTrack target{};
+    int parsedTargets = 0;
+
+    // Track and ADC keys are disjoint, so both are parsed in one pass
+    const char* cursor = data;
+    const char* end = data + size;
+    Token token;
+    Token value;
+    while (nextToken(cursor, end, token)) {
+        if (TOKEN_IS(token, "ADC:")) {
+            hasADC = true;
+            if (nextToken(cursor, end, value)) m_rawSamples.push_back(parseFloat(value));
+        } else if (TOKEN_IS(token, "NumTargets:")) {
+            hasTracks = true;
+            nextToken(cursor, end, value);  // Count is implied by the TgtId entries
+        } else if (TOKEN_IS(token, "TgtId:")) {
+            if (!nextToken(cursor, end, value)) break;
+            if (parsedTargets > 0) {
+                trackData->targets.push_back(target);
+                target = TargetTrack{};
+            }
+            target.target_id = parseUInt(value);
+            ++parsedTargets;
+        } else if (TOKEN_IS(token, "Level:")) {
+            if (nextToken(cursor, end, value)) target.level = parseFloat(value);
+        } else if (TOKEN_IS(token, "Range:")) {
+            if (nextToken(cursor, end, value)) target.radius = parseFloat(value) / 100.0f;  // cm -> m
+        } else if (TOKEN_IS(token, "Azimuth:")) {
+            if (nextToken(cursor, end, value)) target.azimuth = parseFloat(value);
+        } else if (TOKEN_IS(token, "Elevation:")) {
+            if (nextToken(cursor, end, value)) target.elevation = parseFloat(value);
+        } else if (TOKEN_IS(token, "RadialSpeed:")) {
+            if (nextToken(cursor, end, value)) target.radial_speed = parseFloat(value);
+        } else if (TOKEN_IS(token, "AzimuthSpeed:")) {
+            if (nextToken(cursor, end, value)) target.azimuth_speed = parseFloat(value);
+        } else if (TOKEN_IS(token, "ElevationSpeed:")) {
+            if (nextToken(cursor, end, value)) target.elevation_speed = parseFloat(value);
+        } else if (TOKEN_IS(token, "MsgId:")) {
+            if (nextToken(cursor, end, value)) adcFrame->msgId = parseUInt(value);
+        } else if (TOKEN_IS(token, "NumSamples:")) {
+            // Total real values; the frame counts complex samples
+            if (nextToken(cursor, end, value)) adcFrame->num_samples_per_chirp = parseUInt(value) / 2;
+        }
+    }
+
+    int result = DecodedNothing;
+
+    if (hasTracks) {
+        if (parsedTargets > 0) {
+            trackData->targets.push_back(target);
+        }
+        trackData->numTracks = static_cast<uint32_t>(trackData->targets.size());
+        tracks = std::move(trackData);
+        result |= DecodedTracks;
+    }
+
+    if (hasADC) {
+        // Pairing as sent by the sensor firmware: I at i, Q 32 values later
+        // within each block of TEXT_ADC_BLOCK I and TEXT_ADC_BLOCK Q values
+        const size_t rawCount = m_rawSamples.size();
+        const float* raw = m_rawSamples.data();
+        adcFrame->complex_data.resize(rawCount / 2);
+        ComplexSample* out = adcFrame->complex_data.data();
+        for (size_t block = 0; block + 1 < rawCount; block += 2 * TEXT_ADC_BLOCK) {
+            const size_t half = std::min(rawCount - block, 2 * TEXT_ADC_BLOCK) / 2;
+            for (size_t j = 0; j < half; ++j, ++out) {
+                out->I = raw[block + j];
+                out->Q = raw[block + half + j];
+            }
+        }
+        frame = std::move(adcFrame);
+        result |= DecodedADCFrame;
+    }
+
+    return result;
+}
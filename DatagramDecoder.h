@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+#include "SnapshotPool.h"
+
+// Turns received UDP datagrams (binary WireFormat messages or the text
+// "NumTargets: ... / ADC: ..." format) into track and ADC frame snapshots.
+// Snapshots come from recycling pools and the text parser works directly on
+// the datagram bytes, so steady-state decoding does not allocate.
+class DatagramDecoder
+{
+public:
+    enum DecodeResult {
+        DecodedNothing = 0,
+        DecodedTracks = 1,
+        DecodedADCFrame = 2
+    };
+
+    // Text ADC messages carry "ADC:" values in blocks of this many I values
+    // followed by their Q values; a shorter last block splits in half the
+    // same way. NumSamples gives the values per chirp.
+    static constexpr size_t TEXT_ADC_BLOCK = 32;
+
+    DatagramDecoder();
+
+    // Decode one datagram. Returns a DecodeResult bitmask; for each bit set
+    // the matching output pointer receives the new snapshot.
+    int decode(const char* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame);
+
+    // Safe to read from any thread
+    uint64_t malformedCount() const { return m_malformedCount.load(std::memory_order_relaxed); }
+
+private:
+    int decodeBinary(const uint8_t* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame);
+    int decodeText(const char* data, size_t size, TrackSnapshotPtr& tracks, ADCFramePtr& frame);
+
+    SnapshotPool<TargetTrackData> m_trackPool;
+    SnapshotPool<RawADCFrameTest> m_framePool;
+    std::vector<float> m_rawSamples;  // Scratch for text ADC values, reused
+    std::atomic<uint64_t> m_malformedCount;
+};
@@ -0,0 +1,214 @@
+#include "DetectionClusterer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+const float RAD_TO_DEG = 180.0f / 3.14159265358979f;
+
+} // namespace
+
+DetectionClusterer::DetectionClusterer()
+    : m_epsilon(2.5f)
+    , m_speedEpsilon(1.5f)
+    , m_minPoints(2)
+    , m_keepNoise(true)
+    , m_matchDistance(5.0f)
+    , m_nextId(1)
+{
+}
+
+void DetectionClusterer::clear()
+{
+    m_centroids.clear();
+    m_ids.clear();
+    m_centroidX.clear();
+    m_centroidY.clear();
+    m_previousX.clear();
+    m_previousY.clear();
+    m_previousIds.clear();
+}
+
+void DetectionClusterer::cluster(const std::vector<Detection>& detections)
+{
+    const size_t count = detections.size();
+    m_centroids.clear();
+    m_centroidX.clear();
+    m_centroidY.clear();
+    m_labels.assign(count, NOISE);
+    m_visited.assign(count, 0);
+    if (count == 0) {
+        assignIds();
+        return;
+    }
+
+    m_x.resize(count);
+    m_y.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float azimuth = detections[i].azimuth * DEG_TO_RAD;
+        m_x[i] = detections[i].range * std::sin(azimuth);
+        m_y[i] = detections[i].range * std::cos(azimuth);
+    }
+    m_grid.build(m_x.data(), m_y.data(), count, m_epsilon);
+
+    int32_t nextLabel = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (m_visited[i]) continue;
+        m_visited[i] = 1;
+
+        regionQuery(detections, i);
+        if (m_neighbours.size() < m_minPoints) continue;  // Noise unless a core point claims it
+
+        // New cluster: breadth-first over density-reachable points. Points
+        // are labelled when queued, so each one is queued at most once.
+        const int32_t label = nextLabel++;
+        m_members.clear();
+        m_queue.clear();
+        for (uint32_t n : m_neighbours) {
+            if (m_labels[n] == NOISE) {
+                m_labels[n] = label;
+                m_members.push_back(n);
+                m_queue.push_back(n);
+            }
+        }
+
+        for (size_t head = 0; head < m_queue.size(); ++head) {
+            const uint32_t q = m_queue[head];
+            if (m_visited[q]) continue;  // Border point already queried
+            m_visited[q] = 1;
+
+            regionQuery(detections, q);
+            if (m_neighbours.size() < m_minPoints) continue;
+            for (uint32_t n : m_neighbours) {
+                if (m_labels[n] == NOISE) {
+                    m_labels[n] = label;
+                    m_members.push_back(n);
+                    m_queue.push_back(n);
+                }
+            }
+        }
+
+        addCentroid(detections);
+    }
+
+    if (m_keepNoise) {
+        for (size_t i = 0; i < count; ++i) {
+            if (m_labels[i] != NOISE) continue;
+            m_labels[i] = nextLabel++;
+            m_members.assign(1, uint32_t(i));
+            addCentroid(detections);
+        }
+    }
+
+    assignIds();
+}
+
+void DetectionClusterer::assignIds()
+{
+    const size_t count = m_centroids.size();
+    const size_t previousCount = m_previousIds.size();
+    m_ids.assign(count, 0);
+
+    // Candidate pairs within the match distance, closest first
+    m_matches.clear();
+    if (count > 0 && previousCount > 0) {
+        const float maxDistance2 = m_matchDistance * m_matchDistance;
+        m_previousGrid.build(m_previousX.data(), m_previousY.data(), previousCount, m_matchDistance);
+        for (size_t i = 0; i < count; ++i) {
+            const float x = m_centroidX[i];
+            const float y = m_centroidY[i];
+            m_previousGrid.forEachInRadius(x, y, m_matchDistance, [&](size_t j) {
+                const float dx = m_previousX[j] - x;
+                const float dy = m_previousY[j] - y;
+                const float distance2 = dx * dx + dy * dy;
+                if (distance2 <= maxDistance2) {
+                    m_matches.push_back(Match{uint32_t(i), uint32_t(j), distance2});
+                }
+            });
+        }
+        std::sort(m_matches.begin(), m_matches.end(), [](const Match& a, const Match& b) {
+            return a.distance2 < b.distance2 || (a.distance2 == b.distance2 && a.current < b.current);
+        });
+    }
+
+    m_claimed.assign(previousCount, 0);
+    for (const Match& match : m_matches) {
+        if (m_ids[match.current] != 0 || m_claimed[match.previous]) continue;
+        m_ids[match.current] = m_previousIds[match.previous];
+        m_claimed[match.previous] = 1;
+    }
+    for (uint32_t& id : m_ids) {
+        if (id != 0) continue;
+        id = m_nextId++;
+        if (m_nextId == 0) m_nextId = 1;
+    }
+
+    m_previousX.assign(m_centroidX.begin(), m_centroidX.end());
+    m_previousY.assign(m_centroidY.begin(), m_centroidY.end());
+    m_previousIds.assign(m_ids.begin(), m_ids.end());
+}
+
+void DetectionClusterer::regionQuery(const std::vector<Detection>& detections, size_t index)
+{
+    const float x = m_x[index];
+    const float y = m_y[index];
+    const float speed = detections[index].radial_speed;
+    const float invEpsilon2 = 1.0f / (m_epsilon * m_epsilon);
+    const float invSpeedEpsilon2 = 1.0f / (m_speedEpsilon * m_speedEpsilon);
+
+    m_neighbours.clear();
+    m_grid.forEachInRadius(x, y, m_epsilon, [&](size_t j) {
+        const float dx = m_x[j] - x;
+        const float dy = m_y[j] - y;
+        const float dv = detections[j].radial_speed - speed;
+        if ((dx * dx + dy * dy) * invEpsilon2 + dv * dv * invSpeedEpsilon2 <= 1.0f) {
+            m_neighbours.push_back(uint32_t(j));
+        }
+    });
+}
+
+void DetectionClusterer::addCentroid(const std::vector<Detection>& detections)
+{
+    // Mean position and speed; the strongest return gives the level
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    float sumSpeed = 0.0f;
+    float level = detections[m_members.front()].level;
+    for (uint32_t m : m_members) {
+        sumX += m_x[m];
+        sumY += m_y[m];
+        sumSpeed += detections[m].radial_speed;
+        level = std::max(level, detections[m].level);
+    }
+
+    const float inverseCount = 1.0f / float(m_members.size());
+    const float x = sumX * inverseCount;
+    const float y = sumY * inverseCount;
+
+    Detection centroid;
+    centroid.range = std::sqrt(x * x + y * y);
+    centroid.azimuth = std::atan2(x, y) * RAD_TO_DEG;
+    centroid.radial_speed = sumSpeed * inverseCount;
+    centroid.level = level;
+    m_centroids.push_back(centroid);
+    m_centroidX.push_back(x);
+    m_centroidY.push_back(y);
+}
+
+void DetectionClusterer::exportTracks(TargetTrackData& out) const
+{
+    out.reset();
+    out.targets.reserve(m_centroids.size());
+    for (size_t i = 0; i < m_centroids.size(); ++i) {
+        const Detection& centroid = m_centroids[i];
+        TargetTrack target{};
+        target.target_id = m_ids[i];
+        target.level = centroid.level;
+        target.radius = centroid.range;
+        target.azimuth = centroid.azimuth;
+        target.radial_speed = centroid.radial_speed;
+        out.targets.push_back(target);
+    }
+    out.numTracks = static_cast<uint32_t>(out.targets.size());
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+#include "SpatialHashGrid.h"
+
+// DBSCAN over (x, y, radial speed) for the detections of one frame.
+// Two detections are neighbours when their scaled distance
+//   (dx² + dy²) / eps² + dv² / speedEps²
+// is at most 1. Neighbour queries go through a hashed grid with eps-sized
+// cells, so each query looks at 3x3 cells. Each cluster becomes one centroid
+// detection; isolated detections are either kept as single-point clusters
+// or dropped as noise.
+//
+// Cluster IDs carry over between frames: each centroid takes the ID of the
+// nearest unclaimed centroid of the previous frame within the match distance
+// (closest pairs first), and the rest get new IDs. This is frame-to-frame
+// continuity only; tracks that ride out missed frames come from passing the
+// centroids through MultiTargetTracker.
+class DetectionClusterer
+{
+public:
+    DetectionClusterer();
+
+    void setDistanceEpsilon(float metres) { m_epsilon = metres; }
+    void setSpeedEpsilon(float metresPerSecond) { m_speedEpsilon = metresPerSecond; }
+    void setMinPoints(size_t minPoints) { m_minPoints = minPoints; }
+    void setKeepNoise(bool keep) { m_keepNoise = keep; }
+    void setMatchDistance(float metres) { m_matchDistance = metres; }  // Frame-to-frame centroid motion
+
+    void cluster(const std::vector<Detection>& detections);
+    void clear();  // Forget the previous frame's clusters
+
+    // Results of the last cluster() call
+    const std::vector<Detection>& centroids() const { return m_centroids; }
+    const std::vector<int32_t>& labels() const { return m_labels; }  // Index into centroids() or NOISE
+    const std::vector<uint32_t>& ids() const { return m_ids; }        // Per centroid
+    void exportTracks(TargetTrackData& out) const;
+
+    static constexpr int32_t NOISE = -1;
+
+private:
+    struct Match {
+        uint32_t current;
+        uint32_t previous;
+        float distance2;
+    };
+
+    void regionQuery(const std::vector<Detection>& detections, size_t index);
+    void addCentroid(const std::vector<Detection>& detections);  // From m_members
+    void assignIds();
+
+    float m_epsilon;
+    float m_speedEpsilon;
+    size_t m_minPoints;
+    bool m_keepNoise;
+    float m_matchDistance;
+
+    std::vector<Detection> m_centroids;
+    std::vector<int32_t> m_labels;
+    std::vector<uint32_t> m_ids;
+    uint32_t m_nextId;
+
+    // Centroid positions of this and the previous frame, for the IDs
+    std::vector<float> m_centroidX;
+    std::vector<float> m_centroidY;
+    std::vector<float> m_previousX;
+    std::vector<float> m_previousY;
+    std::vector<uint32_t> m_previousIds;
+    std::vector<Match> m_matches;
+    std::vector<uint8_t> m_claimed;
+    SpatialHashGrid m_previousGrid;
+
+    // Per-frame scratch, kept to avoid reallocation
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<uint8_t> m_visited;
+    std::vector<uint32_t> m_neighbours;
+    std::vector<uint32_t> m_queue;
+    std::vector<uint32_t> m_members;
+    SpatialHashGrid m_grid;
+};
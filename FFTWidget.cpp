@@ -1,531 +1,450 @@
-
-// FFTWidget.cpp - Corrected for Infineon Radar GUI style magnitudes
-
-#include "FFTWidget.h"
-#include <QPaintEvent>
-#include <QResizeEvent>
-#include <QFont>
-#include <QFontMetrics>
-#include <QPainterPath>
-#include <QVector>
-#include <cmath>
-#include <algorithm>
-
-FFTWidget::FFTWidget(QWidget *parent)
-    : QWidget(parent)
-    , m_maxMagnitude(0.0f)
-    , m_sampleRate(100000.0f)    // 100 kHz ADC sampling rate
-    , m_sweepTime(0.0015f)       // 1.5 ms chirp (matching Infineon: 1500 us)
-    , m_bandwidth(100000000.0f)  // 100 MHz bandwidth (matching Infineon)
-    , m_centerFreq(24125000000.0f) // 24.125 GHz (matching Infineon: 24.025-24.125)
-    , m_maxRange(50.0f)
-    , m_minRange(0.0f)
-    , m_margin(50)
-{
-    setMinimumSize(400, 300);
-    setBackgroundRole(QPalette::Base);
-    setAutoFillBackground(true);
-}
-
-void FFTWidget::updateData(const RawADCFrameTest& adcFrame)
-{
-    m_currentFrame = adcFrame;
-    if (!adcFrame.complex_data.empty()) {
-        performFFTFromComplexData(adcFrame.complex_data);
-    }
-    update();
-}
-
-void FFTWidget::setFrequencyRange(float minFreq, float maxFreq)
-{
-    m_minFrequency = minFreq;
-    m_maxFrequency = maxFreq;
-    update();
-}
-
-void FFTWidget::updateTargets(const TargetTrackData& targets)
-{
-    m_currentTargets = targets;
-    update();
-}
-
-void FFTWidget::setRadarParameters(float sampleRate, float sweepTime, float bandwidth, float centerFreq)
-{
-    m_sampleRate = sampleRate;
-    m_sweepTime = sweepTime;
-    m_bandwidth = bandwidth;
-    m_centerFreq = centerFreq;
-
-    if (!m_magnitudeSpectrum.empty() && !m_currentFrame.complex_data.empty()) {
-        performFFTFromComplexData(m_currentFrame.complex_data);
-    }
-    update();
-}
-
-void FFTWidget::setMaxRange(float maxRange)
-{
-    m_maxRange = maxRange;
-    update();
-}
-
-void FFTWidget::setMinRange(float minRange)
-{
-    m_minRange = minRange;
-    update();
-}
-
-float FFTWidget::frequencyToRange(float frequency) const
-{
-    // FMCW radar range calculation: R = (f_beat * c * T_sweep) / (2 * B)
-    const float SPEED_OF_LIGHT = 299792458.0f; // m/s
-    return (frequency * SPEED_OF_LIGHT * m_sweepTime) / (2.0f * m_bandwidth);
-}
-
-float FFTWidget::sampleIndexToRange(int sampleIndex) const
-{
-    if (m_rangeAxis.empty() || sampleIndex >= static_cast<int>(m_rangeAxis.size())) {
-        return 0.0f;
-    }
-    return m_rangeAxis[sampleIndex];
-}
-
-void FFTWidget::performFFTFromComplexData(const std::vector<ComplexSample>& complexInput)
-{
-    if (complexInput.empty()) return;
-
-    size_t numComplexSamples = complexInput.size();
-
-    // Find next power of 2 for FFT
-    size_t n = 1;
-    while (n < numComplexSamples) {
-        n *= 2;
-    }
-
-    std::vector<std::complex<float>> complexData(n);
-
-    // Copy complex samples directly
-    for (size_t i = 0; i < numComplexSamples && i < n; ++i) {
-        complexData[i] = std::complex<float>(complexInput[i].I, complexInput[i].Q);
-    }
-
-    // Zero-pad the rest
-    for (size_t i = numComplexSamples; i < n; ++i) {
-        complexData[i] = std::complex<float>(0.0f, 0.0f);
-    }
-
-    // Apply Hanning window for better spectral analysis
-    applyWindow(complexData, numComplexSamples);
-
-    // Perform FFT
-    fft(complexData);
-
-    // Calculate magnitude spectrum with RADAR-APPROPRIATE scaling
-    size_t spectrumSize = n / 2; // Only positive frequencies
-    m_magnitudeSpectrum.resize(spectrumSize);
-    m_frequencyAxis.resize(spectrumSize);
-    m_rangeAxis.resize(spectrumSize);
-
-    m_maxMagnitude = -50.0f; // Start with reasonable radar minimum
-
-    // Calculate radar-specific parameters for proper scaling
-    float rangeResolution = (SPEED_OF_LIGHT * m_sweepTime) / (2.0f * m_bandwidth);
-    float maxUnambiguousRange = (SPEED_OF_LIGHT * m_sampleRate * m_sweepTime) / (4.0f * m_bandwidth);
-
-    // Scaling factor to match typical radar magnitudes
-    float radarScalingFactor = 60.0f; // Adjust this to match Infineon levels
-
-    for (size_t i = 0; i < spectrumSize; ++i) {
-        // Calculate complex magnitude
-        std::complex<float> sample = complexData[i];
-        float magnitude_linear = std::abs(sample);
-
-        // RADAR-SPECIFIC MAGNITUDE CALCULATION
-        // Apply FFT normalization
-        magnitude_linear = magnitude_linear / float(numComplexSamples);
-
-        // Add small value to avoid log(0)
-        magnitude_linear = std::max(magnitude_linear, 1e-8f);
-
-        // Convert to dB with radar-appropriate scaling
-        // This matches typical radar return levels
-        float magnitude_dB = 20.0f * std::log10(magnitude_linear) + radarScalingFactor;
-
-        // Add additional conditioning for radar signals
-        if (i < spectrumSize / 4) {
-            // Boost near-range sensitivity (typical for radar)
-            magnitude_dB += 5.0f;
-        }
-
-        m_magnitudeSpectrum[i] = magnitude_dB;
-
-        // Calculate frequency for this bin
-        float frequency = (static_cast<float>(i) * m_sampleRate) / static_cast<float>(n);
-        m_frequencyAxis[i] = frequency;
-
-        // Calculate corresponding range using FMCW radar equation
-        float range = frequencyToRange(frequency);
-        m_rangeAxis[i] = range;
-
-        // Track maximum for display scaling
-        if (magnitude_dB > m_maxMagnitude) {
-            m_maxMagnitude = magnitude_dB;
-        }
-    }
-
-    // Add synthetic peaks for testing (similar to Infineon GUI)
-    if (!m_magnitudeSpectrum.empty()) {
-        addSyntheticRadarPeaks();
-    }
-}
-
-void FFTWidget::addSyntheticRadarPeaks()
-{
-    // Add a strong peak at ~1.5m range (like Infineon GUI shows)
-    float targetRange = 1.49f; // meters
-    float targetMagnitude = 54.0f; // dB (matching Infineon display)
-
-    // Find the closest bin to 1.49m
-    for (size_t i = 0; i < m_rangeAxis.size(); ++i) {
-        if (std::abs(m_rangeAxis[i] - targetRange) < 0.1f) {
-            m_magnitudeSpectrum[i] = targetMagnitude;
-            // Add some spreading to adjacent bins for realistic peak
-            if (i > 0) m_magnitudeSpectrum[i-1] = targetMagnitude - 3.0f;
-            if (i < m_magnitudeSpectrum.size()-1) m_magnitudeSpectrum[i+1] = targetMagnitude - 3.0f;
-            break;
-        }
-    }
-
-    // Add a weaker peak at ~5m range
-    float targetRange2 = 5.0f;
-    float targetMagnitude2 = 35.0f;
-
-    for (size_t i = 0; i < m_rangeAxis.size(); ++i) {
-        if (std::abs(m_rangeAxis[i] - targetRange2) < 0.2f) {
-            m_magnitudeSpectrum[i] = std::max(m_magnitudeSpectrum[i], targetMagnitude2);
-            break;
-        }
-    }
-}
-
-void FFTWidget::applyWindow(std::vector<std::complex<float>>& data, size_t validSamples)
-{
-    // Apply Hanning window for better frequency resolution
-    for (size_t i = 0; i < validSamples; ++i) {
-        float window = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (validSamples - 1)));
-        data[i] *= window;
-    }
-}
-
-void FFTWidget::fft(std::vector<std::complex<float>>& data)
-{
-    size_t n = data.size();
-    if (n <= 1) return;
-
-    bit_reverse(data);
-
-    for (size_t len = 2; len <= n; len <<= 1) {
-        float angle = -2.0f * M_PI / len;
-        std::complex<float> wlen(std::cos(angle), std::sin(angle));
-
-        for (size_t i = 0; i < n; i += len) {
-            std::complex<float> w(1.0f, 0.0f);
-            for (size_t j = 0; j < len / 2; ++j) {
-                std::complex<float> u = data[i + j];
-                std::complex<float> v = data[i + j + len / 2] * w;
-                data[i + j] = u + v;
-                data[i + j + len / 2] = u - v;
-                w *= wlen;
-            }
-        }
-    }
-}
-
-void FFTWidget::bit_reverse(std::vector<std::complex<float>>& data)
-{
-    size_t n = data.size();
-    for (size_t i = 1, j = 0; i < n; ++i) {
-        size_t bit = n >> 1;
-        for (; j & bit; bit >>= 1) {
-            j ^= bit;
-        }
-        j ^= bit;
-
-        if (i < j) {
-            std::swap(data[i], data[j]);
-        }
-    }
-}
-
-void FFTWidget::resizeEvent(QResizeEvent *event)
-{
-    QWidget::resizeEvent(event);
-
-    m_plotRect = QRect(
-        m_margin,
-        m_margin,
-        width() - 2 * m_margin,
-        height() - 2 * m_margin
-    );
-}
-
-void FFTWidget::paintEvent(QPaintEvent *event)
-{
-    Q_UNUSED(event)
-
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    drawBackground(painter);
-    drawGrid(painter);
-    drawSpectrum(painter);
-    drawTargetIndicators(painter);
-    drawLabels(painter);
-}
-
-void FFTWidget::drawBackground(QPainter& painter)
-{
-    // Infineon-style background (darker blue)
-    QColor bgColor(40, 44, 52);           // Dark background
-    QColor plotBgColor(50, 54, 62);       // Slightly lighter plot area
-    QColor borderColor(100, 100, 100);    // Gray border
-
-    painter.fillRect(rect(), bgColor);
-    painter.fillRect(m_plotRect, plotBgColor);
-    painter.setPen(QPen(borderColor, 1));
-    painter.drawRect(m_plotRect);
-}
-
-void FFTWidget::drawGrid(QPainter& painter)
-{
-    const int GRID_LINES_X = 10;
-    const int GRID_LINES_Y = 8;
-
-    // Infineon-style grid (subtle gray)
-    QColor gridColor(80, 80, 80, 100);
-    painter.setPen(QPen(gridColor, 1));
-
-    // Vertical grid lines (range)
-    for (int i = 0; i <= GRID_LINES_X; ++i) {
-        int x = m_plotRect.left() + (i * m_plotRect.width()) / GRID_LINES_X;
-        painter.drawLine(x, m_plotRect.top(), x, m_plotRect.bottom());
-    }
-
-    // Horizontal grid lines (magnitude)
-    for (int i = 0; i <= GRID_LINES_Y; ++i) {
-        int y = m_plotRect.top() + (i * m_plotRect.height()) / GRID_LINES_Y;
-        painter.drawLine(m_plotRect.left(), y, m_plotRect.right(), y);
-    }
-}
-
-void FFTWidget::drawSpectrum(QPainter& painter)
-{
-    if (m_magnitudeSpectrum.empty() || m_rangeAxis.empty()) return;
-
-    QVector<QPointF> spectrumPoints;
-
-    // INFINEON-STYLE MAGNITUDE RANGE
-    const float MIN_MAG_DB = -20.0f;  // Matching Infineon GUI
-    const float MAX_MAG_DB = 60.0f;   // Matching Infineon GUI
-
-    for (size_t i = 0; i < m_magnitudeSpectrum.size(); ++i) {
-        float range = m_rangeAxis[i];
-
-        // Only plot points within our range window
-        if (range > m_maxRange || range < m_minRange) continue;
-
-        // Map range to x-coordinate
-        float rangeSpan = m_maxRange - m_minRange;
-        if (rangeSpan <= 0) continue;
-
-        float x = m_plotRect.left() + ((range - m_minRange) / rangeSpan) * m_plotRect.width();
-
-        // Map magnitude to y-coordinate - INFINEON SCALE
-        float magDb = m_magnitudeSpectrum[i];
-        magDb = std::max(MIN_MAG_DB, std::min(MAX_MAG_DB, magDb));
-
-        float y = m_plotRect.bottom() - ((magDb - MIN_MAG_DB) / (MAX_MAG_DB - MIN_MAG_DB)) * m_plotRect.height();
-
-        QPointF point(x, y);
-        spectrumPoints.append(point);
-    }
-
-    if (spectrumPoints.isEmpty()) return;
-
-    // Draw only the spectrum line (no fill)
-    QColor lineColor(37, 99, 235, 255);      // Solid blue outline
-    painter.setPen(QPen(lineColor, 2));
-    painter.setBrush(Qt::NoBrush);  // No fill
-
-    // Draw the spectrum line connecting all points
-    if (spectrumPoints.size() > 1) {
-        QPainterPath spectrumLine;
-        spectrumLine.moveTo(spectrumPoints.first());
-
-        for (int i = 1; i < spectrumPoints.size(); ++i) {
-            spectrumLine.lineTo(spectrumPoints[i]);
-        }
-
-        painter.drawPath(spectrumLine);
-    }
-
-    // Draw peak markers (like Infineon)
-    drawPeakMarkers(painter, spectrumPoints);
-}
-
-void FFTWidget::drawPeakMarkers(QPainter& painter, const QVector<QPointF>& spectrumPoints)
-{
-    if (spectrumPoints.size() < 3) return;
-
-    const float MIN_MAG_DB = -20.0f;
-    const float MAX_MAG_DB = 60.0f;
-    const float PEAK_THRESHOLD = 30.0f; // dB threshold for peak detection
-
-    QVector<QPointF> peaks;
-
-    // Find peaks
-    for (int i = 1; i < spectrumPoints.size() - 1; ++i) {
-        QPointF prev = spectrumPoints[i-1];
-        QPointF curr = spectrumPoints[i];
-        QPointF next = spectrumPoints[i+1];
-
-        // Check if this is a local maximum
-        if (curr.y() < prev.y() && curr.y() < next.y()) {
-            // Convert y back to magnitude for threshold check
-            float magDb = MIN_MAG_DB + ((m_plotRect.bottom() - curr.y()) / m_plotRect.height()) * (MAX_MAG_DB - MIN_MAG_DB);
-
-            if (magDb > PEAK_THRESHOLD) {
-                peaks.append(curr);
-            }
-        }
-    }
-
-    // Draw peak markers (yellow dots like Infineon)
-    painter.setPen(QPen(QColor(255, 255, 0), 2));
-    painter.setBrush(QBrush(QColor(255, 255, 0)));
-
-    for (const QPointF& peak : peaks) {
-        painter.drawEllipse(peak, 6, 6);
-    }
-}
-
-void FFTWidget::drawTargetIndicators(QPainter& painter)
-{
-    if (m_currentTargets.numTracks == 0) return;
-
-    for (uint32_t i = 0; i < m_currentTargets.numTracks; ++i) {
-        const TargetTrack& target = m_currentTargets.targets[i];
-
-        if (target.azimuth < -90.0f || target.azimuth > 90.0f) continue;
-        if (target.radius > m_maxRange || target.radius < m_minRange) continue;
-
-        // Infineon-style target colors
-        QColor targetColor;
-        if (target.radial_speed > 1.0f) {
-            targetColor = QColor(255, 100, 100); // Red approaching
-        } else if (target.radial_speed < -1.0f) {
-            targetColor = QColor(100, 150, 255); // Blue receding
-        } else {
-            targetColor = QColor(100, 255, 100); // Green stationary
-        }
-
-        float rangeSpan = m_maxRange - m_minRange;
-        if (rangeSpan <= 0) continue;
-
-        float x = m_plotRect.left() + ((target.radius - m_minRange) / rangeSpan) * m_plotRect.width();
-
-        // Draw vertical line
-        painter.setPen(QPen(targetColor, 2, Qt::SolidLine));
-        painter.drawLine(QPointF(x, m_plotRect.top()), QPointF(x, m_plotRect.bottom()));
-
-        // Draw target label
-        painter.setPen(QPen(targetColor, 1));
-        painter.setFont(QFont("Arial", 8, QFont::Bold));
-
-        QString targetInfo = QString("T%1").arg(target.target_id);
-        QFontMetrics fm(painter.font());
-        QRect textRect = fm.boundingRect(targetInfo);
-
-        float textX = x - textRect.width() / 2;
-        textX = std::max(float(m_plotRect.left()), std::min(float(m_plotRect.right() - textRect.width()), textX));
-
-        painter.drawText(QPointF(textX, m_plotRect.top() - 5), targetInfo);
-    }
-}
-
-void FFTWidget::drawLabels(QPainter& painter)
-{
-    // Infineon-style white text
-    QColor textColor(255, 255, 255);
-    QColor gridTextColor(180, 180, 180);
-
-    painter.setPen(QPen(gridTextColor, 1));
-    painter.setFont(QFont("Arial", 9));
-
-    // INFINEON MAGNITUDE RANGE
-    const float MIN_MAG_DB = -20.0f;
-    const float MAX_MAG_DB = 60.0f;
-    const int GRID_LINES_X = 10;
-    const int GRID_LINES_Y = 8;
-
-    // X-axis labels (Range in meters)
-    for (int i = 0; i <= GRID_LINES_X; ++i) {
-        if (i % 2 == 0 || i == GRID_LINES_X) {
-            float range = m_minRange + (float(i) / GRID_LINES_X) * (m_maxRange - m_minRange);
-            int x = m_plotRect.left() + (i * m_plotRect.width()) / GRID_LINES_X;
-
-            QString label = QString::number(range, 'f', 0);
-            QFontMetrics fm(painter.font());
-            QRect textRect = fm.boundingRect(label);
-            painter.drawText(x - textRect.width() / 2, m_plotRect.bottom() + 15, label);
-        }
-    }
-
-    // Y-axis labels (Magnitude in dB) - INFINEON RANGE
-    for (int i = 0; i <= GRID_LINES_Y; ++i) {
-        float mag = MIN_MAG_DB + (float(i) / GRID_LINES_Y) * (MAX_MAG_DB - MIN_MAG_DB);
-        int y = m_plotRect.bottom() - (i * m_plotRect.height()) / GRID_LINES_Y;
-
-        QString magText = QString("%1").arg(mag, 0, 'f', 0);
-        painter.drawText(m_plotRect.left() - 35, y + 4, magText);
-    }
-
-    // Axis labels
-    painter.setPen(QPen(textColor, 1));
-    painter.setFont(QFont("Arial", 11, QFont::Bold));
-
-    QFontMetrics fm(painter.font());
-    QString xLabel = "Range [m]";
-    QRect xLabelRect = fm.boundingRect(xLabel);
-    painter.drawText(
-        m_plotRect.center().x() - xLabelRect.width() / 2,
-        height() - 8,
-        xLabel
-    );
-
-    // Y-axis label
-    painter.save();
-    painter.translate(15, m_plotRect.center().y());
-    painter.rotate(-90);
-    QString yLabel = "Magnitude [dBFS]";
-    QRect yLabelRect = fm.boundingRect(yLabel);
-    painter.drawText(-yLabelRect.width() / 2, 0, yLabel);
-    painter.restore();
-
-    // Title - Infineon style
-    painter.setFont(QFont("Arial", 12, QFont::Bold));
-    painter.drawText(QPointF(m_plotRect.left(), 20), "Spectrum");
-
-    // Antenna info like Infineon
-    painter.setPen(QPen(textColor, 1));
-    painter.setFont(QFont("Arial", 8));
-    QString antennaInfo = "■ Ant. Tx1 Rx1";
-    painter.drawText(m_plotRect.right() - 80, 20, antennaInfo);
-
-    // Technical info - matching Infineon parameters
-    painter.setPen(QPen(gridTextColor, 1));
-    QString frameInfo = QString("Samples: %1, BW: %2MHz, Sweep: %3ms")
-                       .arg(m_currentFrame.complex_data.size())
-                       .arg(m_bandwidth / 1000000.0f, 0, 'f', 0)
-                       .arg(m_sweepTime * 1000.0f, 0, 'f', 1);
-    painter.drawText(QPointF(m_plotRect.left(), height() - 10), frameInfo);
-}
+
+// FFTWidget.cpp - Corrected for Infineon Radar GUI style magnitudes
+
+#include "FFTWidget.h"
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainterPath>
+#include <QVector>
+#include <cmath>
+#include <algorithm>
+
+FFTWidget::FFTWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_maxMagnitude(0.0f)
+    , m_sampleRate(100000.0f)    // 100 kHz ADC sampling rate
+    , m_sweepTime(0.0015f)       // 1.5 ms chirp (matching Infineon: 1500 us)
+    , m_bandwidth(100000000.0f)  // 100 MHz bandwidth (matching Infineon)
+    , m_centerFreq(24125000000.0f) // 24.125 GHz (matching Infineon: 24.025-24.125)
+    , m_maxRange(50.0f)
+    , m_minRange(0.0f)
+    , m_margin(50)
+{
+    setMinimumSize(400, 300);
+    setBackgroundRole(QPalette::Base);
+    setAutoFillBackground(true);
+}
+
+void FFTWidget::updateData(const ADCFramePtr& adcFrame)
+{
+    // Same snapshot as last tick: the spectrum is already up to date
+    if (adcFrame == m_currentFrame) return;
+
+    m_currentFrame = adcFrame;
+    if (m_currentFrame && !m_currentFrame->complex_data.empty()) {
+        performFFTFromComplexData(*m_currentFrame);
+    }
+    update();
+}
+
+void FFTWidget::setFrequencyRange(float minFreq, float maxFreq)
+{
+    m_minFrequency = minFreq;
+    m_maxFrequency = maxFreq;
+    update();
+}
+
+void FFTWidget::updateTargets(const TrackSnapshotPtr& targets)
+{
+    if (targets == m_currentTargets) return;
+
+    m_currentTargets = targets;
+    update();
+}
+
+void FFTWidget::setRadarParameters(float sampleRate, float sweepTime, float bandwidth, float centerFreq)
+{
+    m_sampleRate = sampleRate;
+    m_sweepTime = sweepTime;
+    m_bandwidth = bandwidth;
+    m_centerFreq = centerFreq;
+
+    if (!m_magnitudeSpectrum.empty() && m_currentFrame && !m_currentFrame->complex_data.empty()) {
+        performFFTFromComplexData(*m_currentFrame);
+    }
+    update();
+}
+
+void FFTWidget::setMaxRange(float maxRange)
+{
+    m_maxRange = maxRange;
+    update();
+}
+
+void FFTWidget::setMinRange(float minRange)
+{
+    m_minRange = minRange;
+    update();
+}
+
+float FFTWidget::frequencyToRange(float frequency) const
+{
+    // FMCW radar range calculation: R = (f_beat * c * T_sweep) / (2 * B)
+    const float SPEED_OF_LIGHT = 299792458.0f; // m/s
+    return (frequency * SPEED_OF_LIGHT * m_sweepTime) / (2.0f * m_bandwidth);
+}
+
+float FFTWidget::sampleIndexToRange(int sampleIndex) const
+{
+    if (m_rangeAxis.empty() || sampleIndex >= static_cast<int>(m_rangeAxis.size())) {
+        return 0.0f;
+    }
+    return m_rangeAxis[sampleIndex];
+}
+
+void FFTWidget::performFFTFromComplexData(const RawADCFrameTest& frame)
+{
+    const std::vector<ComplexSample>& complexInput = frame.complex_data;
+    if (complexInput.empty()) return;
+
+    size_t numComplexSamples = complexInput.size();
+    if (frame.num_samples_per_chirp > 0) {
+        numComplexSamples = std::min(numComplexSamples, size_t(frame.num_samples_per_chirp));
+    }
+
+    // Single-chirp cube zero-padded to the next power of 2 for the FFT;
+    // the cube and window are reused while the frame size stays the same
+    size_t n = RadarDSP::nextPowerOfTwo(numComplexSamples);
+    m_cube.resize(1, 1, n);
+    for (size_t i = 0; i < numComplexSamples; ++i) {
+        m_cube.real(0, 0, i) = complexInput[i].I;
+        m_cube.imag(0, 0, i) = complexInput[i].Q;
+    }
+
+    // Hanning window over the valid samples for better spectral analysis
+    if (m_window.size() != numComplexSamples) {
+        RadarDSP::hannWindow(numComplexSamples, m_window);
+    }
+    RadarDSP::rangeFFT(m_cube, m_window);
+
+    m_binMagnitudes.resize(n);
+    RadarDSP::magnitude(m_cube.chirp(0, 0), m_binMagnitudes.data());
+
+    // Calculate magnitude spectrum with RADAR-APPROPRIATE scaling
+    size_t spectrumSize = n / 2; // Only positive frequencies
+    m_magnitudeSpectrum.resize(spectrumSize);
+    m_frequencyAxis.resize(spectrumSize);
+    m_rangeAxis.resize(spectrumSize);
+
+    m_maxMagnitude = -50.0f; // Start with reasonable radar minimum
+
+    // Calculate radar-specific parameters for proper scaling
+    float rangeResolution = (SPEED_OF_LIGHT * m_sweepTime) / (2.0f * m_bandwidth);
+    float maxUnambiguousRange = (SPEED_OF_LIGHT * m_sampleRate * m_sweepTime) / (4.0f * m_bandwidth);
+
+    // Scaling factor to match typical radar magnitudes
+    float radarScalingFactor = 60.0f; // Adjust this to match Infineon levels
+
+    for (size_t i = 0; i < spectrumSize; ++i) {
+        // Complex magnitude of this bin
+        float magnitude_linear = m_binMagnitudes[i];
+
+        // RADAR-SPECIFIC MAGNITUDE CALCULATION
+        // Apply FFT normalization
+        magnitude_linear = magnitude_linear / float(numComplexSamples);
+
+        // Add small value to avoid log(0)
+        magnitude_linear = std::max(magnitude_linear, 1e-8f);
+
+        // Convert to dB with radar-appropriate scaling
+        // This matches typical radar return levels
+        float magnitude_dB = 20.0f * std::log10(magnitude_linear) + radarScalingFactor;
+
+        // Add additional conditioning for radar signals
+        if (i < spectrumSize / 4) {
+            // Boost near-range sensitivity (typical for radar)
+            magnitude_dB += 5.0f;
+        }
+
+        m_magnitudeSpectrum[i] = magnitude_dB;
+
+        // Calculate frequency for this bin
+        float frequency = (static_cast<float>(i) * m_sampleRate) / static_cast<float>(n);
+        m_frequencyAxis[i] = frequency;
+
+        // Calculate corresponding range using FMCW radar equation
+        float range = frequencyToRange(frequency);
+        m_rangeAxis[i] = range;
+
+        // Track maximum for display scaling
+        if (magnitude_dB > m_maxMagnitude) {
+            m_maxMagnitude = magnitude_dB;
+        }
+    }
+}
+
+void FFTWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    m_plotRect = QRect(
+        m_margin,
+        m_margin,
+        width() - 2 * m_margin,
+        height() - 2 * m_margin
+    );
+}
+
+void FFTWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    drawBackground(painter);
+    drawGrid(painter);
+    drawSpectrum(painter);
+    drawTargetIndicators(painter);
+    drawLabels(painter);
+}
+
+void FFTWidget::drawBackground(QPainter& painter)
+{
+    // Infineon-style background (darker blue)
+    QColor bgColor(40, 44, 52);           // Dark background
+    QColor plotBgColor(50, 54, 62);       // Slightly lighter plot area
+    QColor borderColor(100, 100, 100);    // Gray border
+
+    painter.fillRect(rect(), bgColor);
+    painter.fillRect(m_plotRect, plotBgColor);
+    painter.setPen(QPen(borderColor, 1));
+    painter.drawRect(m_plotRect);
+}
+
+void FFTWidget::drawGrid(QPainter& painter)
+{
+    const int GRID_LINES_X = 10;
+    const int GRID_LINES_Y = 8;
+
+    // Infineon-style grid (subtle gray)
+    QColor gridColor(80, 80, 80, 100);
+    painter.setPen(QPen(gridColor, 1));
+
+    // Vertical grid lines (range)
+    for (int i = 0; i <= GRID_LINES_X; ++i) {
+        int x = m_plotRect.left() + (i * m_plotRect.width()) / GRID_LINES_X;
+        painter.drawLine(x, m_plotRect.top(), x, m_plotRect.bottom());
+    }
+
+    // Horizontal grid lines (magnitude)
+    for (int i = 0; i <= GRID_LINES_Y; ++i) {
+        int y = m_plotRect.top() + (i * m_plotRect.height()) / GRID_LINES_Y;
+        painter.drawLine(m_plotRect.left(), y, m_plotRect.right(), y);
+    }
+}
+
+void FFTWidget::drawSpectrum(QPainter& painter)
+{
+    if (m_magnitudeSpectrum.empty() || m_rangeAxis.empty()) return;
+
+    QVector<QPointF> spectrumPoints;
+
+    // INFINEON-STYLE MAGNITUDE RANGE
+    const float MIN_MAG_DB = -20.0f;  // Matching Infineon GUI
+    const float MAX_MAG_DB = 60.0f;   // Matching Infineon GUI
+
+    for (size_t i = 0; i < m_magnitudeSpectrum.size(); ++i) {
+        float range = m_rangeAxis[i];
+
+        // Only plot points within our range window
+        if (range > m_maxRange || range < m_minRange) continue;
+
+        // Map range to x-coordinate
+        float rangeSpan = m_maxRange - m_minRange;
+        if (rangeSpan <= 0) continue;
+
+        float x = m_plotRect.left() + ((range - m_minRange) / rangeSpan) * m_plotRect.width();
+
+        // Map magnitude to y-coordinate - INFINEON SCALE
+        float magDb = m_magnitudeSpectrum[i];
+        magDb = std::max(MIN_MAG_DB, std::min(MAX_MAG_DB, magDb));
+
+        float y = m_plotRect.bottom() - ((magDb - MIN_MAG_DB) / (MAX_MAG_DB - MIN_MAG_DB)) * m_plotRect.height();
+
+        QPointF point(x, y);
+        spectrumPoints.append(point);
+    }
+
+    if (spectrumPoints.isEmpty()) return;
+
+    // Draw only the spectrum line (no fill)
+    QColor lineColor(37, 99, 235, 255);      // Solid blue outline
+    painter.setPen(QPen(lineColor, 2));
+    painter.setBrush(Qt::NoBrush);  // No fill
+
+    // Draw the spectrum line connecting all points
+    if (spectrumPoints.size() > 1) {
+        QPainterPath spectrumLine;
+        spectrumLine.moveTo(spectrumPoints.first());
+
+        for (int i = 1; i < spectrumPoints.size(); ++i) {
+            spectrumLine.lineTo(spectrumPoints[i]);
+        }
+
+        painter.drawPath(spectrumLine);
+    }
+
+    // Draw peak markers (like Infineon)
+    drawPeakMarkers(painter, spectrumPoints);
+}
+
+void FFTWidget::drawPeakMarkers(QPainter& painter, const QVector<QPointF>& spectrumPoints)
+{
+    if (spectrumPoints.size() < 3) return;
+
+    const float MIN_MAG_DB = -20.0f;
+    const float MAX_MAG_DB = 60.0f;
+    const float PEAK_THRESHOLD = 30.0f; // dB threshold for peak detection
+
+    QVector<QPointF> peaks;
+
+    // Find peaks
+    for (int i = 1; i < spectrumPoints.size() - 1; ++i) {
+        QPointF prev = spectrumPoints[i-1];
+        QPointF curr = spectrumPoints[i];
+        QPointF next = spectrumPoints[i+1];
+
+        // Check if this is a local maximum
+        if (curr.y() < prev.y() && curr.y() < next.y()) {
+            // Convert y back to magnitude for threshold check
+            float magDb = MIN_MAG_DB + ((m_plotRect.bottom() - curr.y()) / m_plotRect.height()) * (MAX_MAG_DB - MIN_MAG_DB);
+
+            if (magDb > PEAK_THRESHOLD) {
+                peaks.append(curr);
+            }
+        }
+    }
+
+    // Draw peak markers (yellow dots like Infineon)
+    painter.setPen(QPen(QColor(255, 255, 0), 2));
+    painter.setBrush(QBrush(QColor(255, 255, 0)));
+
+    for (const QPointF& peak : peaks) {
+        painter.drawEllipse(peak, 6, 6);
+    }
+}
+
+void FFTWidget::drawTargetIndicators(QPainter& painter)
+{
+    if (!m_currentTargets || m_currentTargets->numTracks == 0) return;
+
+    for (uint32_t i = 0; i < m_currentTargets->numTracks; ++i) {
+        const TargetTrack& target = m_currentTargets->targets[i];
+
+        if (target.azimuth < -90.0f || target.azimuth > 90.0f) continue;
+        if (target.radius > m_maxRange || target.radius < m_minRange) continue;
+
+        // Infineon-style target colors
+        QColor targetColor;
+        if (target.radial_speed > 1.0f) {
+            targetColor = QColor(255, 100, 100); // Red approaching
+        } else if (target.radial_speed < -1.0f) {
+            targetColor = QColor(100, 150, 255); // Blue receding
+        } else {
+            targetColor = QColor(100, 255, 100); // Green stationary
+        }
+
+        float rangeSpan = m_maxRange - m_minRange;
+        if (rangeSpan <= 0) continue;
+
+        float x = m_plotRect.left() + ((target.radius - m_minRange) / rangeSpan) * m_plotRect.width();
+
+        // Draw vertical line
+        painter.setPen(QPen(targetColor, 2, Qt::SolidLine));
+        painter.drawLine(QPointF(x, m_plotRect.top()), QPointF(x, m_plotRect.bottom()));
+
+        // Draw target label
+        painter.setPen(QPen(targetColor, 1));
+        painter.setFont(QFont("Arial", 8, QFont::Bold));
+
+        QString targetInfo = QString("T%1").arg(target.target_id);
+        QFontMetrics fm(painter.font());
+        QRect textRect = fm.boundingRect(targetInfo);
+
+        float textX = x - textRect.width() / 2;
+        textX = std::max(float(m_plotRect.left()), std::min(float(m_plotRect.right() - textRect.width()), textX));
+
+        painter.drawText(QPointF(textX, m_plotRect.top() - 5), targetInfo);
+    }
+}
+
+void FFTWidget::drawLabels(QPainter& painter)
+{
+    // Infineon-style white text
+    QColor textColor(255, 255, 255);
+    QColor gridTextColor(180, 180, 180);
+
+    painter.setPen(QPen(gridTextColor, 1));
+    painter.setFont(QFont("Arial", 9));
+
+    // INFINEON MAGNITUDE RANGE
+    const float MIN_MAG_DB = -20.0f;
+    const float MAX_MAG_DB = 60.0f;
+    const int GRID_LINES_X = 10;
+    const int GRID_LINES_Y = 8;
+
+    // X-axis labels (Range in meters)
+    for (int i = 0; i <= GRID_LINES_X; ++i) {
+        if (i % 2 == 0 || i == GRID_LINES_X) {
+            float range = m_minRange + (float(i) / GRID_LINES_X) * (m_maxRange - m_minRange);
+            int x = m_plotRect.left() + (i * m_plotRect.width()) / GRID_LINES_X;
+
+            QString label = QString::number(range, 'f', 0);
+            QFontMetrics fm(painter.font());
+            QRect textRect = fm.boundingRect(label);
+            painter.drawText(x - textRect.width() / 2, m_plotRect.bottom() + 15, label);
+        }
+    }
+
+    // Y-axis labels (Magnitude in dB) - INFINEON RANGE
+    for (int i = 0; i <= GRID_LINES_Y; ++i) {
+        float mag = MIN_MAG_DB + (float(i) / GRID_LINES_Y) * (MAX_MAG_DB - MIN_MAG_DB);
+        int y = m_plotRect.bottom() - (i * m_plotRect.height()) / GRID_LINES_Y;
+
+        QString magText = QString("%1").arg(mag, 0, 'f', 0);
+        painter.drawText(m_plotRect.left() - 35, y + 4, magText);
+    }
+
+    // Axis labels
+    painter.setPen(QPen(textColor, 1));
+    painter.setFont(QFont("Arial", 11, QFont::Bold));
+
+    QFontMetrics fm(painter.font());
+    QString xLabel = "Range [m]";
+    QRect xLabelRect = fm.boundingRect(xLabel);
+    painter.drawText(
+        m_plotRect.center().x() - xLabelRect.width() / 2,
+        height() - 8,
+        xLabel
+    );
+
+    // Y-axis label
+    painter.save();
+    painter.translate(15, m_plotRect.center().y());
+    painter.rotate(-90);
+    QString yLabel = "Magnitude [dBFS]";
+    QRect yLabelRect = fm.boundingRect(yLabel);
+    painter.drawText(-yLabelRect.width() / 2, 0, yLabel);
+    painter.restore();
+
+    // Title - Infineon style
+    painter.setFont(QFont("Arial", 12, QFont::Bold));
+    painter.drawText(QPointF(m_plotRect.left(), 20), "Spectrum");
+
+    // Antenna info like Infineon
+    painter.setPen(QPen(textColor, 1));
+    painter.setFont(QFont("Arial", 8));
+    QString antennaInfo = "■ Ant. Tx1 Rx1";
+    painter.drawText(m_plotRect.right() - 80, 20, antennaInfo);
+
+    // Technical info - matching Infineon parameters
+    painter.setPen(QPen(gridTextColor, 1));
+    QString frameInfo = QString("Samples: %1, BW: %2MHz, Sweep: %3ms")
+                       .arg(m_currentFrame ? m_currentFrame->complex_data.size() : 0)
+                       .arg(m_bandwidth / 1000000.0f, 0, 'f', 0)
+                       .arg(m_sweepTime * 1000.0f, 0, 'f', 1);
+    painter.drawText(QPointF(m_plotRect.left(), height() - 10), frameInfo);
+}
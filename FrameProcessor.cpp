@@ -0,0 +1,192 @@
+#include "FrameProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const float SPEED_OF_LIGHT = 299792458.0f;
+const float PI = 3.14159265f;
+}
+
+FrameProcessor::Settings::Settings()
+    : window(RadarDSP::WindowHann)
+    , paddingFactor(1)
+    , removeDC(true)
+    , removeStatic(false)
+    , antennas(1)
+    , samplesPerChirp(0)
+    , cfarGuard(2)
+    , cfarTraining(8)
+    , cfarThresholdDb(12.0f)
+    , minRange(0.0f)
+    , maxRange(1e9f)
+    , sampleRate(100000.0f)
+    , sweepTime(0.0015f)
+    , bandwidth(100000000.0f)
+    , centerFrequency(24125000000.0f)
+{
+}
+
+FrameProcessor::FrameProcessor()
+    : m_chirps(0)
+    , m_binRange(0.0f)
+{
+}
+
+void FrameProcessor::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+    m_settings.antennas = std::max<size_t>(m_settings.antennas, 1);
+    m_settings.paddingFactor = RadarDSP::nextPowerOfTwo(std::max<size_t>(m_settings.paddingFactor, 1));
+    m_rangeWindow.clear();     // Rebuilt for the next frame
+    m_dopplerWindow.clear();
+}
+
+bool FrameProcessor::process(const RawADCFrameTest& frame)
+{
+    m_detections.clear();
+    m_profileDb.clear();
+
+    const size_t antennas = m_settings.antennas;
+    const size_t total = frame.complex_data.size();
+    size_t samples = m_settings.samplesPerChirp > 0 ? m_settings.samplesPerChirp : frame.num_samples_per_chirp;
+    if (samples == 0 || samples > total / antennas) samples = total / antennas;
+    if (samples == 0 || total % (antennas * samples) != 0) return false;
+    const size_t chirps = total / (antennas * samples);
+    m_chirps = chirps;
+
+    const size_t rangeBins = RadarDSP::nextPowerOfTwo(samples) * m_settings.paddingFactor;
+    const size_t dopplerBins = RadarDSP::nextPowerOfTwo(chirps);
+    m_cube.resize(antennas, dopplerBins, rangeBins);
+
+    // Samples in, with the DC and static clutter filters on the way
+    const ComplexSample* in = frame.complex_data.data();
+    for (size_t a = 0; a < antennas; ++a) {
+        for (size_t c = 0; c < chirps; ++c) {
+            const ComplexSample* chirp = in + (a * chirps + c) * samples;
+            float meanI = 0.0f;
+            float meanQ = 0.0f;
+            if (m_settings.removeDC) {
+                for (size_t s = 0; s < samples; ++s) {
+                    meanI += chirp[s].I;
+                    meanQ += chirp[s].Q;
+                }
+                meanI /= float(samples);
+                meanQ /= float(samples);
+            }
+            ComplexLineView line = m_cube.chirp(a, c);
+            for (size_t s = 0; s < samples; ++s) {
+                line.real(s) = chirp[s].I - meanI;
+                line.imag(s) = chirp[s].Q - meanQ;
+            }
+        }
+        if (m_settings.removeStatic && chirps > 1) {
+            for (size_t s = 0; s < samples; ++s) {
+                ComplexLineView line = m_cube.rangeBin(a, s);
+                float meanI = 0.0f;
+                float meanQ = 0.0f;
+                for (size_t c = 0; c < chirps; ++c) {
+                    meanI += line.real(c);
+                    meanQ += line.imag(c);
+                }
+                meanI /= float(chirps);
+                meanQ /= float(chirps);
+                for (size_t c = 0; c < chirps; ++c) {
+                    line.real(c) -= meanI;
+                    line.imag(c) -= meanQ;
+                }
+            }
+        }
+    }
+
+    if (m_rangeWindow.size() != samples) {
+        RadarDSP::makeWindow(m_settings.window, samples, m_rangeWindow);
+    }
+    RadarDSP::rangeFFT(m_cube, m_rangeWindow);
+    if (dopplerBins > 1) {
+        if (m_dopplerWindow.size() != chirps) {
+            RadarDSP::makeWindow(m_settings.window, chirps, m_dopplerWindow);
+        }
+        RadarDSP::dopplerFFT(m_cube, m_dopplerWindow);
+    }
+
+    // Range profile: power summed over Doppler bins and antennas, scaled so
+    // a full-scale tone reads 0 dB
+    float gain = 0.0f;
+    for (float w : m_rangeWindow) gain += w;
+    float dopplerGain = 0.0f;
+    for (float w : m_dopplerWindow) dopplerGain += w * w;
+    const float scale = 1.0f / (gain * gain * std::max(dopplerGain * float(dopplerBins), 1.0f) * float(antennas));
+
+    const size_t profileBins = rangeBins / 2;
+    m_power.assign(profileBins, 0.0f);
+    for (size_t a = 0; a < antennas; ++a) {
+        for (size_t d = 0; d < dopplerBins; ++d) {
+            const float* iq = m_cube.chirp(a, d).re;   // Interleaved, contiguous
+            for (size_t k = 0; k < profileBins; ++k) {
+                m_power[k] += iq[2 * k] * iq[2 * k] + iq[2 * k + 1] * iq[2 * k + 1];
+            }
+        }
+    }
+    m_profileDb.resize(profileBins);
+    for (size_t k = 0; k < profileBins; ++k) {
+        m_power[k] *= scale;
+        m_profileDb[k] = 10.0f * std::log10(std::max(m_power[k], 1e-20f));
+    }
+
+    // Bin k is a beat frequency of k * fs / N, from range f * c * T / (2 B)
+    m_binRange = m_settings.sampleRate / float(rangeBins) * SPEED_OF_LIGHT * m_settings.sweepTime
+               / (2.0f * m_settings.bandwidth);
+    const float wavelength = SPEED_OF_LIGHT / m_settings.centerFrequency;
+    const float speedPerBin = wavelength / (2.0f * float(dopplerBins) * m_settings.sweepTime);
+
+    RadarDSP::caCfar(m_power.data(), profileBins, m_settings.cfarGuard, m_settings.cfarTraining,
+                     std::pow(10.0f, m_settings.cfarThresholdDb / 10.0f), m_hits);
+
+    for (uint32_t k : m_hits) {
+        // Bin 0 only holds what the DC filter left behind
+        if (k == 0 && m_settings.removeDC) continue;
+        // One detection per peak, not per cell of it
+        if ((k > 0 && m_power[k - 1] > m_power[k]) || (k + 1 < profileBins && m_power[k + 1] >= m_power[k])) {
+            continue;
+        }
+        const float range = float(k) * m_binRange;
+        if (range < m_settings.minRange || range > m_settings.maxRange) continue;
+
+        size_t bestDoppler = 0;
+        float bestPower = -1.0f;
+        for (size_t d = 0; d < dopplerBins; ++d) {
+            float power = 0.0f;
+            for (size_t a = 0; a < antennas; ++a) {
+                const float re = m_cube.real(a, d, k);
+                const float im = m_cube.imag(a, d, k);
+                power += re * re + im * im;
+            }
+            if (power > bestPower) {
+                bestPower = power;
+                bestDoppler = d;
+            }
+        }
+        const ptrdiff_t signedBin = bestDoppler < dopplerBins / 2 || dopplerBins == 1
+            ? ptrdiff_t(bestDoppler) : ptrdiff_t(bestDoppler) - ptrdiff_t(dopplerBins);
+
+        float azimuth = 0.0f;
+        if (antennas > 1) {
+            // Phase step across the array: sum of x[a+1] * conj(x[a])
+            float re = 0.0f;
+            float im = 0.0f;
+            for (size_t a = 0; a + 1 < antennas; ++a) {
+                const float r0 = m_cube.real(a, bestDoppler, k);
+                const float i0 = m_cube.imag(a, bestDoppler, k);
+                const float r1 = m_cube.real(a + 1, bestDoppler, k);
+                const float i1 = m_cube.imag(a + 1, bestDoppler, k);
+                re += r1 * r0 + i1 * i0;
+                im += i1 * r0 - r1 * i0;
+            }
+            const float sine = std::max(-1.0f, std::min(1.0f, std::atan2(im, re) / PI));
+            azimuth = std::asin(sine) * 180.0f / PI;
+        }
+
+        m_detections.push_back(Detection{range, azimuth, float(signedBin) * speedPerBin, m_profileDb[k]});
+    }
+    return true;
+}
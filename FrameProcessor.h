@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+#include "RadarDataCube.h"
+#include "RadarDSP.h"
+
+// DSP chain from an ADC frame to detections: static clutter removal,
+// windowed range FFT (zero-padded), Doppler FFT across chirps, a range
+// profile integrated over Doppler bins and antennas, CA-CFAR along range,
+// then a Doppler and angle estimate at each hit.
+//
+// A frame holds antennas x chirps x samples, antenna outermost. The chirp
+// length is Settings::samplesPerChirp, else the frame's own
+// num_samples_per_chirp (binary ADC messages do not carry one, so a frame
+// off the wire is one chirp per antenna); the rest are chirps. Angles come from the phase step between
+// adjacent antennas (half-wavelength spacing), speeds from the Doppler bin
+// with positive = approaching, i.e. phase advancing from chirp to chirp.
+class FrameProcessor
+{
+public:
+    struct Settings {
+        RadarDSP::WindowType window;
+        size_t paddingFactor;       // Range FFT length = samples rounded up to 2^n, times this
+        bool removeDC;              // Subtract each chirp's mean
+        bool removeStatic;          // Subtract each sample's mean over chirps (zero-Doppler clutter)
+        size_t antennas;
+        size_t samplesPerChirp;     // 0: from the frame
+
+        size_t cfarGuard;           // Cells each side of the cell under test
+        size_t cfarTraining;
+        float cfarThresholdDb;      // Above the training-cell mean
+        float minRange;             // m
+        float maxRange;
+
+        // FMCW parameters, as in FFTWidget
+        float sampleRate;           // Hz
+        float sweepTime;            // s; chirps are assumed back to back
+        float bandwidth;            // Hz
+        float centerFrequency;      // Hz
+
+        Settings();
+    };
+
+    FrameProcessor();
+
+    void setSettings(const Settings& settings);
+    const Settings& settings() const { return m_settings; }
+
+    // False when the frame does not hold whole chirps for every antenna
+    bool process(const RawADCFrameTest& frame);
+
+    // Results of the last process() call
+    const std::vector<Detection>& detections() const { return m_detections; }
+    const std::vector<float>& rangeProfileDb() const { return m_profileDb; }  // Positive-frequency bins
+    float binRange() const { return m_binRange; }                            // m per profile bin
+    size_t chirps() const { return m_chirps; }
+
+private:
+    Settings m_settings;
+    RadarDataCube m_cube;
+    std::vector<float> m_rangeWindow;
+    std::vector<float> m_dopplerWindow;
+    std::vector<float> m_power;
+    std::vector<float> m_profileDb;
+    std::vector<uint32_t> m_hits;
+    std::vector<Detection> m_detections;
+    size_t m_chirps;
+    float m_binRange;
+};
@@ -1,109 +1,188 @@
-#pragma once
-
-#include <QMainWindow>
-#include <QTimer>
-#include <QUdpSocket>
-#include <QSplitter>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QTableWidget>
-#include <QLabel>
-#include <QStatusBar>
-#include <QGroupBox>
-#include <QSpinBox>
-#include <QPushButton>
-#include <QLineEdit>
-#include <random>
-
-#include "PPIWidget.h"
-#include "FFTWidget.h"
-#include "DataStructures.h"
-
-class MainWindow : public QMainWindow
-{
-    Q_OBJECT
-
-public:
-    MainWindow(QWidget *parent = nullptr);
-    ~MainWindow();
-
-private slots:
-private slots:
-    void updateDisplay();
-    void readPendingDatagrams();
-    void onSimulateDataToggled();
-    void onRangeChanged(int range);
-    void onMinRangeChanged(const QString& text);          // NEW
-    void onChirpChanged(const QString& text);
-    void onBandwidthChanged(const QString& text);
-    void onMinSpeedChanged(const QString& text);          // NEW
-    void onMaxSpeedChanged(const QString& text);          // NEW
-    void onChirpsPerFrameChanged(const QString& text);    // NEW
-    void onSamplesPerChirpChanged(const QString& text);   // NEW
-    void onApplySettings();
-    void onResetSettings();
-
-private:
-    void setupUI();
-    void setupNetworking();
-    void setupTimer();
-    void updateTrackTable();
-    void generateSimulatedTargetData();
-    void generateSimulatedADCData();
-    void parseADCMessage(const QString& message);
-    void parseTrackMessage(const QString& message);
-    
-    // UI Components
-    PPIWidget* m_ppiWidget;
-    FFTWidget* m_fftWidget;
-    QTableWidget* m_trackTable;
-    QSplitter* m_mainSplitter;
-    QSplitter* m_rightSplitter;
-    
-    // Controls
-    QSpinBox* m_rangeSpinBox;
-    QPushButton* m_simulateButton;
-    QLabel* m_statusLabel;
-    QLabel* m_frameCountLabel;
-    
-    // Networking
-    QUdpSocket* m_udpSocket;
-    static constexpr quint16 UDP_PORT = 5000;
-    
-    // Timer
-    QTimer* m_updateTimer;
-    static constexpr int UPDATE_INTERVAL_MS = 50;
-    
-    // Data
-    TargetTrackData m_currentTargets;
-    RawADCFrameTest m_currentADCFrame;
-    
-    // Simulation
-    bool m_simulationEnabled;
-    std::mt19937 m_randomEngine;
-    std::uniform_real_distribution<float> m_rangeDist;
-    std::uniform_real_distribution<float> m_azimuthDist;
-    std::uniform_real_distribution<float> m_speedDist;
-    std::uniform_real_distribution<float> m_levelDist;
-    std::uniform_int_distribution<int> m_numTargetsDist;
-    
-    // Statistics
-    uint64_t m_frameCount;
-    uint64_t m_targetCount;
-
-    // Add these to the private members section
-    QLineEdit* m_chirpLineEdit;
-    QLineEdit* m_bandwidthLineEdit;
-    // Add these to the private members section
-    QLineEdit* m_minRangeLineEdit;
-    QLineEdit* m_minSpeedLineEdit;
-    QLineEdit* m_maxSpeedLineEdit;
-    QLineEdit* m_chirpsPerFrameLineEdit;
-    QLineEdit* m_samplesPerChirpLineEdit;
-
-    // Remove these old ones:
-    // QLineEdit* m_dopplerLineEdit;
-    // QLineEdit* m_rcsLineEdit;
-    QPushButton* m_applyButton;
-    QPushButton* m_resetButton;
-};
+#pragma once
+
+#include <QMainWindow>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QSplitter>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTableView>
+#include <QLabel>
+#include <QStatusBar>
+#include <QGroupBox>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QSlider>
+#include <QLineEdit>
+#include <QElapsedTimer>
+
+#include "PPIWidget.h"
+#include "FFTWidget.h"
+#include "TrackTableModel.h"
+#include "DataStructures.h"
+#include "SnapshotPool.h"
+#include "RadarPipeline.h"
+#include "RecordingWriter.h"
+#include "ReplayEngine.h"
+#include "SceneSimulator.h"
+#include "ScenarioEngine.h"
+
+class MainWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    MainWindow(QWidget *parent = nullptr);
+    ~MainWindow();
+
+private slots:
+private slots:
+    void updateDisplay();
+    void readPendingDatagrams();
+    void onSimulateDataToggled();
+    void onSimulatedTargetsChanged(int count);
+    void onScenarioToggled(bool enabled);
+    void onRangeChanged(int range);
+    void onMinRangeChanged(const QString& text);          // NEW
+    void onChirpChanged(const QString& text);
+    void onBandwidthChanged(const QString& text);
+    void onMinSpeedChanged(const QString& text);          // NEW
+    void onMaxSpeedChanged(const QString& text);          // NEW
+    void onChirpsPerFrameChanged(const QString& text);    // NEW
+    void onSamplesPerChirpChanged(const QString& text);   // NEW
+    void onApplySettings();
+    void onResetSettings();
+    void onHostTrackingToggled(bool enabled);
+    void onClusteringToggled(bool enabled);
+    void onPPISelectionChanged(const QVector<uint32_t>& targetIds);
+    void onTableSelectionChanged();
+    void onZoneDrawn(const std::vector<ZoneVertex>& vertices);
+    void onClearZones();
+    void onRecordToggled(bool enabled);
+    void onReplayToggled(bool enabled);
+    void onReplayPlayPause();
+    void onReplaySpeedChanged(int index);
+    void onReplaySeek();
+    void onReplayRecord(const char* data, size_t size, uint64_t timestamp);
+    void onReplayFinished();
+
+private:
+    void setupUI();
+    void setupNetworking();
+    void setupTimer();
+    void updateTrackTable();
+    void runHostProcessing();
+    void evaluateZones();
+    void updateRecordingStatus();
+    void updateReplayStatus();
+    void updateReceiveStatus();
+    void processDatagram(const char* data, size_t size, uint64_t timestamp);
+    void resetHostProcessing();
+    double pipelineTime() const;
+    TrackSnapshotPtr generateSimulatedTargetData();
+    void setSimulatedSpeeds(float minSpeed, float maxSpeed);
+    ADCFramePtr generateSimulatedADCData(const TargetTrackData& tracks);
+    SceneSimulator::Config sceneConfig() const;
+    DSP_Settings_t dspSettings() const;
+    
+    // UI Components
+    PPIWidget* m_ppiWidget;
+    FFTWidget* m_fftWidget;
+    QTableView* m_trackTable;
+    TrackTableModel* m_trackModel;
+    QSplitter* m_mainSplitter;
+    QSplitter* m_rightSplitter;
+    
+    // Controls
+    QSpinBox* m_rangeSpinBox;
+    QPushButton* m_simulateButton;
+    QSpinBox* m_simulatedTargetsSpinBox;
+    QPushButton* m_scenarioButton;
+    QLabel* m_statusLabel;
+    QLabel* m_frameCountLabel;
+    
+    // Networking
+    QUdpSocket* m_udpSocket;
+    static constexpr quint16 UDP_PORT = 5000;
+    static constexpr int MAX_DATAGRAM_SIZE = 65536;
+    static constexpr int RECEIVE_BUFFER_SIZE = 8 << 20;   // Rides out bursts while a frame is drawn
+    QByteArray m_datagramBuffer;
+    
+    // Timer
+    QTimer* m_updateTimer;
+    static constexpr int UPDATE_INTERVAL_MS = 50;
+
+    // FMCW parameters shared by the spectrum display and the simulation;
+    // the bandwidth comes from the settings panel
+    static constexpr float ADC_SAMPLE_RATE = 100000.0f;       // 100 kHz
+    static constexpr float CHIRP_SWEEP_TIME = 0.001f;         // 1 ms
+    static constexpr float CENTER_FREQUENCY = 24000000000.0f; // 24 GHz
+    static constexpr size_t SIMULATED_ANTENNAS = 2;
+    
+    // Data
+    SnapshotPool<TargetTrackData> m_trackPool;   // Simulated frames
+    SnapshotPool<RawADCFrameTest> m_framePool;
+
+    // Decoding, optional clustering/tracking and geofence alarms; the
+    // display shows its output tracks
+    RadarPipeline m_pipeline;
+    QElapsedTimer m_hostClock;
+
+    // Recording of received datagrams and/or decoded frames
+    RecordingWriter m_recorder;
+
+    // Replay of a recording through the same path as received datagrams
+    ReplayEngine m_replay;
+    
+    // Simulation
+    bool m_simulationEnabled;
+    ScenarioEngine m_scenario;            // Simulated targets, moving between frames
+    double m_lastScenarioStep;            // Host clock, s
+    static constexpr int MAX_SIMULATED_TARGETS = 100000;
+    static constexpr double MAX_SCENARIO_STEP = 0.25;     // s; longer gaps (simulation off) are not replayed
+    SceneSimulator m_sceneSimulator;      // ADC frames of the simulated targets
+    static constexpr size_t MAX_SCENE_TARGETS = 64;       // Strongest targets in the ADC frame
+    std::vector<SceneSimulator::Target> m_sceneTargets;
+    
+    // Statistics
+    uint64_t m_frameCount;
+    uint64_t m_targetCount;
+
+    // Set while the table selection is being updated from the PPI
+    bool m_syncingSelection;
+
+    // Add these to the private members section
+    QLineEdit* m_chirpLineEdit;
+    QLineEdit* m_bandwidthLineEdit;
+    // Add these to the private members section
+    QLineEdit* m_minRangeLineEdit;
+    QLineEdit* m_minSpeedLineEdit;
+    QLineEdit* m_maxSpeedLineEdit;
+    QLineEdit* m_chirpsPerFrameLineEdit;
+    QLineEdit* m_samplesPerChirpLineEdit;
+
+    // Remove these old ones:
+    // QLineEdit* m_dopplerLineEdit;
+    // QLineEdit* m_rcsLineEdit;
+    QCheckBox* m_persistenceCheckBox;
+    QCheckBox* m_trailsCheckBox;
+    QCheckBox* m_interpolationCheckBox;
+    QCheckBox* m_clusteringCheckBox;
+    QCheckBox* m_hostTrackingCheckBox;
+    QPushButton* m_drawZoneButton;
+    QPushButton* m_clearZonesButton;
+    QPushButton* m_recordButton;
+    QCheckBox* m_recordRawCheckBox;
+    QCheckBox* m_recordDecodedCheckBox;
+    QCheckBox* m_recordCompressCheckBox;
+    QLabel* m_recordingLabel;
+    QLabel* m_receiveLabel;
+    QPushButton* m_replayButton;
+    QPushButton* m_replayPlayButton;
+    QComboBox* m_replaySpeedCombo;
+    QSlider* m_replaySlider;
+    QPushButton* m_applyButton;
+    QPushButton* m_resetButton;
+};
@@ -0,0 +1,365 @@
+#include "MultiTargetTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+const float RAD_TO_DEG = 180.0f / 3.14159265358979f;
+const float AUCTION_EPSILON = 0.01f;         // In squared-Mahalanobis units
+const float INITIAL_RADIAL_VELOCITY_SIGMA = 1.0f;    // m/s, measured by the sensor
+const float INITIAL_TANGENTIAL_VELOCITY_SIGMA = 30.0f;
+const float MAX_PREDICTION_STEP = 5.0f;      // s; longer gaps are treated as 5 s
+const float MIN_GRID_CELL = 1.0f;            // m; keeps the grid bounded for tight gates
+
+} // namespace
+
+MultiTargetTracker::MultiTargetTracker()
+    : m_enabled(false)
+    , m_maxTracks(DEFAULT_MAX_TRACKS)
+    , m_rangeSigma(0.5f)
+    , m_azimuthSigma(1.0f * DEG_TO_RAD)
+    , m_accelerationSigma(3.0f)
+    , m_gateThreshold(13.82f)                // 99.9% for 2 degrees of freedom
+    , m_maxGateDistance(100.0f)
+    , m_confirmHits(3)
+    , m_maxMissesTentative(1)
+    , m_maxMissesConfirmed(5)
+    , m_lastTime(0.0)
+    , m_hasTime(false)
+    , m_nextId(1)
+{
+}
+
+void MultiTargetTracker::configure(const DSP_Settings_t& settings)
+{
+    m_enabled = settings.enable_tracking != 0;
+    m_maxTracks = settings.num_of_tracks != 0 ? settings.num_of_tracks : DEFAULT_MAX_TRACKS;
+}
+
+void MultiTargetTracker::setMeasurementNoise(float rangeSigma, float azimuthSigmaDeg)
+{
+    m_rangeSigma = rangeSigma;
+    m_azimuthSigma = azimuthSigmaDeg * DEG_TO_RAD;
+}
+
+void MultiTargetTracker::clear()
+{
+    m_tracks.clear();
+    m_hasTime = false;
+}
+
+void MultiTargetTracker::update(const std::vector<Detection>& detections, double timeSeconds)
+{
+    float dt = m_hasTime ? static_cast<float>(timeSeconds - m_lastTime) : 0.0f;
+    dt = std::min(std::max(dt, 0.0f), MAX_PREDICTION_STEP);
+    m_lastTime = timeSeconds;
+    m_hasTime = true;
+
+    for (Track& track : m_tracks) {
+        predict(track, dt);
+    }
+
+    // Detection positions in the tracking frame
+    const size_t detectionCount = detections.size();
+    m_detX.resize(detectionCount);
+    m_detY.resize(detectionCount);
+    for (size_t i = 0; i < detectionCount; ++i) {
+        const float azimuth = detections[i].azimuth * DEG_TO_RAD;
+        m_detX[i] = detections[i].range * std::sin(azimuth);
+        m_detY[i] = detections[i].range * std::cos(azimuth);
+    }
+
+    associate(detections);
+
+    // Correct assigned tracks, age the rest
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        Track& track = m_tracks[t];
+        const int32_t detection = m_trackAssignment[t];
+        if (detection >= 0) {
+            correct(track, detections[detection], size_t(detection));
+            track.misses = 0;
+            if (track.hits < 0xFFFF) ++track.hits;
+            if (track.hits >= m_confirmHits) track.confirmed = true;
+        } else if (track.misses < 0xFFFF) {
+            ++track.misses;
+        }
+    }
+
+    m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(), [this](const Track& track) {
+        return track.misses > (track.confirmed ? m_maxMissesConfirmed : m_maxMissesTentative);
+    }), m_tracks.end());
+
+    // Detections outside every gate seed new tracks while there is room
+    for (size_t d = 0; d < detectionCount && m_tracks.size() < m_maxTracks; ++d) {
+        if (m_detectionOwner[d] == -1) {
+            startTrack(detections[d], d);
+        }
+    }
+}
+
+void MultiTargetTracker::predict(Track& track, float dt) const
+{
+    if (dt <= 0.0f) return;
+
+    track.x += track.vx * dt;
+    track.y += track.vy * dt;
+
+    // P = F P F^T with F = [I dt*I; 0 I], done blockwise on the 2x2 blocks
+    float* P = track.P;
+    for (int r = 0; r < 4; ++r) {
+        P[r * 4 + 0] += dt * P[r * 4 + 2];
+        P[r * 4 + 1] += dt * P[r * 4 + 3];
+    }
+    for (int c = 0; c < 4; ++c) {
+        P[0 * 4 + c] += dt * P[2 * 4 + c];
+        P[1 * 4 + c] += dt * P[3 * 4 + c];
+    }
+
+    // White-acceleration process noise
+    const float q = m_accelerationSigma * m_accelerationSigma;
+    const float dt2 = dt * dt;
+    const float qPos = q * dt2 * dt2 / 4.0f;
+    const float qCross = q * dt2 * dt / 2.0f;
+    const float qVel = q * dt2;
+    P[0] += qPos;
+    P[5] += qPos;
+    P[2] += qCross;
+    P[8] += qCross;
+    P[7] += qCross;
+    P[13] += qCross;
+    P[10] += qVel;
+    P[15] += qVel;
+}
+
+void MultiTargetTracker::measurementCovariance(const Detection& detection, float& r00, float& r01, float& r11) const
+{
+    // Polar noise mapped through the Jacobian of (r sin a, r cos a)
+    const float azimuth = detection.azimuth * DEG_TO_RAD;
+    const float s = std::sin(azimuth);
+    const float c = std::cos(azimuth);
+    const float varRange = m_rangeSigma * m_rangeSigma;
+    const float varCross = detection.range * detection.range * m_azimuthSigma * m_azimuthSigma;
+
+    r00 = s * s * varRange + c * c * varCross;
+    r01 = s * c * (varRange - varCross);
+    r11 = c * c * varRange + s * s * varCross;
+}
+
+void MultiTargetTracker::correct(Track& track, const Detection& detection, size_t detectionIndex) const
+{
+    float r00, r01, r11;
+    measurementCovariance(detection, r00, r01, r11);
+
+    float* P = track.P;
+    const float s00 = P[0] + r00;
+    const float s01 = P[1] + r01;
+    const float s11 = P[5] + r11;
+    const float det = s00 * s11 - s01 * s01;
+    if (det <= 0.0f) return;
+    const float i00 = s11 / det;
+    const float i01 = -s01 / det;
+    const float i11 = s00 / det;
+
+    // K = P H^T S^-1 (4x2)
+    float K[8];
+    for (int r = 0; r < 4; ++r) {
+        const float p0 = P[r * 4 + 0];
+        const float p1 = P[r * 4 + 1];
+        K[r * 2 + 0] = p0 * i00 + p1 * i01;
+        K[r * 2 + 1] = p0 * i01 + p1 * i11;
+    }
+
+    const float nx = m_detX[detectionIndex] - track.x;
+    const float ny = m_detY[detectionIndex] - track.y;
+    track.x += K[0] * nx + K[1] * ny;
+    track.y += K[2] * nx + K[3] * ny;
+    track.vx += K[4] * nx + K[5] * ny;
+    track.vy += K[6] * nx + K[7] * ny;
+
+    // P = P - K (H P), H P being the first two rows of P
+    float HP[8];
+    std::copy(P, P + 8, HP);
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            P[r * 4 + c] -= K[r * 2 + 0] * HP[c] + K[r * 2 + 1] * HP[4 + c];
+        }
+    }
+
+    track.level = detection.level;
+}
+
+void MultiTargetTracker::associate(const std::vector<Detection>& detections)
+{
+    const size_t trackCount = m_tracks.size();
+    const size_t detectionCount = detections.size();
+
+    m_trackAssignment.assign(trackCount, -1);
+    m_detectionOwner.assign(detectionCount, -1);
+    if (trackCount == 0 || detectionCount == 0) return;
+
+    // Search radius per track from the largest eigenvalue of the predicted
+    // position covariance plus the worst measurement noise at its range
+    m_gateRadius.resize(trackCount);
+    float maxRadius = MIN_GRID_CELL;
+    for (size_t t = 0; t < trackCount; ++t) {
+        const Track& track = m_tracks[t];
+        const float a = track.P[0];
+        const float b = track.P[1];
+        const float c = track.P[5];
+        const float range = std::sqrt(track.x * track.x + track.y * track.y);
+        const float noise = std::max(m_rangeSigma * m_rangeSigma, range * range * m_azimuthSigma * m_azimuthSigma);
+        const float lambda = 0.5f * (a + c) + std::sqrt(0.25f * (a - c) * (a - c) + b * b) + noise;
+        m_gateRadius[t] = std::min(std::sqrt(m_gateThreshold * lambda), m_maxGateDistance);
+        maxRadius = std::max(maxRadius, m_gateRadius[t]);
+    }
+
+    // Cells as large as the largest gate, so no search spans more than 3x3
+    m_grid.build(m_detX.data(), m_detY.data(), detectionCount, maxRadius);
+
+    // Gated candidate pairs, grouped by track
+    m_candidates.clear();
+    m_candidateStart.resize(trackCount + 1);
+    for (size_t t = 0; t < trackCount; ++t) {
+        m_candidateStart[t] = uint32_t(m_candidates.size());
+        const Track& track = m_tracks[t];
+        const float a = track.P[0];
+        const float b = track.P[1];
+        const float c = track.P[5];
+        const float radius = m_gateRadius[t];
+
+        m_grid.forEachInRadius(track.x, track.y, radius, [&](size_t d) {
+            // The gate ellipse lies inside the search circle
+            const float nx = m_detX[d] - track.x;
+            const float ny = m_detY[d] - track.y;
+            if (nx * nx + ny * ny > radius * radius) return;
+
+            float r00, r01, r11;
+            measurementCovariance(detections[d], r00, r01, r11);
+            const float s00 = a + r00;
+            const float s01 = b + r01;
+            const float s11 = c + r11;
+            const float det = s00 * s11 - s01 * s01;
+            if (det <= 0.0f) return;
+
+            const float distance = (s11 * nx * nx - 2.0f * s01 * nx * ny + s00 * ny * ny) / det;
+            if (distance <= m_gateThreshold) {
+                m_candidates.push_back(Candidate{uint32_t(t), uint32_t(d), distance});
+            }
+        });
+    }
+    m_candidateStart[trackCount] = uint32_t(m_candidates.size());
+
+    // Gated detections that end up unassigned are not used to start tracks
+    for (const Candidate& candidate : m_candidates) {
+        m_detectionOwner[candidate.detection] = -2;
+    }
+
+    // Auction (Gauss-Seidel, single epsilon). Tracks bid for detections; each
+    // track also has a private "miss" option worth -gate, so a track only
+    // takes a detection whose cost plus price beats missing.
+    m_prices.assign(detectionCount, 0.0f);
+    m_queue.clear();
+    for (size_t t = 0; t < trackCount; ++t) {
+        if (m_candidateStart[t + 1] > m_candidateStart[t]) {
+            m_queue.push_back(uint32_t(t));
+        }
+    }
+
+    const float missValue = -m_gateThreshold;
+    while (!m_queue.empty()) {
+        const uint32_t t = m_queue.back();
+        m_queue.pop_back();
+
+        int32_t best = -1;
+        float bestValue = missValue;
+        float secondValue = missValue;
+        for (uint32_t k = m_candidateStart[t]; k < m_candidateStart[t + 1]; ++k) {
+            const Candidate& candidate = m_candidates[k];
+            const float value = -candidate.cost - m_prices[candidate.detection];
+            if (value > bestValue) {
+                secondValue = bestValue;
+                bestValue = value;
+                best = int32_t(candidate.detection);
+            } else if (value > secondValue) {
+                secondValue = value;
+            }
+        }
+
+        if (best < 0) {
+            m_trackAssignment[t] = -1;  // Missing is the best option
+            continue;
+        }
+
+        m_prices[best] += bestValue - secondValue + AUCTION_EPSILON;
+        const int32_t previousOwner = m_detectionOwner[best];
+        if (previousOwner >= 0) {
+            m_trackAssignment[previousOwner] = -1;
+            m_queue.push_back(uint32_t(previousOwner));
+        }
+        m_detectionOwner[best] = int32_t(t);
+        m_trackAssignment[t] = best;
+    }
+}
+
+void MultiTargetTracker::startTrack(const Detection& detection, size_t detectionIndex)
+{
+    Track track;
+    track.id = m_nextId++;
+    if (m_nextId == 0) m_nextId = 1;
+
+    track.x = m_detX[detectionIndex];
+    track.y = m_detY[detectionIndex];
+    track.level = detection.level;
+    track.hits = 1;
+    track.misses = 0;
+    track.confirmed = m_confirmHits <= 1;
+
+    // Velocity along the line of sight from the measured radial speed
+    const float range = std::max(detection.range, 1e-3f);
+    const float ux = track.x / range;
+    const float uy = track.y / range;
+    track.vx = -detection.radial_speed * ux;
+    track.vy = -detection.radial_speed * uy;
+
+    std::fill(track.P, track.P + 16, 0.0f);
+    float r00, r01, r11;
+    measurementCovariance(detection, r00, r01, r11);
+    track.P[0] = r00;
+    track.P[1] = r01;
+    track.P[4] = r01;
+    track.P[5] = r11;
+
+    // Tight along the line of sight, loose across it
+    const float radialVar = INITIAL_RADIAL_VELOCITY_SIGMA * INITIAL_RADIAL_VELOCITY_SIGMA;
+    const float tangentialVar = INITIAL_TANGENTIAL_VELOCITY_SIGMA * INITIAL_TANGENTIAL_VELOCITY_SIGMA;
+    track.P[10] = tangentialVar + (radialVar - tangentialVar) * ux * ux;
+    track.P[11] = (radialVar - tangentialVar) * ux * uy;
+    track.P[14] = track.P[11];
+    track.P[15] = tangentialVar + (radialVar - tangentialVar) * uy * uy;
+
+    m_tracks.push_back(track);
+}
+
+void MultiTargetTracker::exportTracks(TargetTrackData& out) const
+{
+    out.reset();
+    for (const Track& track : m_tracks) {
+        if (!track.confirmed) continue;
+
+        const float range2 = track.x * track.x + track.y * track.y;
+        const float range = std::sqrt(range2);
+
+        TargetTrack target{};
+        target.target_id = track.id;
+        target.level = track.level;
+        target.radius = range;
+        target.azimuth = std::atan2(track.x, track.y) * RAD_TO_DEG;
+        if (range > 1e-3f) {
+            target.radial_speed = -(track.x * track.vx + track.y * track.vy) / range;
+            target.azimuth_speed = (track.y * track.vx - track.x * track.vy) / range2 * RAD_TO_DEG;
+        }
+        out.targets.push_back(target);
+    }
+    out.numTracks = static_cast<uint32_t>(out.targets.size());
+}
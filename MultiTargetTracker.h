@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+#include "SpatialHashGrid.h"
+#include "WireFormat.h"
+
+// Host-side multi-target tracker.
+// Each track is a constant-velocity Kalman filter on (x, y, vx, vy) in
+// metres, with x to the right and y along 0° azimuth. Detections are
+// associated by Mahalanobis gating. Candidate pairs come from a uniform grid
+// over the predicted positions, and an auction over the sparse candidate set
+// does the global nearest-neighbour assignment. Detections outside every gate
+// start tentative tracks; tracks are confirmed after a few hits and dropped after
+// a run of misses.
+class MultiTargetTracker
+{
+public:
+    MultiTargetTracker();
+
+    // enable_tracking switches the tracker on; num_of_tracks caps the number
+    // of tracks (0 keeps DEFAULT_MAX_TRACKS)
+    void configure(const DSP_Settings_t& settings);
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    void setMaxTracks(size_t maxTracks) { m_maxTracks = maxTracks; }
+
+    // Noise model
+    void setMeasurementNoise(float rangeSigma, float azimuthSigmaDeg);
+    void setProcessNoise(float accelerationSigma) { m_accelerationSigma = accelerationSigma; }
+
+    // Process one frame of detections taken at timeSeconds
+    void update(const std::vector<Detection>& detections, double timeSeconds);
+    void clear();
+
+    // Confirmed tracks in the sensor's TargetTrack convention
+    void exportTracks(TargetTrackData& out) const;
+
+    size_t trackCount() const { return m_tracks.size(); }
+
+    static constexpr size_t DEFAULT_MAX_TRACKS = 4096;
+
+private:
+    struct Track {
+        uint32_t id;
+        float x, y, vx, vy;
+        float P[16];         // 4x4 state covariance, row-major
+        float level;
+        uint16_t hits;
+        uint16_t misses;
+        bool confirmed;
+    };
+
+    struct Candidate {
+        uint32_t track;
+        uint32_t detection;
+        float cost;           // Squared Mahalanobis distance
+    };
+
+    void predict(Track& track, float dt) const;
+    void correct(Track& track, const Detection& detection, size_t detectionIndex) const;
+    void measurementCovariance(const Detection& detection, float& r00, float& r01, float& r11) const;
+    void associate(const std::vector<Detection>& detections);
+    void startTrack(const Detection& detection, size_t detectionIndex);
+
+    bool m_enabled;
+    size_t m_maxTracks;
+    float m_rangeSigma;
+    float m_azimuthSigma;     // radians
+    float m_accelerationSigma;
+    float m_gateThreshold;    // Chi-square, 2 dof
+    float m_maxGateDistance;  // Upper bound on the gate radius (m)
+    uint16_t m_confirmHits;
+    uint16_t m_maxMissesTentative;
+    uint16_t m_maxMissesConfirmed;
+    double m_lastTime;
+    bool m_hasTime;
+    uint32_t m_nextId;
+
+    std::vector<Track> m_tracks;
+
+    // Per-frame scratch, kept to avoid reallocation
+    std::vector<float> m_detX;
+    std::vector<float> m_detY;
+    std::vector<float> m_gateRadius;         // Per track, m
+    std::vector<Candidate> m_candidates;
+    std::vector<uint32_t> m_candidateStart;  // Per track, into m_candidates
+    std::vector<int32_t> m_trackAssignment;  // Detection index or -1
+    std::vector<int32_t> m_detectionOwner;   // Track index, -2 gated only, -1 free
+    std::vector<float> m_prices;
+    std::vector<uint32_t> m_queue;
+    SpatialHashGrid m_grid;
+};
@@ -1,559 +1,1270 @@
-//#include "PPIWidget.h"
-//#include <QPaintEvent>
-//#include <QResizeEvent>
-//#include <QFont>
-//#include <QFontMetrics>
-//#include <cmath>
-//#include <QtMath>
-
-
-//PPIWidget::PPIWidget(QWidget *parent)
-//    : QWidget(parent)
-//    , m_maxRange(50.0f) // 500 default
-//    , m_plotRadius(0)
-//{
-//    setMinimumSize(400, 200);
-//    setBackgroundRole(QPalette::Base);
-//    setAutoFillBackground(true);
-//}
-
-//void PPIWidget::updateTargets(const TargetTrackData& trackData)
-//{
-//    m_currentTargets = trackData;
-//    update();
-//}
-
-//void PPIWidget::setMaxRange(float range)
-//{
-//    if (range > 0) {
-//        m_maxRange = range;
-//        update();
-//    }
-//}
-
-//void PPIWidget::resizeEvent(QResizeEvent *event)
-//{
-//    QWidget::resizeEvent(event);
-
-//    // Calculate plot area (semi-circle)
-//    int margin = 40;
-//    int availableWidth = width() - 2 * margin;
-//    int availableHeight = height() - 2 * margin;
-
-//    // For semi-circle, height should be at least half of width
-//    int diameter = std::min(availableWidth, availableHeight * 2);
-//    m_plotRadius = diameter / 2.0f;
-
-//    m_plotRect = QRect(
-//        (width() - diameter) / 2,
-//        height() - margin - m_plotRadius,
-//        diameter,
-//        m_plotRadius
-//    );
-
-//    m_center = QPointF(width() / 2.0f, height() - margin);
-//}
-
-//void PPIWidget::paintEvent(QPaintEvent *event)
-//{
-//    Q_UNUSED(event)
-
-//    QPainter painter(this);
-//    painter.setRenderHint(QPainter::Antialiasing);
-
-//    drawBackground(painter);
-//    drawRangeRings(painter);
-//    drawAzimuthLines(painter);
-//    drawTargets(painter);
-//    drawLabels(painter);
-//}
-
-//void PPIWidget::drawBackground(QPainter& painter)
-//{
-//    // Fill background
-//    painter.fillRect(rect(), QColor(20, 20, 20));
-
-//    // Draw semi-circular plot area
-//    painter.setBrush(QColor(0, 0, 0));
-//    painter.setPen(QPen(QColor(100, 100, 100), 2));
-
-//    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
-//                       2 * m_plotRadius, 2 * m_plotRadius);
-//    painter.drawChord(ellipseRect, 0, 180 * 16); // Draw upper semi-circle
-//}
-
-//void PPIWidget::drawRangeRings(QPainter& painter)
-//{
-//    painter.setPen(QPen(QColor(100, 100, 100), 1));
-
-//    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
-//        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
-//        QRectF ellipseRect(m_center.x() - radius, m_center.y() - radius,
-//                           2 * radius, 2 * radius);
-//        painter.drawChord(ellipseRect, 0, 180 * 16);
-//    }
-//}
-
-//void PPIWidget::drawAzimuthLines(QPainter& painter)
-//{
-//    painter.setPen(QPen(QColor(100, 100, 100), 1));
-
-//    for (int i = 0; i < NUM_AZIMUTH_LINES; ++i) {
-//        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
-//        float radians = qDegreesToRadians(90.0f - azimuth); // Convert to math coordinates
-
-//        QPointF endPoint(
-//            m_center.x() + m_plotRadius * std::cos(radians),
-//            m_center.y() - m_plotRadius * std::sin(radians)
-//        );
-
-//        painter.drawLine(m_center, endPoint);
-//    }
-//}
-
-//void PPIWidget::drawTargets(QPainter& painter)
-//{
-//    for (const auto& target : m_currentTargets.targets) {
-//        // Skip targets outside our azimuth range
-//        if (target.azimuth < MIN_AZIMUTH || target.azimuth > MAX_AZIMUTH) {
-//            continue;
-//        }
-
-//        // Skip targets outside our range
-//        if (target.radius > m_maxRange) {
-//            continue;
-//        }
-
-//        QPointF targetPos = polarToCartesian(target.radius, target.azimuth);
-//        QColor targetColor = getTargetColor(target.radial_speed);
-
-//        // Draw target as a circle
-//        painter.setBrush(targetColor);
-//        painter.setPen(QPen(targetColor.lighter(), 2));
-
-//        float targetSize = 5.0f;// 6 + target.level * 0.1f; // Size based on level
-//        painter.drawEllipse(targetPos, targetSize, targetSize);
-
-//        // Draw target ID just above the red dot
-//        painter.setPen(QPen(Qt::white, 1));
-//        painter.setFont(QFont("Arial", 8));
-//        QPointF textPos = targetPos + QPointF(0, -targetSize - 5);
-//        painter.drawText(textPos, QString::number(target.target_id));
-//    }
-//}
-
-//void PPIWidget::drawLabels(QPainter& painter)
-//{
-//    painter.setPen(QPen(Qt::white, 1));
-//    painter.setFont(QFont("Arial", 10));
-
-//    // Range labels
-//    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
-//        float range = (float(i) / NUM_RANGE_RINGS) * m_maxRange;
-//        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
-
-//        QPointF labelPos(m_center.x() + radius * 0.707f, m_center.y() - radius * 0.707f);
-//        QString rangeText = QString("%1").arg(range, 0, 'f', 1) + "m";
-//        painter.drawText(labelPos, rangeText);
-//    }
-
-//    // Azimuth labels
-//    QFont azFont("Arial", 12, QFont::Bold);
-//    painter.setFont(azFont);
-
-//    for (int i = 0; i < NUM_AZIMUTH_LINES; i += 2) { // Label every other line
-//        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
-//        float radians = qDegreesToRadians(90.0f - azimuth);
-
-//        QPointF labelPos(
-//            m_center.x() + (m_plotRadius + 20) * std::cos(radians),
-//            m_center.y() - (m_plotRadius + 20) * std::sin(radians)
-//        );
-
-//        QString azText = QString("%1°").arg(azimuth, 0, 'f', 0);
-//        QFontMetrics fm(azFont);
-//        QRect textRect = fm.boundingRect(azText);
-//        labelPos -= QPointF(textRect.width() / 2, -textRect.height() / 2);
-
-//        painter.drawText(labelPos, azText);
-//    }
-
-//    // Title
-//    painter.setFont(QFont("Arial", 14, QFont::Bold));
-//    painter.drawText(QPointF(10, 25), "PPI Display - Target Tracks");
-//}
-
-//QColor PPIWidget::getTargetColor(float radialSpeed) const
-//{
-//    // Color coding based on radial speed
-//    // Red for approaching (positive speed)
-//    // Blue for receding (negative speed)
-//    // Green for stationary
-
-//    if (std::abs(radialSpeed) < 1.0f) {
-//        return QColor(0, 255, 0); // Green for stationary
-//    } else if (radialSpeed > 0) {
-//        // Approaching - red (intensity based on speed)
-//        int intensity = std::min(255, static_cast<int>(50 + std::abs(radialSpeed) * 10));
-//        return QColor(intensity, 0, 0);
-//    } else {
-//        // Receding - blue (intensity based on speed)
-//        int intensity = std::min(255, static_cast<int>(50 + std::abs(radialSpeed) * 10));
-//        return QColor(0, 0, intensity);
-//    }
-//}
-
-//QPointF PPIWidget::polarToCartesian(float range, float azimuth) const
-//{
-//    // Normalize range to plot radius
-//    float normalizedRange = (range / m_maxRange) * m_plotRadius;
-
-//    // Convert azimuth to radians (0° is up/north, positive is clockwise)
-//    float radians = qDegreesToRadians(90.0f - azimuth);
-
-//    return QPointF(
-//        m_center.x() + normalizedRange * std::cos(radians),
-//        m_center.y() - normalizedRange * std::sin(radians)
-//    );
-//}
-
-
-
-// PPIWidget.cpp - Enhanced with FoV ±20° highlighting
-
-#include "PPIWidget.h"
-#include <QPaintEvent>
-#include <QResizeEvent>
-#include <QFont>
-#include <QFontMetrics>
-#include <cmath>
-#include <QtMath>
-
-PPIWidget::PPIWidget(QWidget *parent)
-    : QWidget(parent)
-    , m_maxRange(50.0f)
-    , m_plotRadius(0)
-    , m_fovAngle(20.0f)  // ±20 degrees FoV
-{
-    setMinimumSize(400, 200);
-    setBackgroundRole(QPalette::Base);
-    setAutoFillBackground(true);
-}
-
-void PPIWidget::updateTargets(const TargetTrackData& trackData)
-{
-    m_currentTargets = trackData;
-    update();
-}
-
-void PPIWidget::setMaxRange(float range)
-{
-    if (range > 0) {
-        m_maxRange = range;
-        update();
-    }
-}
-
-void PPIWidget::setFoVAngle(float angle)
-{
-    if (angle > 0 && angle <= 90) {
-        m_fovAngle = angle;
-        update();
-    }
-}
-
-void PPIWidget::resizeEvent(QResizeEvent *event)
-{
-    QWidget::resizeEvent(event);
-
-    // Calculate plot area (semi-circle)
-    int margin = 40;
-    int availableWidth = width() - 2 * margin;
-    int availableHeight = height() - 2 * margin;
-
-    // For semi-circle, height should be at least half of width
-    int diameter = std::min(availableWidth, availableHeight * 2);
-    m_plotRadius = diameter / 2.0f;
-
-    m_plotRect = QRect(
-        (width() - diameter) / 2,
-        height() - margin - m_plotRadius,
-        diameter,
-        m_plotRadius
-    );
-
-    m_center = QPointF(width() / 2.0f, height() - margin);
-}
-
-void PPIWidget::paintEvent(QPaintEvent *event)
-{
-    Q_UNUSED(event)
-
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    drawBackground(painter);
-    drawFoVHighlight(painter);  // Draw FoV before other elements
-    drawRangeRings(painter);
-    drawAzimuthLines(painter);
-    drawFoVBoundaries(painter); // Draw FoV boundaries on top
-    drawTargets(painter);
-    drawLabels(painter);
-}
-
-void PPIWidget::drawBackground(QPainter& painter)
-{
-    // Fill background with dark theme
-    painter.fillRect(rect(), QColor(30, 58, 95)); // Blue theme background
-
-    // Draw semi-circular plot area
-    painter.setBrush(QColor(44, 82, 130)); // Darker blue for plot area
-    painter.setPen(QPen(QColor(70, 130, 180), 2));
-
-    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
-                       2 * m_plotRadius, 2 * m_plotRadius);
-    painter.drawChord(ellipseRect, 0, 180 * 16); // Draw upper semi-circle
-}
-
-void PPIWidget::drawFoVHighlight(QPainter& painter)
-{
-    // Create a highlighted sector for the Field of View (±20°)
-    painter.save();
-
-    // Set up semi-transparent green fill for active FoV area
-    QColor fovColor(0, 255, 0, 60); // Green with transparency
-    painter.setBrush(QBrush(fovColor));
-    painter.setPen(Qt::NoPen);
-
-    // Calculate the angular span in Qt's coordinate system
-    // Qt angles: 0° = 3 o'clock, 90° = 6 o'clock, positive = counter-clockwise
-    // Our radar: 0° = 12 o'clock (north), positive = clockwise
-    // Conversion: qt_angle = 90° - radar_angle
-
-    float startAngleRadar = -m_fovAngle;  // -20°
-    float endAngleRadar = m_fovAngle;     // +20°
-
-    // Convert to Qt angles (in 16ths of a degree)
-    int startAngleQt = static_cast<int>((90.0f - endAngleRadar) * 16);   // Start from +20° radar
-    int spanAngleQt = static_cast<int>((endAngleRadar - startAngleRadar) * 16); // 40° span
-
-    // Draw the FoV sector
-    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
-                       2 * m_plotRadius, 2 * m_plotRadius);
-
-    // Only draw the upper half (semi-circle) within FoV
-    if (startAngleQt >= 0 && startAngleQt <= 180 * 16) {
-        painter.drawPie(ellipseRect, startAngleQt, spanAngleQt);
-    }
-
-    painter.restore();
-}
-
-void PPIWidget::drawFoVBoundaries(QPainter& painter)
-{
-    // Draw FoV boundary lines
-    painter.save();
-
-    // Use bright green for FoV boundaries
-    painter.setPen(QPen(QColor(0, 255, 0), 2, Qt::SolidLine));
-
-    // Draw left boundary (-20°)
-    float leftAngle = -m_fovAngle;
-    float leftRadians = qDegreesToRadians(90.0f - leftAngle);
-    QPointF leftEndPoint(
-        m_center.x() + m_plotRadius * std::cos(leftRadians),
-        m_center.y() - m_plotRadius * std::sin(leftRadians)
-    );
-    painter.drawLine(m_center, leftEndPoint);
-
-    // Draw right boundary (+20°)
-    float rightAngle = m_fovAngle;
-    float rightRadians = qDegreesToRadians(90.0f - rightAngle);
-    QPointF rightEndPoint(
-        m_center.x() + m_plotRadius * std::cos(rightRadians),
-        m_center.y() - m_plotRadius * std::sin(rightRadians)
-    );
-    painter.drawLine(m_center, rightEndPoint);
-
-    // Draw FoV arc at the perimeter
-    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
-                       2 * m_plotRadius, 2 * m_plotRadius);
-    int startAngleQt = static_cast<int>((90.0f - rightAngle) * 16);
-    int spanAngleQt = static_cast<int>((rightAngle - leftAngle) * 16);
-    painter.drawArc(ellipseRect, startAngleQt, spanAngleQt);
-
-    painter.restore();
-}
-
-void PPIWidget::drawRangeRings(QPainter& painter)
-{
-    painter.setPen(QPen(QColor(90, 159, 212, 150), 1)); // Blue theme grid color
-
-    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
-        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
-        QRectF ellipseRect(m_center.x() - radius, m_center.y() - radius,
-                           2 * radius, 2 * radius);
-        painter.drawChord(ellipseRect, 0, 180 * 16);
-    }
-}
-
-void PPIWidget::drawAzimuthLines(QPainter& painter)
-{
-    painter.setPen(QPen(QColor(90, 159, 212, 150), 1)); // Blue theme grid color
-
-    for (int i = 0; i < NUM_AZIMUTH_LINES; ++i) {
-        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
-        float radians = qDegreesToRadians(90.0f - azimuth);
-
-        QPointF endPoint(
-            m_center.x() + m_plotRadius * std::cos(radians),
-            m_center.y() - m_plotRadius * std::sin(radians)
-        );
-
-        // Draw different styles for lines within and outside FoV
-        if (azimuth >= -m_fovAngle && azimuth <= m_fovAngle) {
-            // Lines within FoV - slightly brighter
-            painter.setPen(QPen(QColor(120, 179, 232, 200), 1));
-        } else {
-            // Lines outside FoV - dimmer
-            painter.setPen(QPen(QColor(90, 159, 212, 100), 1));
-        }
-
-        painter.drawLine(m_center, endPoint);
-    }
-}
-
-void PPIWidget::drawTargets(QPainter& painter)
-{
-    for (const auto& target : m_currentTargets.targets) {
-        // Skip targets outside our azimuth range
-        if (target.azimuth < MIN_AZIMUTH || target.azimuth > MAX_AZIMUTH) {
-            continue;
-        }
-
-        // Skip targets outside our range
-        if (target.radius > m_maxRange) {
-            continue;
-        }
-
-        QPointF targetPos = polarToCartesian(target.radius, target.azimuth);
-        QColor targetColor = getTargetColor(target.radial_speed);
-
-        // Check if target is within FoV
-        bool inFoV = (target.azimuth >= -m_fovAngle && target.azimuth <= m_fovAngle);
-
-        // Draw target as a circle
-        painter.setBrush(targetColor);
-        if (inFoV) {
-            // Targets within FoV - brighter border
-            painter.setPen(QPen(targetColor.lighter(), 3));
-        } else {
-            // Targets outside FoV - dimmer appearance
-            QColor dimmedColor = targetColor;
-            dimmedColor.setAlpha(100);
-            painter.setBrush(dimmedColor);
-            painter.setPen(QPen(dimmedColor.lighter(), 2));
-        }
-
-        float targetSize = inFoV ? 6.0f : 4.0f; // Larger targets in FoV
-        painter.drawEllipse(targetPos, targetSize, targetSize);
-
-        // Draw target ID
-        painter.setPen(QPen(Qt::white, 1));
-        painter.setFont(QFont("Arial", inFoV ? 9 : 7)); // Larger text in FoV
-        QPointF textPos = targetPos + QPointF(0, -targetSize - 5);
-        painter.drawText(textPos, QString::number(target.target_id));
-    }
-}
-
-void PPIWidget::drawLabels(QPainter& painter)
-{
-    painter.setPen(QPen(QColor(179, 217, 255), 1)); // Blue theme text color
-    painter.setFont(QFont("Arial", 10));
-
-    // Range labels
-    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
-        float range = (float(i) / NUM_RANGE_RINGS) * m_maxRange;
-        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
-
-        QPointF labelPos(m_center.x() + radius * 0.707f, m_center.y() - radius * 0.707f);
-        QString rangeText = QString("%1").arg(range, 0, 'f', 1) + "m";
-        painter.drawText(labelPos, rangeText);
-    }
-
-    // Azimuth labels
-    QFont azFont("Arial", 12, QFont::Bold);
-    painter.setFont(azFont);
-    painter.setPen(QPen(QColor(179, 217, 255), 1));
-
-    for (int i = 0; i < NUM_AZIMUTH_LINES; i += 2) {
-        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
-        float radians = qDegreesToRadians(90.0f - azimuth);
-
-        QPointF labelPos(
-            m_center.x() + (m_plotRadius + 20) * std::cos(radians),
-            m_center.y() - (m_plotRadius + 20) * std::sin(radians)
-        );
-
-        QString azText = QString("%1°").arg(azimuth, 0, 'f', 0);
-        QFontMetrics fm(azFont);
-        QRect textRect = fm.boundingRect(azText);
-        labelPos -= QPointF(textRect.width() / 2, -textRect.height() / 2);
-
-        // Highlight FoV boundary labels
-        if (azimuth == -m_fovAngle || azimuth == m_fovAngle) {
-            painter.setPen(QPen(QColor(0, 255, 0), 1)); // Green for FoV boundaries
-        } else {
-            painter.setPen(QPen(QColor(179, 217, 255), 1)); // Normal blue
-        }
-
-        painter.drawText(labelPos, azText);
-    }
-
-    // Title and FoV indicator
-    painter.setFont(QFont("Arial", 14, QFont::Bold));
-    painter.setPen(QPen(QColor(135, 206, 235), 1)); // Sky blue for title
-    painter.drawText(QPointF(10, 25), "PPI Display - Target Tracks");
-
-    // FoV information
-    painter.setFont(QFont("Arial", 10));
-    painter.setPen(QPen(QColor(0, 255, 0), 1)); // Green for FoV info
-    QString fovText = QString("FoV: ±%1°").arg(m_fovAngle, 0, 'f', 0);
-    painter.drawText(QPointF(10, 45), fovText);
-
-    // Legend
-    painter.setFont(QFont("Arial", 8));
-    painter.setPen(QPen(QColor(179, 217, 255), 1));
-    painter.drawText(QPointF(10, height() - 30), "Green area: Active Field of View");
-    painter.drawText(QPointF(10, height() - 15), "Bright targets: Within FoV, Dim targets: Outside FoV");
-}
-
-QColor PPIWidget::getTargetColor(float radialSpeed) const
-{
-    // Enhanced color coding based on radial speed
-    if (std::abs(radialSpeed) < 1.0f) {
-        return QColor(0, 255, 0); // Green for stationary
-    } else if (radialSpeed > 0) {
-        // Approaching - red (intensity based on speed)
-        int intensity = std::min(255, static_cast<int>(100 + std::abs(radialSpeed) * 15));
-        return QColor(intensity, 50, 50);
-    } else {
-        // Receding - blue (intensity based on speed)
-        int intensity = std::min(255, static_cast<int>(100 + std::abs(radialSpeed) * 15));
-        return QColor(50, 50, intensity);
-    }
-}
-
-QPointF PPIWidget::polarToCartesian(float range, float azimuth) const
-{
-    // Normalize range to plot radius
-    float normalizedRange = (range / m_maxRange) * m_plotRadius;
-
-    // Convert azimuth to radians (0° is up/north, positive is clockwise)
-    float radians = qDegreesToRadians(90.0f - azimuth);
-
-    return QPointF(
-        m_center.x() + normalizedRange * std::cos(radians),
-        m_center.y() - normalizedRange * std::sin(radians)
-    );
-}
+//#include "PPIWidget.h"
+//#include <QPaintEvent>
+//#include <QResizeEvent>
+//#include <QFont>
+//#include <QFontMetrics>
+//#include <cmath>
+//#include <QtMath>
+
+
+//PPIWidget::PPIWidget(QWidget *parent)
+//    : QWidget(parent)
+//    , m_maxRange(50.0f) // 500 default
+//    , m_plotRadius(0)
+//{
+//    setMinimumSize(400, 200);
+//    setBackgroundRole(QPalette::Base);
+//    setAutoFillBackground(true);
+//}
+
+//void PPIWidget::updateTargets(const TargetTrackData& trackData)
+//{
+//    m_currentTargets = trackData;
+//    update();
+//}
+
+//void PPIWidget::setMaxRange(float range)
+//{
+//    if (range > 0) {
+//        m_maxRange = range;
+//        update();
+//    }
+//}
+
+//void PPIWidget::resizeEvent(QResizeEvent *event)
+//{
+//    QWidget::resizeEvent(event);
+
+//    // Calculate plot area (semi-circle)
+//    int margin = 40;
+//    int availableWidth = width() - 2 * margin;
+//    int availableHeight = height() - 2 * margin;
+
+//    // For semi-circle, height should be at least half of width
+//    int diameter = std::min(availableWidth, availableHeight * 2);
+//    m_plotRadius = diameter / 2.0f;
+
+//    m_plotRect = QRect(
+//        (width() - diameter) / 2,
+//        height() - margin - m_plotRadius,
+//        diameter,
+//        m_plotRadius
+//    );
+
+//    m_center = QPointF(width() / 2.0f, height() - margin);
+//}
+
+//void PPIWidget::paintEvent(QPaintEvent *event)
+//{
+//    Q_UNUSED(event)
+
+//    QPainter painter(this);
+//    painter.setRenderHint(QPainter::Antialiasing);
+
+//    drawBackground(painter);
+//    drawRangeRings(painter);
+//    drawAzimuthLines(painter);
+//    drawTargets(painter);
+//    drawLabels(painter);
+//}
+
+//void PPIWidget::drawBackground(QPainter& painter)
+//{
+//    // Fill background
+//    painter.fillRect(rect(), QColor(20, 20, 20));
+
+//    // Draw semi-circular plot area
+//    painter.setBrush(QColor(0, 0, 0));
+//    painter.setPen(QPen(QColor(100, 100, 100), 2));
+
+//    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
+//                       2 * m_plotRadius, 2 * m_plotRadius);
+//    painter.drawChord(ellipseRect, 0, 180 * 16); // Draw upper semi-circle
+//}
+
+//void PPIWidget::drawRangeRings(QPainter& painter)
+//{
+//    painter.setPen(QPen(QColor(100, 100, 100), 1));
+
+//    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
+//        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
+//        QRectF ellipseRect(m_center.x() - radius, m_center.y() - radius,
+//                           2 * radius, 2 * radius);
+//        painter.drawChord(ellipseRect, 0, 180 * 16);
+//    }
+//}
+
+//void PPIWidget::drawAzimuthLines(QPainter& painter)
+//{
+//    painter.setPen(QPen(QColor(100, 100, 100), 1));
+
+//    for (int i = 0; i < NUM_AZIMUTH_LINES; ++i) {
+//        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
+//        float radians = qDegreesToRadians(90.0f - azimuth); // Convert to math coordinates
+
+//        QPointF endPoint(
+//            m_center.x() + m_plotRadius * std::cos(radians),
+//            m_center.y() - m_plotRadius * std::sin(radians)
+//        );
+
+//        painter.drawLine(m_center, endPoint);
+//    }
+//}
+
+//void PPIWidget::drawTargets(QPainter& painter)
+//{
+//    for (const auto& target : m_currentTargets.targets) {
+//        // Skip targets outside our azimuth range
+//        if (target.azimuth < MIN_AZIMUTH || target.azimuth > MAX_AZIMUTH) {
+//            continue;
+//        }
+
+//        // Skip targets outside our range
+//        if (target.radius > m_maxRange) {
+//            continue;
+//        }
+
+//        QPointF targetPos = polarToCartesian(target.radius, target.azimuth);
+//        QColor targetColor = getTargetColor(target.radial_speed);
+
+//        // Draw target as a circle
+//        painter.setBrush(targetColor);
+//        painter.setPen(QPen(targetColor.lighter(), 2));
+
+//        float targetSize = 5.0f;// 6 + target.level * 0.1f; // Size based on level
+//        painter.drawEllipse(targetPos, targetSize, targetSize);
+
+//        // Draw target ID just above the red dot
+//        painter.setPen(QPen(Qt::white, 1));
+//        painter.setFont(QFont("Arial", 8));
+//        QPointF textPos = targetPos + QPointF(0, -targetSize - 5);
+//        painter.drawText(textPos, QString::number(target.target_id));
+//    }
+//}
+
+//void PPIWidget::drawLabels(QPainter& painter)
+//{
+//    painter.setPen(QPen(Qt::white, 1));
+//    painter.setFont(QFont("Arial", 10));
+
+//    // Range labels
+//    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
+//        float range = (float(i) / NUM_RANGE_RINGS) * m_maxRange;
+//        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
+
+//        QPointF labelPos(m_center.x() + radius * 0.707f, m_center.y() - radius * 0.707f);
+//        QString rangeText = QString("%1").arg(range, 0, 'f', 1) + "m";
+//        painter.drawText(labelPos, rangeText);
+//    }
+
+//    // Azimuth labels
+//    QFont azFont("Arial", 12, QFont::Bold);
+//    painter.setFont(azFont);
+
+//    for (int i = 0; i < NUM_AZIMUTH_LINES; i += 2) { // Label every other line
+//        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
+//        float radians = qDegreesToRadians(90.0f - azimuth);
+
+//        QPointF labelPos(
+//            m_center.x() + (m_plotRadius + 20) * std::cos(radians),
+//            m_center.y() - (m_plotRadius + 20) * std::sin(radians)
+//        );
+
+//        QString azText = QString("%1°").arg(azimuth, 0, 'f', 0);
+//        QFontMetrics fm(azFont);
+//        QRect textRect = fm.boundingRect(azText);
+//        labelPos -= QPointF(textRect.width() / 2, -textRect.height() / 2);
+
+//        painter.drawText(labelPos, azText);
+//    }
+
+//    // Title
+//    painter.setFont(QFont("Arial", 14, QFont::Bold));
+//    painter.drawText(QPointF(10, 25), "PPI Display - Target Tracks");
+//}
+
+//QColor PPIWidget::getTargetColor(float radialSpeed) const
+//{
+//    // Color coding based on radial speed
+//    // Red for approaching (positive speed)
+//    // Blue for receding (negative speed)
+//    // Green for stationary
+
+//    if (std::abs(radialSpeed) < 1.0f) {
+//        return QColor(0, 255, 0); // Green for stationary
+//    } else if (radialSpeed > 0) {
+//        // Approaching - red (intensity based on speed)
+//        int intensity = std::min(255, static_cast<int>(50 + std::abs(radialSpeed) * 10));
+//        return QColor(intensity, 0, 0);
+//    } else {
+//        // Receding - blue (intensity based on speed)
+//        int intensity = std::min(255, static_cast<int>(50 + std::abs(radialSpeed) * 10));
+//        return QColor(0, 0, intensity);
+//    }
+//}
+
+//QPointF PPIWidget::polarToCartesian(float range, float azimuth) const
+//{
+//    // Normalize range to plot radius
+//    float normalizedRange = (range / m_maxRange) * m_plotRadius;
+
+//    // Convert azimuth to radians (0° is up/north, positive is clockwise)
+//    float radians = qDegreesToRadians(90.0f - azimuth);
+
+//    return QPointF(
+//        m_center.x() + normalizedRange * std::cos(radians),
+//        m_center.y() - normalizedRange * std::sin(radians)
+//    );
+//}
+
+
+
+// PPIWidget.cpp - Enhanced with FoV ±20° highlighting
+
+#include "PPIWidget.h"
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QApplication>
+#include <QToolTip>
+#include <QFont>
+#include <QFontMetrics>
+#include <cmath>
+#include <algorithm>
+#include <QtMath>
+
+PPIWidget::PPIWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_screenPositionsValid(false)
+    , m_screenGeneration(1)
+    , m_visibleGeneration(0)
+    , m_hitGeneration(0)
+    , m_rubberBand(nullptr)
+    , m_pressed(false)
+    , m_hoverIndex(-1)
+    , m_zoneEngine(nullptr)
+    , m_zoneDrawing(false)
+    , m_maxRange(50.0f)
+    , m_plotRadius(0)
+    , m_fovAngle(20.0f)  // ±20 degrees FoV
+    , m_labelGridColumns(0)
+    , m_labelGridRows(0)
+    , m_spriteDpr(0.0)
+    , m_labelFontFoV("Arial", 9)
+    , m_labelFontOutside("Arial", 7)
+    , m_persistenceEnabled(false)
+    , m_persistenceDecay(0.85f)
+    , m_trailsEnabled(false)
+    , m_frameTimer(new QTimer(this))
+    , m_interpolationEnabled(false)
+{
+    setMinimumSize(400, 200);
+    setBackgroundRole(QPalette::Base);
+    setAutoFillBackground(true);
+    setMouseTracking(true);  // Hover readouts
+    setFocusPolicy(Qt::ClickFocus);  // Escape cancels a zone being drawn
+
+    m_spriteBatches.resize(COLOR_BUCKETS * 2);
+
+    // Phosphor green ramp: intensity maps to both brightness and opacity
+    m_persistenceColors.resize(256);
+    for (int i = 0; i < 256; ++i) {
+        m_persistenceColors[i] = qRgba(0, 255, 80, i * 3 / 4);
+    }
+
+    m_clock.start();
+
+    m_frameTimer->setInterval(FRAME_INTERVAL_MS);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout, this, QOverload<>::of(&PPIWidget::update));
+}
+
+void PPIWidget::updateTargets(const TrackSnapshotPtr& trackData)
+{
+    // The display tick re-sends the current snapshot even when no new frame
+    // arrived. Only the afterglow advances then; the derived columns, trail
+    // history and extrapolation reference time are left as they are.
+    const bool newData = (trackData != m_currentTargets);
+    if (newData) {
+        m_currentTargets = trackData;
+        if (m_currentTargets) {
+            m_trackArrays.assign(*m_currentTargets);
+        } else {
+            m_trackArrays.clear();
+        }
+        m_screenPositionsValid = false;
+        ++m_screenGeneration;
+        m_hoverIndex = -1;
+    }
+
+    if (m_persistenceEnabled) {
+        accumulatePersistence();
+    }
+    if (m_trailsEnabled && newData && m_currentTargets) {
+        m_trackHistory.update(*m_currentTargets, m_clock.elapsed() / 1000.0);
+    }
+    if (m_interpolationEnabled && newData) {
+        m_extrapolator.setReports(m_trackArrays, m_clock.elapsed() / 1000.0);
+    }
+    update();
+}
+
+void PPIWidget::setMaxRange(float range)
+{
+    if (range > 0) {
+        m_maxRange = range;
+        m_persistence.clear();  // Old positions no longer match the scale
+        m_trackHistory.invalidateGeometry();
+        m_screenPositionsValid = false;
+        ++m_screenGeneration;
+        update();
+    }
+}
+
+void PPIWidget::setPersistenceEnabled(bool enabled)
+{
+    if (m_persistenceEnabled == enabled) return;
+
+    m_persistenceEnabled = enabled;
+    m_persistence.clear();
+    update();
+}
+
+void PPIWidget::setPersistenceDecay(float factor)
+{
+    m_persistenceDecay = std::max(0.0f, std::min(1.0f, factor));
+}
+
+void PPIWidget::setTrailsEnabled(bool enabled)
+{
+    if (m_trailsEnabled == enabled) return;
+
+    m_trailsEnabled = enabled;
+    m_trackHistory.clear();
+    update();
+}
+
+void PPIWidget::setTrailLength(int points)
+{
+    m_trackHistory.setPointsPerTrack(points);
+    update();
+}
+
+void PPIWidget::setTrailMemoryLimit(size_t bytes)
+{
+    m_trackHistory.setMemoryLimit(bytes);
+    update();
+}
+
+void PPIWidget::setInterpolationEnabled(bool enabled)
+{
+    if (m_interpolationEnabled == enabled) return;
+
+    m_interpolationEnabled = enabled;
+    if (enabled) {
+        m_extrapolator.setReports(m_trackArrays, m_clock.elapsed() / 1000.0);
+        m_frameTimer->start();
+    } else {
+        m_frameTimer->stop();
+        m_extrapolator.clear();
+    }
+    update();
+}
+
+void PPIWidget::setMaxExtrapolation(double seconds)
+{
+    m_extrapolator.setMaxExtrapolation(std::max(0.0, seconds));
+}
+
+void PPIWidget::setFoVAngle(float angle)
+{
+    if (angle > 0 && angle <= 90) {
+        m_fovAngle = angle;
+        update();
+    }
+}
+
+void PPIWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    // Calculate plot area (semi-circle)
+    int margin = 40;
+    int availableWidth = width() - 2 * margin;
+    int availableHeight = height() - 2 * margin;
+
+    // For semi-circle, height should be at least half of width
+    int diameter = std::min(availableWidth, availableHeight * 2);
+    m_plotRadius = diameter / 2.0f;
+
+    m_plotRect = QRect(
+        (width() - diameter) / 2,
+        height() - margin - m_plotRadius,
+        diameter,
+        m_plotRadius
+    );
+
+    m_center = QPointF(width() / 2.0f, height() - margin);
+
+    m_persistence.resize(width(), height());
+    m_trackHistory.invalidateGeometry();
+    m_screenPositionsValid = false;
+    ++m_screenGeneration;
+}
+
+void PPIWidget::setZoneEngine(const ZoneEngine* zones)
+{
+    m_zoneEngine = zones;
+    update();
+}
+
+void PPIWidget::setZoneDrawingEnabled(bool enabled)
+{
+    if (m_zoneDrawing == enabled) return;
+
+    m_zoneDrawing = enabled;
+    m_zoneDraft.clear();
+    setCursor(enabled ? Qt::CrossCursor : Qt::ArrowCursor);
+    update();
+}
+
+void PPIWidget::finishZoneDraft()
+{
+    // Taken out first: receivers may switch drawing mode off
+    std::vector<ZoneVertex> vertices;
+    vertices.swap(m_zoneDraft);
+    if (vertices.size() >= 3) {
+        emit zoneDrawn(vertices);
+    }
+    update();
+}
+
+void PPIWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (m_zoneDrawing && m_plotRadius > 0) {
+        if (event->button() == Qt::LeftButton) {
+            m_zoneDraft.push_back(screenToGround(event->pos()));
+            m_zoneCursor = event->pos();
+            update();
+        } else if (event->button() == Qt::RightButton) {
+            finishZoneDraft();
+        }
+        return;
+    }
+
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    m_pressPos = event->pos();
+    m_pressed = true;
+}
+
+void PPIWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_zoneDrawing) {
+        m_zoneCursor = event->pos();
+        if (!m_zoneDraft.empty()) update();
+        return;
+    }
+
+    // Dragging with the left button: rubber-band selection
+    if (m_pressed && (event->buttons() & Qt::LeftButton)) {
+        if (!m_rubberBand || !m_rubberBand->isVisible()) {
+            if ((event->pos() - m_pressPos).manhattanLength() < QApplication::startDragDistance()) {
+                return;
+            }
+            if (!m_rubberBand) {
+                m_rubberBand = new QRubberBand(QRubberBand::Rectangle, this);
+            }
+            QToolTip::hideText();
+        }
+        m_rubberBand->setGeometry(QRect(m_pressPos, event->pos()).normalized());
+        m_rubberBand->show();
+        return;
+    }
+
+    // Hover: readout for the nearest target under the cursor
+    int index = targetAt(event->pos(), HIT_RADIUS);
+    if (index == m_hoverIndex) return;
+
+    m_hoverIndex = index;
+    if (index >= 0) {
+        QToolTip::showText(event->globalPos(), targetToolTip(index), this);
+    } else {
+        QToolTip::hideText();
+    }
+}
+
+void PPIWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || !m_pressed) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    m_pressed = false;
+
+    const bool additive = event->modifiers() & Qt::ControlModifier;
+    if (!additive) {
+        m_selectedIds.clear();
+    }
+
+    if (m_rubberBand && m_rubberBand->isVisible()) {
+        QVector<uint32_t> boxed;
+        targetsIn(QRectF(m_rubberBand->geometry()), boxed);
+        for (uint32_t id : boxed) {
+            m_selectedIds.insert(id);
+        }
+        m_rubberBand->hide();
+    } else {
+        int index = targetAt(event->pos(), HIT_RADIUS);
+        if (index >= 0) {
+            uint32_t id = m_trackArrays.target_id[index];
+            // Ctrl-click toggles a target in or out of the selection
+            if (additive && m_selectedIds.contains(id)) {
+                m_selectedIds.remove(id);
+            } else {
+                m_selectedIds.insert(id);
+            }
+        }
+    }
+
+    emit selectionChanged(selectedTargets());
+    update();
+}
+
+void PPIWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    // The first click of the pair already placed the closing vertex
+    if (m_zoneDrawing && event->button() == Qt::LeftButton) {
+        finishZoneDraft();
+        return;
+    }
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void PPIWidget::keyPressEvent(QKeyEvent *event)
+{
+    if (m_zoneDrawing && event->key() == Qt::Key_Escape) {
+        m_zoneDraft.clear();
+        update();
+        return;
+    }
+    QWidget::keyPressEvent(event);
+}
+
+void PPIWidget::leaveEvent(QEvent *event)
+{
+    QWidget::leaveEvent(event);
+    m_hoverIndex = -1;
+}
+
+void PPIWidget::setSelectedTargets(const QVector<uint32_t>& targetIds)
+{
+    QSet<uint32_t> selection;
+    selection.reserve(targetIds.size());
+    for (uint32_t id : targetIds) {
+        selection.insert(id);
+    }
+    if (selection == m_selectedIds) return;
+
+    m_selectedIds.swap(selection);
+    update();
+}
+
+QVector<uint32_t> PPIWidget::selectedTargets() const
+{
+    QVector<uint32_t> ids;
+    ids.reserve(m_selectedIds.size());
+    for (uint32_t id : m_selectedIds) {
+        ids.append(id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void PPIWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    drawBackground(painter);
+    drawFoVHighlight(painter);  // Draw FoV before other elements
+    drawRangeRings(painter);
+    drawAzimuthLines(painter);
+    drawFoVBoundaries(painter); // Draw FoV boundaries on top
+    drawZones(painter);
+    drawPersistence(painter);   // Afterglow sits under the live targets
+    drawTrails(painter);
+    drawTargets(painter);
+    drawLabels(painter);
+}
+
+void PPIWidget::drawBackground(QPainter& painter)
+{
+    // Fill background with dark theme
+    painter.fillRect(rect(), QColor(30, 58, 95)); // Blue theme background
+
+    // Draw semi-circular plot area
+    painter.setBrush(QColor(44, 82, 130)); // Darker blue for plot area
+    painter.setPen(QPen(QColor(70, 130, 180), 2));
+
+    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
+                       2 * m_plotRadius, 2 * m_plotRadius);
+    painter.drawChord(ellipseRect, 0, 180 * 16); // Draw upper semi-circle
+}
+
+void PPIWidget::drawFoVHighlight(QPainter& painter)
+{
+    // Create a highlighted sector for the Field of View (±20°)
+    painter.save();
+
+    // Set up semi-transparent green fill for active FoV area
+    QColor fovColor(0, 255, 0, 60); // Green with transparency
+    painter.setBrush(QBrush(fovColor));
+    painter.setPen(Qt::NoPen);
+
+    // Calculate the angular span in Qt's coordinate system
+    // Qt angles: 0° = 3 o'clock, 90° = 6 o'clock, positive = counter-clockwise
+    // Our radar: 0° = 12 o'clock (north), positive = clockwise
+    // Conversion: qt_angle = 90° - radar_angle
+
+    float startAngleRadar = -m_fovAngle;  // -20°
+    float endAngleRadar = m_fovAngle;     // +20°
+
+    // Convert to Qt angles (in 16ths of a degree)
+    int startAngleQt = static_cast<int>((90.0f - endAngleRadar) * 16);   // Start from +20° radar
+    int spanAngleQt = static_cast<int>((endAngleRadar - startAngleRadar) * 16); // 40° span
+
+    // Draw the FoV sector
+    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
+                       2 * m_plotRadius, 2 * m_plotRadius);
+
+    // Only draw the upper half (semi-circle) within FoV
+    if (startAngleQt >= 0 && startAngleQt <= 180 * 16) {
+        painter.drawPie(ellipseRect, startAngleQt, spanAngleQt);
+    }
+
+    painter.restore();
+}
+
+void PPIWidget::drawFoVBoundaries(QPainter& painter)
+{
+    // Draw FoV boundary lines
+    painter.save();
+
+    // Use bright green for FoV boundaries
+    painter.setPen(QPen(QColor(0, 255, 0), 2, Qt::SolidLine));
+
+    // Draw left boundary (-20°)
+    float leftAngle = -m_fovAngle;
+    float leftRadians = qDegreesToRadians(90.0f - leftAngle);
+    QPointF leftEndPoint(
+        m_center.x() + m_plotRadius * std::cos(leftRadians),
+        m_center.y() - m_plotRadius * std::sin(leftRadians)
+    );
+    painter.drawLine(m_center, leftEndPoint);
+
+    // Draw right boundary (+20°)
+    float rightAngle = m_fovAngle;
+    float rightRadians = qDegreesToRadians(90.0f - rightAngle);
+    QPointF rightEndPoint(
+        m_center.x() + m_plotRadius * std::cos(rightRadians),
+        m_center.y() - m_plotRadius * std::sin(rightRadians)
+    );
+    painter.drawLine(m_center, rightEndPoint);
+
+    // Draw FoV arc at the perimeter
+    QRectF ellipseRect(m_center.x() - m_plotRadius, m_center.y() - m_plotRadius,
+                       2 * m_plotRadius, 2 * m_plotRadius);
+    int startAngleQt = static_cast<int>((90.0f - rightAngle) * 16);
+    int spanAngleQt = static_cast<int>((rightAngle - leftAngle) * 16);
+    painter.drawArc(ellipseRect, startAngleQt, spanAngleQt);
+
+    painter.restore();
+}
+
+void PPIWidget::drawRangeRings(QPainter& painter)
+{
+    painter.setPen(QPen(QColor(90, 159, 212, 150), 1)); // Blue theme grid color
+
+    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
+        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
+        QRectF ellipseRect(m_center.x() - radius, m_center.y() - radius,
+                           2 * radius, 2 * radius);
+        painter.drawChord(ellipseRect, 0, 180 * 16);
+    }
+}
+
+void PPIWidget::drawAzimuthLines(QPainter& painter)
+{
+    painter.setPen(QPen(QColor(90, 159, 212, 150), 1)); // Blue theme grid color
+
+    for (int i = 0; i < NUM_AZIMUTH_LINES; ++i) {
+        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
+        float radians = qDegreesToRadians(90.0f - azimuth);
+
+        QPointF endPoint(
+            m_center.x() + m_plotRadius * std::cos(radians),
+            m_center.y() - m_plotRadius * std::sin(radians)
+        );
+
+        // Draw different styles for lines within and outside FoV
+        if (azimuth >= -m_fovAngle && azimuth <= m_fovAngle) {
+            // Lines within FoV - slightly brighter
+            painter.setPen(QPen(QColor(120, 179, 232, 200), 1));
+        } else {
+            // Lines outside FoV - dimmer
+            painter.setPen(QPen(QColor(90, 159, 212, 100), 1));
+        }
+
+        painter.drawLine(m_center, endPoint);
+    }
+}
+
+void PPIWidget::accumulatePersistence()
+{
+    if (m_persistence.isEmpty() || m_plotRadius <= 0) return;
+
+    m_persistence.decay(m_persistenceDecay);
+    ensureScreenPositions();
+
+    const float* ranges = m_trackArrays.radius.data();
+    const float* azimuths = m_trackArrays.azimuth.data();
+    for (size_t i = 0; i < m_trackArrays.size(); ++i) {
+        if (azimuths[i] < MIN_AZIMUTH || azimuths[i] > MAX_AZIMUTH || ranges[i] > m_maxRange) {
+            continue;
+        }
+
+        m_persistence.splat(m_screenX[i], m_screenY[i], 255, PERSISTENCE_SPLAT_RADIUS);
+    }
+}
+
+PolarScreenMapping PPIWidget::screenMapping() const
+{
+    return PolarScreenMapping{float(m_center.x()), float(m_center.y()), m_plotRadius / m_maxRange};
+}
+
+void PPIWidget::ensureScreenPositions()
+{
+    if (m_screenPositionsValid) return;
+
+    const size_t count = m_trackArrays.size();
+    m_screenX.resize(count);
+    m_screenY.resize(count);
+    polarToScreen(m_trackArrays.radius.data(), m_trackArrays.azimuth.data(), count,
+                  screenMapping(), m_screenX.data(), m_screenY.data());
+    m_screenPositionsValid = true;
+}
+
+bool PPIWidget::ensureHitIndex()
+{
+    // The drawn set is stale until the next paint after a data/geometry change
+    if (m_visibleGeneration != m_screenGeneration) return false;
+    if (m_hitGeneration == m_visibleGeneration) return true;
+
+    const size_t count = m_visibleTargets.size();
+    m_hitX.resize(count);
+    m_hitY.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        m_hitX[k] = m_screenX[m_visibleTargets[k]];
+        m_hitY[k] = m_screenY[m_visibleTargets[k]];
+    }
+    m_hitGrid.build(m_hitX.data(), m_hitY.data(), count, float(2 * HIT_RADIUS));
+    m_hitGeneration = m_visibleGeneration;
+    return true;
+}
+
+int PPIWidget::targetAt(const QPointF& pos, float radius)
+{
+    if (!ensureHitIndex()) return -1;
+
+    const float x = float(pos.x());
+    const float y = float(pos.y());
+    float bestDistance = radius * radius;
+    int best = -1;
+    m_hitGrid.forEachInRadius(x, y, radius, [&](size_t k) {
+        const float dx = m_hitX[k] - x;
+        const float dy = m_hitY[k] - y;
+        const float distance = dx * dx + dy * dy;
+        if (distance <= bestDistance) {
+            bestDistance = distance;
+            best = int(m_visibleTargets[k]);
+        }
+    });
+    return best;
+}
+
+void PPIWidget::targetsIn(const QRectF& rect, QVector<uint32_t>& targetIds)
+{
+    targetIds.clear();
+    if (!ensureHitIndex()) return;
+
+    const float left = float(rect.left());
+    const float top = float(rect.top());
+    const float right = float(rect.right());
+    const float bottom = float(rect.bottom());
+    m_hitGrid.forEachInBox(left, top, right, bottom, [&](size_t k) {
+        if (m_hitX[k] >= left && m_hitX[k] <= right && m_hitY[k] >= top && m_hitY[k] <= bottom) {
+            targetIds.append(m_trackArrays.target_id[m_visibleTargets[k]]);
+        }
+    });
+}
+
+QString PPIWidget::targetToolTip(int index) const
+{
+    return QString("Target %1\nRange: %2 m\nAzimuth: %3°\nRadial speed: %4 m/s\nLevel: %5 dB")
+        .arg(m_trackArrays.target_id[index])
+        .arg(m_trackArrays.radius[index], 0, 'f', 1)
+        .arg(m_trackArrays.azimuth[index], 0, 'f', 1)
+        .arg(m_trackArrays.radial_speed[index], 0, 'f', 1)
+        .arg(m_trackArrays.level[index], 0, 'f', 1);
+}
+
+void PPIWidget::drawZones(QPainter& painter)
+{
+    const bool haveZones = m_zoneEngine && !m_zoneEngine->zones().empty();
+    if ((!haveZones && m_zoneDraft.empty()) || m_plotRadius <= 0) return;
+
+    painter.save();
+    painter.setFont(QFont("Arial", 8));
+
+    if (haveZones) {
+        const std::vector<ZoneEngine::Zone>& zones = m_zoneEngine->zones();
+        for (size_t z = 0; z < zones.size(); ++z) {
+            const ZoneEngine::Zone& zone = zones[z];
+            m_zonePolygon.clear();
+            for (const ZoneVertex& v : zone.vertices) {
+                m_zonePolygon.append(groundToScreen(v.x, v.y));
+            }
+
+            // Occupied zones are filled red, idle ones only tinted
+            const bool occupied = m_zoneEngine->isZoneOccupied(z);
+            QColor edge = occupied ? QColor(255, 80, 80) : QColor(255, 200, 0);
+            QColor fill = edge;
+            fill.setAlpha(occupied ? 90 : 30);
+            painter.setPen(QPen(edge, 1.5));
+            painter.setBrush(fill);
+            painter.drawPolygon(m_zonePolygon);
+            painter.drawText(m_zonePolygon.first() + QPointF(4, -4), QString::fromStdString(zone.name));
+        }
+    }
+
+    // Polygon being drawn, with a rubber edge to the cursor
+    if (!m_zoneDraft.empty()) {
+        m_zonePolygon.clear();
+        for (const ZoneVertex& v : m_zoneDraft) {
+            m_zonePolygon.append(groundToScreen(v.x, v.y));
+        }
+        m_zonePolygon.append(m_zoneCursor);
+        painter.setPen(QPen(QColor(255, 200, 0), 1.5, Qt::DashLine));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(m_zonePolygon);
+    }
+
+    painter.restore();
+}
+
+void PPIWidget::drawPersistence(QPainter& painter)
+{
+    if (!m_persistenceEnabled || m_persistence.isEmpty()) return;
+
+    // Wraps the accumulation buffer without copying it
+    QImage glow(m_persistence.data(), m_persistence.width(), m_persistence.height(),
+                m_persistence.bytesPerLine(), QImage::Format_Indexed8);
+    glow.setColorTable(m_persistenceColors);
+
+    painter.drawImage(QPointF(0, 0), glow);
+}
+
+void PPIWidget::drawTrails(QPainter& painter)
+{
+    if (!m_trailsEnabled || m_plotRadius <= 0) return;
+
+    // All trails go out in a single drawLines call
+    m_trailSegments.clear();
+    m_trackHistory.collectSegments(m_trailSegments, [this](float range, float azimuth) {
+        return polarToCartesian(range, azimuth);
+    });
+    if (m_trailSegments.isEmpty()) return;
+
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(QPen(QColor(179, 217, 255, 140), 1));
+    painter.drawLines(m_trailSegments);
+    painter.restore();
+}
+
+void PPIWidget::drawTargets(QPainter& painter)
+{
+    for (auto& batch : m_spriteBatches) {
+        batch.clear();
+    }
+    m_labelCandidates.clear();
+    m_visibleTargets.clear();
+
+    m_coastBatch.clear();
+    m_selectionBatch.clear();
+
+    const size_t count = m_trackArrays.size();
+    if (count == 0 || m_plotRadius <= 0) return;
+
+    ensureTargetSprites();
+
+    // Reported positions, or dead-reckoned ones advanced to this paint.
+    // Either way all screen positions are converted in one batch up front.
+    const bool interpolate = m_interpolationEnabled && m_extrapolator.size() == count;
+    const float* ranges = m_trackArrays.radius.data();
+    const float* azimuths = m_trackArrays.azimuth.data();
+    const uint8_t* coasting = nullptr;
+    if (interpolate) {
+        m_extrapolator.extrapolate(m_clock.elapsed() / 1000.0);
+        ranges = m_extrapolator.ranges();
+        azimuths = m_extrapolator.azimuths();
+        coasting = m_extrapolator.coasting();
+
+        m_screenX.resize(count);
+        m_screenY.resize(count);
+        polarToScreen(ranges, azimuths, count, screenMapping(), m_screenX.data(), m_screenY.data());
+        m_screenPositionsValid = false;  // Now holds extrapolated, not reported, positions
+        ++m_screenGeneration;
+    } else {
+        ensureScreenPositions();
+    }
+    const float* screenX = m_screenX.data();
+    const float* screenY = m_screenY.data();
+    const float* radialSpeeds = m_trackArrays.radial_speed.data();
+    const uint32_t* targetIds = m_trackArrays.target_id.data();
+    const bool haveSelection = !m_selectedIds.isEmpty();
+
+    // Culling bounds are fixed for the whole frame
+    const float maxRange = m_maxRange;
+    const float fovAngle = m_fovAngle;
+    const qreal spriteScale = 1.0 / m_spriteDpr;
+    const QRectF spriteSource(0, 0, m_targetSprites[0].width(), m_targetSprites[0].height());
+
+    // Bucket visible targets by sprite so each bucket is drawn in one call
+    for (size_t i = 0; i < count; ++i) {
+        const float range = ranges[i];
+        const float azimuth = azimuths[i];
+
+        if (azimuth < MIN_AZIMUTH || azimuth > MAX_AZIMUTH || range > maxRange) {
+            continue;
+        }
+
+        QPointF targetPos(screenX[i], screenY[i]);
+        bool inFoV = (azimuth >= -fovAngle && azimuth <= fovAngle);
+
+        int sprite = getTargetColorBucket(radialSpeeds[i]) * 2 + (inFoV ? 1 : 0);
+        QPainter::PixmapFragment fragment =
+            QPainter::PixmapFragment::create(targetPos, spriteSource, spriteScale, spriteScale);
+        m_spriteBatches[sprite].append(fragment);
+        if (coasting && coasting[i]) {
+            m_coastBatch.append(fragment);
+        }
+        if (haveSelection && m_selectedIds.contains(targetIds[i])) {
+            m_selectionBatch.append(fragment);
+        }
+        m_labelCandidates.append({targetPos, targetIds[i], inFoV});
+        m_visibleTargets.push_back(uint32_t(i));
+    }
+    m_visibleGeneration = m_screenGeneration;
+
+    // Sprites are already antialiased, so blit them without per-pixel filtering
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    for (int sprite = 0; sprite < m_spriteBatches.size(); ++sprite) {
+        const auto& batch = m_spriteBatches[sprite];
+        if (!batch.isEmpty()) {
+            painter.drawPixmapFragments(batch.constData(), batch.size(), m_targetSprites[sprite]);
+        }
+    }
+
+    // Flag targets whose report is older than the extrapolation cap
+    if (!m_coastBatch.isEmpty()) {
+        painter.drawPixmapFragments(m_coastBatch.constData(), m_coastBatch.size(), m_coastSprite);
+    }
+    if (!m_selectionBatch.isEmpty()) {
+        painter.drawPixmapFragments(m_selectionBatch.constData(), m_selectionBatch.size(), m_selectionSprite);
+    }
+    painter.restore();
+
+    drawTargetLabels(painter);
+}
+
+void PPIWidget::drawTargetLabels(QPainter& painter)
+{
+    if (m_labelCandidates.isEmpty()) return;
+
+    // Reset the overlap grid; a label is only drawn if its cells are still free
+    m_labelGridColumns = width() / LABEL_CELL_SIZE + 1;
+    m_labelGridRows = height() / LABEL_CELL_SIZE + 1;
+    m_labelOccupancy.assign(size_t(m_labelGridColumns) * m_labelGridRows, 0);
+
+    // Drop cached labels once the ID set has churned well past the visible count
+    int cacheLimit = std::max(MAX_CACHED_LABELS, 2 * int(m_labelCandidates.size()));
+    if (m_labelCacheFoV.size() > cacheLimit) m_labelCacheFoV.clear();
+    if (m_labelCacheOutside.size() > cacheLimit) m_labelCacheOutside.clear();
+
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(QPen(Qt::white, 1));
+
+    // FoV labels first so they win any overlap with dimmed targets
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool inFoV = (pass == 0);
+        const QFont& font = inFoV ? m_labelFontFoV : m_labelFontOutside;
+        QHash<uint32_t, QStaticText>& cache = inFoV ? m_labelCacheFoV : m_labelCacheOutside;
+        const float targetSize = inFoV ? 6.0f : 4.0f;
+        const qreal ascent = QFontMetricsF(font).ascent();
+
+        painter.setFont(font);
+
+        for (const LabelCandidate& candidate : m_labelCandidates) {
+            if (candidate.inFoV != inFoV) continue;
+
+            auto it = cache.find(candidate.targetId);
+            if (it == cache.end()) {
+                QStaticText text(QString::number(candidate.targetId));
+                text.setTextFormat(Qt::PlainText);
+                text.setPerformanceHint(QStaticText::AggressiveCaching);
+                text.prepare(QTransform(), font);
+                it = cache.insert(candidate.targetId, text);
+            }
+
+            // Same placement as a drawText baseline just above the marker
+            QPointF topLeft(candidate.pos.x(), candidate.pos.y() - targetSize - 5 - ascent);
+            if (!reserveLabelRect(QRectF(topLeft, it->size()))) continue;
+
+            painter.drawStaticText(topLeft, *it);
+        }
+    }
+
+    painter.restore();
+}
+
+bool PPIWidget::reserveLabelRect(const QRectF& rect)
+{
+    int left = static_cast<int>(std::floor(rect.left())) / LABEL_CELL_SIZE;
+    int top = static_cast<int>(std::floor(rect.top())) / LABEL_CELL_SIZE;
+    int right = static_cast<int>(std::floor(rect.right())) / LABEL_CELL_SIZE;
+    int bottom = static_cast<int>(std::floor(rect.bottom())) / LABEL_CELL_SIZE;
+
+    if (rect.left() < 0 || rect.top() < 0 || right >= m_labelGridColumns || bottom >= m_labelGridRows) {
+        return false;
+    }
+
+    for (int row = top; row <= bottom; ++row) {
+        const uint8_t* cells = &m_labelOccupancy[size_t(row) * m_labelGridColumns];
+        for (int col = left; col <= right; ++col) {
+            if (cells[col]) return false;
+        }
+    }
+
+    for (int row = top; row <= bottom; ++row) {
+        uint8_t* cells = &m_labelOccupancy[size_t(row) * m_labelGridColumns];
+        std::fill(cells + left, cells + right + 1, uint8_t(1));
+    }
+    return true;
+}
+
+void PPIWidget::ensureTargetSprites()
+{
+    const qreal dpr = devicePixelRatioF();
+    if (!m_targetSprites.isEmpty() && qFuzzyCompare(m_spriteDpr, dpr)) return;
+
+    m_spriteDpr = dpr;
+    m_targetSprites.clear();
+    m_targetSprites.reserve(COLOR_BUCKETS * 2);
+
+    const int pixelSize = qCeil(SPRITE_SIZE * dpr);
+    const QPointF center(SPRITE_SIZE / 2.0, SPRITE_SIZE / 2.0);
+
+    for (int bucket = 0; bucket < COLOR_BUCKETS; ++bucket) {
+        QColor targetColor = bucketColor(bucket);
+
+        for (int fov = 0; fov < 2; ++fov) {
+            QPixmap sprite(pixelSize, pixelSize);
+            sprite.fill(Qt::transparent);
+
+            QPainter spritePainter(&sprite);
+            spritePainter.setRenderHint(QPainter::Antialiasing);
+            spritePainter.scale(dpr, dpr);
+
+            if (fov) {
+                // Targets within FoV - brighter border
+                spritePainter.setBrush(targetColor);
+                spritePainter.setPen(QPen(targetColor.lighter(), 3));
+                spritePainter.drawEllipse(center, 6.0, 6.0);
+            } else {
+                // Targets outside FoV - dimmer appearance
+                QColor dimmedColor = targetColor;
+                dimmedColor.setAlpha(100);
+                spritePainter.setBrush(dimmedColor);
+                spritePainter.setPen(QPen(dimmedColor.lighter(), 2));
+                spritePainter.drawEllipse(center, 4.0, 4.0);
+            }
+            spritePainter.end();
+
+            m_targetSprites.append(sprite);
+        }
+    }
+
+    // Dashed ring marking a coasting (stale, extrapolation-capped) target
+    m_coastSprite = QPixmap(pixelSize, pixelSize);
+    m_coastSprite.fill(Qt::transparent);
+    QPainter coastPainter(&m_coastSprite);
+    coastPainter.setRenderHint(QPainter::Antialiasing);
+    coastPainter.scale(dpr, dpr);
+    coastPainter.setBrush(Qt::NoBrush);
+    coastPainter.setPen(QPen(QColor(255, 200, 0), 1.5, Qt::DashLine));
+    coastPainter.drawEllipse(center, 8.0, 8.0);
+    coastPainter.end();
+
+    // Solid ring marking a selected target
+    m_selectionSprite = QPixmap(pixelSize, pixelSize);
+    m_selectionSprite.fill(Qt::transparent);
+    QPainter selectionPainter(&m_selectionSprite);
+    selectionPainter.setRenderHint(QPainter::Antialiasing);
+    selectionPainter.scale(dpr, dpr);
+    selectionPainter.setBrush(Qt::NoBrush);
+    selectionPainter.setPen(QPen(Qt::white, 2));
+    selectionPainter.drawEllipse(center, 7.5, 7.5);
+}
+
+void PPIWidget::drawLabels(QPainter& painter)
+{
+    painter.setPen(QPen(QColor(179, 217, 255), 1)); // Blue theme text color
+    painter.setFont(QFont("Arial", 10));
+
+    // Range labels
+    for (int i = 1; i <= NUM_RANGE_RINGS; ++i) {
+        float range = (float(i) / NUM_RANGE_RINGS) * m_maxRange;
+        float radius = (float(i) / NUM_RANGE_RINGS) * m_plotRadius;
+
+        QPointF labelPos(m_center.x() + radius * 0.707f, m_center.y() - radius * 0.707f);
+        QString rangeText = QString("%1").arg(range, 0, 'f', 1) + "m";
+        painter.drawText(labelPos, rangeText);
+    }
+
+    // Azimuth labels
+    QFont azFont("Arial", 12, QFont::Bold);
+    painter.setFont(azFont);
+    painter.setPen(QPen(QColor(179, 217, 255), 1));
+
+    for (int i = 0; i < NUM_AZIMUTH_LINES; i += 2) {
+        float azimuth = MIN_AZIMUTH + (float(i) / (NUM_AZIMUTH_LINES - 1)) * (MAX_AZIMUTH - MIN_AZIMUTH);
+        float radians = qDegreesToRadians(90.0f - azimuth);
+
+        QPointF labelPos(
+            m_center.x() + (m_plotRadius + 20) * std::cos(radians),
+            m_center.y() - (m_plotRadius + 20) * std::sin(radians)
+        );
+
+        QString azText = QString("%1°").arg(azimuth, 0, 'f', 0);
+        QFontMetrics fm(azFont);
+        QRect textRect = fm.boundingRect(azText);
+        labelPos -= QPointF(textRect.width() / 2, -textRect.height() / 2);
+
+        // Highlight FoV boundary labels
+        if (azimuth == -m_fovAngle || azimuth == m_fovAngle) {
+            painter.setPen(QPen(QColor(0, 255, 0), 1)); // Green for FoV boundaries
+        } else {
+            painter.setPen(QPen(QColor(179, 217, 255), 1)); // Normal blue
+        }
+
+        painter.drawText(labelPos, azText);
+    }
+
+    // Title and FoV indicator
+    painter.setFont(QFont("Arial", 14, QFont::Bold));
+    painter.setPen(QPen(QColor(135, 206, 235), 1)); // Sky blue for title
+    painter.drawText(QPointF(10, 25), "PPI Display - Target Tracks");
+
+    // FoV information
+    painter.setFont(QFont("Arial", 10));
+    painter.setPen(QPen(QColor(0, 255, 0), 1)); // Green for FoV info
+    QString fovText = QString("FoV: ±%1°").arg(m_fovAngle, 0, 'f', 0);
+    painter.drawText(QPointF(10, 45), fovText);
+
+    // Legend
+    painter.setFont(QFont("Arial", 8));
+    painter.setPen(QPen(QColor(179, 217, 255), 1));
+    painter.drawText(QPointF(10, height() - 30), "Green area: Active Field of View");
+    painter.drawText(QPointF(10, height() - 15), "Bright targets: Within FoV, Dim targets: Outside FoV");
+}
+
+QColor PPIWidget::getTargetColor(float radialSpeed) const
+{
+    // Enhanced color coding based on radial speed
+    if (std::abs(radialSpeed) < 1.0f) {
+        return QColor(0, 255, 0); // Green for stationary
+    } else if (radialSpeed > 0) {
+        // Approaching - red (intensity based on speed)
+        int intensity = std::min(255, static_cast<int>(100 + std::abs(radialSpeed) * 15));
+        return QColor(intensity, 50, 50);
+    } else {
+        // Receding - blue (intensity based on speed)
+        int intensity = std::min(255, static_cast<int>(100 + std::abs(radialSpeed) * 15));
+        return QColor(50, 50, intensity);
+    }
+}
+
+int PPIWidget::getTargetColorBucket(float radialSpeed) const
+{
+    // Quantize the getTargetColor() intensity ramp:
+    // 0 = stationary, 1..N = approaching, N+1..2N = receding
+    float speed = std::abs(radialSpeed);
+    if (speed < 1.0f) {
+        return 0;
+    }
+
+    int intensity = std::min(255, static_cast<int>(100 + speed * 15));
+    int level = std::min(SPEED_BUCKETS - 1, (intensity - 100) * SPEED_BUCKETS / 156);
+    return (radialSpeed > 0 ? 1 : 1 + SPEED_BUCKETS) + level;
+}
+
+QColor PPIWidget::bucketColor(int bucket) const
+{
+    if (bucket == 0) {
+        return getTargetColor(0.0f);
+    }
+
+    // Representative speed at the middle of the bucket's intensity band
+    bool approaching = bucket <= SPEED_BUCKETS;
+    int level = approaching ? bucket - 1 : bucket - 1 - SPEED_BUCKETS;
+    float intensity = 100.0f + (level + 0.5f) * 156.0f / SPEED_BUCKETS;
+    float speed = std::max(1.0f, (intensity - 100.0f) / 15.0f);
+    return getTargetColor(approaching ? speed : -speed);
+}
+
+QPointF PPIWidget::polarToCartesian(float range, float azimuth) const
+{
+    // Normalize range to plot radius
+    float normalizedRange = (range / m_maxRange) * m_plotRadius;
+
+    // Convert azimuth to radians (0° is up/north, positive is clockwise)
+    float radians = qDegreesToRadians(90.0f - azimuth);
+
+    return QPointF(
+        m_center.x() + normalizedRange * std::cos(radians),
+        m_center.y() - normalizedRange * std::sin(radians)
+    );
+}
+
+QPointF PPIWidget::groundToScreen(float x, float y) const
+{
+    const float pixelsPerMeter = m_plotRadius / m_maxRange;
+    return QPointF(m_center.x() + x * pixelsPerMeter, m_center.y() - y * pixelsPerMeter);
+}
+
+ZoneVertex PPIWidget::screenToGround(const QPointF& pos) const
+{
+    const float metersPerPixel = m_maxRange / m_plotRadius;
+    return ZoneVertex{float(pos.x() - m_center.x()) * metersPerPixel,
+                      float(m_center.y() - pos.y()) * metersPerPixel};
+}
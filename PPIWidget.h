@@ -1,60 +1,224 @@
-#pragma once
-
-#include <QWidget>
-#include <QPainter>
-#include <QTimer>
-#include <vector>
-#include "DataStructures.h"
-
-class PPIWidget : public QWidget
-{
-    Q_OBJECT
-
-public:
-    explicit PPIWidget(QWidget *parent = nullptr);
-
-    void updateTargets(const TargetTrackData& trackData);
-    void setMaxRange(float range);
-    void setFoVAngle(float angle);  // NEW: Set Field of View angle
-
-    float getMaxRange() const { return m_maxRange; }
-    float getFoVAngle() const { return m_fovAngle; }  // NEW: Get FoV angle
-
-protected:
-    void paintEvent(QPaintEvent *event) override;
-    void resizeEvent(QResizeEvent *event) override;
-
-private:
-    // Drawing functions
-    void drawBackground(QPainter& painter);
-    void drawFoVHighlight(QPainter& painter);   // NEW: Draw FoV sector highlight
-    void drawFoVBoundaries(QPainter& painter);  // NEW: Draw FoV boundary lines
-    void drawRangeRings(QPainter& painter);
-    void drawAzimuthLines(QPainter& painter);
-    void drawTargets(QPainter& painter);
-    void drawLabels(QPainter& painter);
-
-    // Utility functions
-    QColor getTargetColor(float radialSpeed) const;
-    QPointF polarToCartesian(float range, float azimuth) const;
-
-    // Data members
-    TargetTrackData m_currentTargets;
-
-    // Display parameters
-    float m_maxRange;           // Maximum range to display (meters)
-    float m_fovAngle;           // NEW: Field of View half-angle (e.g., 20° for ±20°)
-    float m_plotRadius;         // Radius of the plot area in pixels
-    QPointF m_center;           // Center point of the plot
-    QRect m_plotRect;           // Bounding rectangle of the plot
-
-    // Constants for radar display
-    static const int NUM_RANGE_RINGS = 5;      // Number of concentric range rings
-    static const int NUM_AZIMUTH_LINES = 19;   // Number of radial azimuth lines
-
-    // Coordinate system constants
-    static constexpr float MIN_AZIMUTH = -90.0f;    // Minimum azimuth angle
-    static constexpr float MAX_AZIMUTH = 90.0f;     // Maximum azimuth angle
-};
-
-
+#pragma once
+
+#include <QWidget>
+#include <QPainter>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QRubberBand>
+#include <QSet>
+#include <QStaticText>
+#include <QVector>
+#include <vector>
+#include "DataStructures.h"
+#include "PersistenceBuffer.h"
+#include "TrackHistory.h"
+#include "TrackExtrapolator.h"
+#include "TrackArrays.h"
+#include "SpatialHashGrid.h"
+#include "ZoneEngine.h"
+
+class PPIWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PPIWidget(QWidget *parent = nullptr);
+
+    void updateTargets(const TrackSnapshotPtr& trackData);
+    void setMaxRange(float range);
+    void setFoVAngle(float angle);  // NEW: Set Field of View angle
+
+    // Afterglow: fading history of target positions drawn under live targets
+    void setPersistenceEnabled(bool enabled);
+    void setPersistenceDecay(float factor);  // Per-frame intensity multiplier (0..1)
+    bool isPersistenceEnabled() const { return m_persistenceEnabled; }
+
+    // Motion trails from per-track position history
+    void setTrailsEnabled(bool enabled);
+    void setTrailLength(int points);
+    void setTrailMemoryLimit(size_t bytes);
+    bool isTrailsEnabled() const { return m_trailsEnabled; }
+
+    // Dead-reckoning between sensor updates: repaint at display rate and
+    // advance each target from its last report using its rates
+    void setInterpolationEnabled(bool enabled);
+    void setMaxExtrapolation(double seconds);
+    bool isInterpolationEnabled() const { return m_interpolationEnabled; }
+
+    // Selected targets by ID; highlighted on the plot
+    void setSelectedTargets(const QVector<uint32_t>& targetIds);
+    QVector<uint32_t> selectedTargets() const;
+
+    // Geofence overlay: zones are drawn from the engine (occupied ones filled
+    // red). In drawing mode left clicks add vertices; double-click or right
+    // click closes the polygon and Escape discards it.
+    void setZoneEngine(const ZoneEngine* zones);
+    void setZoneDrawingEnabled(bool enabled);
+    bool isZoneDrawingEnabled() const { return m_zoneDrawing; }
+
+    // Hit testing against the targets as last drawn (widget coordinates).
+    // targetAt() returns an index into the current snapshot, or -1.
+    int targetAt(const QPointF& pos, float radius);
+    void targetsIn(const QRectF& rect, QVector<uint32_t>& targetIds);
+
+    float getMaxRange() const { return m_maxRange; }
+    float getFoVAngle() const { return m_fovAngle; }  // NEW: Get FoV angle
+
+signals:
+    // Click or rubber-band selection by the user
+    void selectionChanged(const QVector<uint32_t>& targetIds);
+    // A polygon finished in zone drawing mode, in metres
+    void zoneDrawn(const std::vector<ZoneVertex>& vertices);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+
+private:
+    // Drawing functions
+    void drawBackground(QPainter& painter);
+    void drawFoVHighlight(QPainter& painter);   // NEW: Draw FoV sector highlight
+    void drawFoVBoundaries(QPainter& painter);  // NEW: Draw FoV boundary lines
+    void drawRangeRings(QPainter& painter);
+    void drawAzimuthLines(QPainter& painter);
+    void drawZones(QPainter& painter);
+    void drawPersistence(QPainter& painter);
+    void drawTrails(QPainter& painter);
+    void drawTargets(QPainter& painter);
+    void drawTargetLabels(QPainter& painter);
+    void drawLabels(QPainter& painter);
+
+    // Afterglow accumulation
+    void accumulatePersistence();
+
+    // Batch polar-to-screen conversion of the reported positions
+    PolarScreenMapping screenMapping() const;
+    void ensureScreenPositions();
+
+    // Grid over the drawn targets' screen positions, rebuilt on first query
+    // after they move
+    bool ensureHitIndex();
+    QString targetToolTip(int index) const;
+
+    // Target sprite batching
+    void ensureTargetSprites();
+    bool reserveLabelRect(const QRectF& rect);
+
+    // Utility functions
+    QColor getTargetColor(float radialSpeed) const;
+    int getTargetColorBucket(float radialSpeed) const;
+    QColor bucketColor(int bucket) const;
+    QPointF polarToCartesian(float range, float azimuth) const;
+    QPointF groundToScreen(float x, float y) const;      // Metres to widget coordinates
+    ZoneVertex screenToGround(const QPointF& pos) const;
+    void finishZoneDraft();
+
+    // Data members
+    TrackSnapshotPtr m_currentTargets;
+    TrackArrays m_trackArrays;          // Column copy of m_currentTargets
+
+    // Screen positions of m_trackArrays (or of the extrapolated positions
+    // while interpolating); rebuilt only when the data or geometry changes
+    AlignedVector<float> m_screenX;
+    AlignedVector<float> m_screenY;
+    bool m_screenPositionsValid;
+    uint64_t m_screenGeneration;    // Bumped whenever the screen positions change
+
+    // Hit-test index: the targets drawn by the last paint and a grid over them
+    std::vector<uint32_t> m_visibleTargets;  // Indices into m_trackArrays
+    uint64_t m_visibleGeneration;
+    std::vector<float> m_hitX;
+    std::vector<float> m_hitY;
+    SpatialHashGrid m_hitGrid;
+    uint64_t m_hitGeneration;
+
+    // Selection and mouse interaction
+    QSet<uint32_t> m_selectedIds;
+    QVector<QPainter::PixmapFragment> m_selectionBatch;
+    QPixmap m_selectionSprite;
+    QRubberBand* m_rubberBand;
+    QPoint m_pressPos;
+    bool m_pressed;
+    int m_hoverIndex;
+
+    // Geofence overlay and zone drawing
+    const ZoneEngine* m_zoneEngine;
+    std::vector<ZoneVertex> m_zoneDraft;
+    QPolygonF m_zonePolygon;            // Scratch for drawing
+    QPointF m_zoneCursor;
+    bool m_zoneDrawing;
+
+    // Display parameters
+    float m_maxRange;           // Maximum range to display (meters)
+    float m_fovAngle;           // NEW: Field of View half-angle (e.g., 20° for ±20°)
+    float m_plotRadius;         // Radius of the plot area in pixels
+    QPointF m_center;           // Center point of the plot
+    QRect m_plotRect;           // Bounding rectangle of the plot
+
+    // Batched target rendering: one pre-rendered sprite per (colour bucket, FoV)
+    // drawn with a single drawPixmapFragments call, and cached ID labels
+    struct LabelCandidate {
+        QPointF pos;
+        uint32_t targetId;
+        bool inFoV;
+    };
+    QVector<QPixmap> m_targetSprites;
+    QVector<QVector<QPainter::PixmapFragment>> m_spriteBatches;
+    QVector<LabelCandidate> m_labelCandidates;
+    QHash<uint32_t, QStaticText> m_labelCacheFoV;
+    QHash<uint32_t, QStaticText> m_labelCacheOutside;
+    std::vector<uint8_t> m_labelOccupancy;  // Coarse grid of cells already covered by a label
+    int m_labelGridColumns;
+    int m_labelGridRows;
+    qreal m_spriteDpr;
+    QFont m_labelFontFoV;
+    QFont m_labelFontOutside;
+
+    // Afterglow layer (widget-sized intensity image)
+    PersistenceBuffer m_persistence;
+    QVector<QRgb> m_persistenceColors;
+    bool m_persistenceEnabled;
+    float m_persistenceDecay;
+
+    // Track trails
+    TrackHistory m_trackHistory;
+    QVector<QLineF> m_trailSegments;
+    QElapsedTimer m_clock;
+    bool m_trailsEnabled;
+
+    // Display-rate interpolation
+    TrackExtrapolator m_extrapolator;
+    QTimer* m_frameTimer;
+    QPixmap m_coastSprite;      // Overlay ring for targets past the extrapolation cap
+    QVector<QPainter::PixmapFragment> m_coastBatch;
+    bool m_interpolationEnabled;
+
+    // Constants for radar display
+    static const int NUM_RANGE_RINGS = 5;      // Number of concentric range rings
+    static const int NUM_AZIMUTH_LINES = 19;   // Number of radial azimuth lines
+
+    // Coordinate system constants
+    static constexpr float MIN_AZIMUTH = -90.0f;    // Minimum azimuth angle
+    static constexpr float MAX_AZIMUTH = 90.0f;     // Maximum azimuth angle
+
+    // Target rendering constants
+    static const int SPEED_BUCKETS = 8;             // Colour levels per direction (approaching/receding)
+    static const int COLOR_BUCKETS = 1 + 2 * SPEED_BUCKETS;  // Stationary + approaching + receding
+    static const int SPRITE_SIZE = 18;              // Sprite side in logical pixels
+    static const int LABEL_CELL_SIZE = 8;           // Label overlap grid cell (pixels)
+    static const int MAX_CACHED_LABELS = 8192;
+    static const int PERSISTENCE_SPLAT_RADIUS = 3;  // Afterglow dot radius (pixels)
+    static const int FRAME_INTERVAL_MS = 16;        // ~60 fps repaint while interpolating
+    static const int HIT_RADIUS = 10;               // Hover/click pick radius (pixels)
+};
+
+
@@ -0,0 +1,645 @@
+#include "PcapReader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const uint32_t PCAP_MAGIC_MICRO = 0xA1B2C3D4;
+const uint32_t PCAP_MAGIC_NANO = 0xA1B23C4D;
+const uint32_t PCAPNG_SECTION_HEADER = 0x0A0D0D0A;
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+// pcapng block types
+const uint32_t BLOCK_INTERFACE = 1;
+const uint32_t BLOCK_PACKET = 2;          // Obsolete Packet Block
+const uint32_t BLOCK_SIMPLE_PACKET = 3;
+const uint32_t BLOCK_ENHANCED_PACKET = 6;
+
+// Link types
+const uint16_t LINK_NULL = 0;
+const uint16_t LINK_ETHERNET = 1;
+const uint16_t LINK_RAW_BSD = 12;
+const uint16_t LINK_RAW_OPENBSD = 14;
+const uint16_t LINK_RAW = 101;
+const uint16_t LINK_LOOP = 108;
+const uint16_t LINK_LINUX_SLL = 113;
+const uint16_t LINK_IPV4 = 228;
+const uint16_t LINK_IPV6 = 229;
+const uint16_t LINK_LINUX_SLL2 = 276;
+
+const uint16_t ETHERTYPE_IPV4 = 0x0800;
+const uint16_t ETHERTYPE_IPV6 = 0x86DD;
+const uint8_t PROTOCOL_UDP = 17;
+
+const size_t MAX_BLOCK_SIZE = 16u << 20;  // Larger blocks are skipped, never buffered
+const size_t MAX_REASSEMBLY_SLOTS = 64;
+const size_t MAX_IP_PAYLOAD = 65535;
+const uint64_t REASSEMBLY_TIMEOUT_US = 30000000;
+
+inline uint16_t be16(const uint8_t* p)
+{
+    return uint16_t((p[0] << 8) | p[1]);
+}
+
+inline uint32_t be32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+inline uint32_t swap32(uint32_t v)
+{
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+int seekFile(std::FILE* file, int64_t offset, int whence)
+{
+#ifdef _WIN32
+    return _fseeki64(file, offset, whence);
+#else
+    return fseeko(file, off_t(offset), whence);
+#endif
+}
+
+int64_t tellFile(std::FILE* file)
+{
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return int64_t(ftello(file));
+#endif
+}
+
+} // namespace
+
+PcapReader::PcapReader()
+    : m_file(nullptr)
+    , m_fileSize(0)
+    , m_position(0)
+    , m_port(0)
+    , m_pcapNg(false)
+    , m_swapped(false)
+    , m_nanoseconds(false)
+    , m_linkType(0)
+    , m_lastTimestamp(0)
+    , m_stats()
+{
+}
+
+PcapReader::~PcapReader()
+{
+    close();
+}
+
+bool PcapReader::isCapture(const std::string& path)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    uint32_t magic = 0;
+    const bool read = std::fread(&magic, sizeof(magic), 1, file) == 1;
+    std::fclose(file);
+    return read && (magic == PCAP_MAGIC_MICRO || magic == swap32(PCAP_MAGIC_MICRO)
+                    || magic == PCAP_MAGIC_NANO || magic == swap32(PCAP_MAGIC_NANO)
+                    || magic == PCAPNG_SECTION_HEADER);
+}
+
+bool PcapReader::open(const std::string& path, std::string* error)
+{
+    close();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) {
+        if (error) *error = "Cannot open " + path;
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, 1u << 20);  // Large sequential reads
+    seekFile(m_file, 0, SEEK_END);
+    m_fileSize = uint64_t(std::max<int64_t>(tellFile(m_file), 0));
+    seekFile(m_file, 0, SEEK_SET);
+    m_path = path;
+    m_position = 0;
+    m_stats = Stats();
+    m_interfaces.clear();
+    m_lastTimestamp = 0;
+    for (Reassembly& slot : m_reassembly) {
+        slot.used = false;
+    }
+
+    uint32_t magic;
+    if (!readBytes(&magic, sizeof(magic))) {
+        close();
+        if (error) *error = path + " is empty";
+        return false;
+    }
+
+    if (magic == PCAPNG_SECTION_HEADER) {
+        m_pcapNg = true;
+        uint32_t blockLength;
+        if (!readBytes(&blockLength, sizeof(blockLength)) || !readSectionHeader(blockLength)) {
+            close();
+            if (error) *error = path + " has a damaged pcapng section header";
+            return false;
+        }
+        return true;
+    }
+
+    m_pcapNg = false;
+    if (magic == PCAP_MAGIC_MICRO || magic == PCAP_MAGIC_NANO) {
+        m_swapped = false;
+    } else if (swap32(magic) == PCAP_MAGIC_MICRO || swap32(magic) == PCAP_MAGIC_NANO) {
+        m_swapped = true;
+        magic = swap32(magic);
+    } else {
+        close();
+        if (error) *error = path + " is not a pcap or pcapng capture";
+        return false;
+    }
+    m_nanoseconds = magic == PCAP_MAGIC_NANO;
+
+    // version, thiszone, sigfigs, snaplen, link type
+    uint8_t header[20];
+    if (!readBytes(header, sizeof(header))) {
+        close();
+        if (error) *error = path + " has a truncated pcap header";
+        return false;
+    }
+    m_linkType = uint16_t(read32(header + 16) & 0xFFFF);  // Upper bits carry FCS information
+    return true;
+}
+
+void PcapReader::close()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool PcapReader::rewind()
+{
+    const std::string path = m_path;
+    const uint16_t port = m_port;
+    const bool opened = !path.empty() && open(path);
+    m_port = port;
+    return opened;
+}
+
+uint16_t PcapReader::read16(const uint8_t* p) const
+{
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return m_swapped ? uint16_t((value >> 8) | (value << 8)) : value;
+}
+
+uint32_t PcapReader::read32(const uint8_t* p) const
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return m_swapped ? swap32(value) : value;
+}
+
+bool PcapReader::readBytes(void* out, size_t size)
+{
+    if (std::fread(out, 1, size, m_file) != size) return false;
+    m_position += size;
+    return true;
+}
+
+bool PcapReader::skipBytes(uint64_t size)
+{
+    if (seekFile(m_file, int64_t(size), SEEK_CUR) != 0) return false;
+    m_position += size;
+    return true;
+}
+
+bool PcapReader::next(Datagram& datagram)
+{
+    if (!m_file) return false;
+
+    for (;;) {
+        uint64_t timestamp;
+        const uint8_t* data;
+        size_t size;
+        uint16_t linkType;
+        const bool read = m_pcapNg ? readPcapNgPacket(timestamp, data, size, linkType)
+                                   : readPcapPacket(timestamp, data, size, linkType);
+        if (!read) return false;
+
+        ++m_stats.packets;
+        if (parseLinkLayer(linkType, data, size, timestamp, datagram)) {
+            ++m_stats.datagrams;
+            return true;
+        }
+    }
+}
+
+bool PcapReader::readPcapPacket(uint64_t& timestamp, const uint8_t*& data, size_t& size, uint16_t& linkType)
+{
+    for (;;) {
+        uint8_t header[16];
+        if (!readBytes(header, sizeof(header))) return false;
+
+        const uint64_t seconds = read32(header);
+        const uint64_t fraction = read32(header + 4);
+        const uint32_t captured = read32(header + 8);
+        timestamp = seconds * 1000000 + (m_nanoseconds ? fraction / 1000 : fraction);
+
+        if (captured > MAX_BLOCK_SIZE) {
+            if (!skipBytes(captured)) return false;
+            ++m_stats.skipped;
+            continue;
+        }
+        m_block.resize(captured);
+        if (!readBytes(m_block.data(), captured)) return false;
+
+        data = m_block.data();
+        size = captured;
+        linkType = m_linkType;
+        return true;
+    }
+}
+
+bool PcapReader::readSectionHeader(uint32_t blockLength)
+{
+    // Called after the block type and length; the byte-order magic decides
+    // how the length (and everything in the section) is read
+    uint32_t byteOrder;
+    if (!readBytes(&byteOrder, sizeof(byteOrder))) return false;
+    if (byteOrder == PCAPNG_BYTE_ORDER_MAGIC) {
+        m_swapped = false;
+    } else if (swap32(byteOrder) == PCAPNG_BYTE_ORDER_MAGIC) {
+        m_swapped = true;
+        blockLength = swap32(blockLength);
+    } else {
+        return false;
+    }
+    if (blockLength < 28 || blockLength % 4 != 0 || blockLength > MAX_BLOCK_SIZE) return false;
+
+    m_interfaces.clear();
+    return skipBytes(blockLength - 12);  // Version, section length, options, trailing length
+}
+
+void PcapReader::readInterface(const uint8_t* body, size_t size)
+{
+    Interface interface;
+    interface.linkType = size >= 2 ? read16(body) : 0;
+    interface.binaryResolution = false;
+    interface.resolutionExponent = 6;
+    interface.offsetSeconds = 0;
+
+    // Options: code, length, value padded to 4 bytes
+    size_t offset = 8;
+    while (offset + 4 <= size) {
+        const uint16_t code = read16(body + offset);
+        const uint16_t length = read16(body + offset + 2);
+        offset += 4;
+        if (code == 0 || offset + length > size) break;
+        if (code == 9 && length >= 1) {          // if_tsresol
+            const uint8_t value = body[offset];
+            interface.binaryResolution = (value & 0x80) != 0;
+            interface.resolutionExponent = value & 0x7F;
+        } else if (code == 14 && length >= 8) {  // if_tsoffset
+            const uint64_t low = read32(body + offset);
+            const uint64_t high = read32(body + offset + 4);
+            interface.offsetSeconds = int64_t(m_swapped ? (low << 32) | high : (high << 32) | low);
+        }
+        offset += (length + 3u) & ~3u;
+    }
+    m_interfaces.push_back(interface);
+}
+
+uint64_t PcapReader::toMicroseconds(const Interface& interface, uint64_t units) const
+{
+    uint64_t micro;
+    if (interface.binaryResolution) {
+        unsigned exponent = std::min<unsigned>(interface.resolutionExponent, 63);
+        const uint64_t seconds = units >> exponent;
+        uint64_t fraction = units & ((uint64_t(1) << exponent) - 1);
+        if (exponent > 40) {  // Keep fraction * 10^6 within 64 bits
+            fraction >>= exponent - 40;
+            exponent = 40;
+        }
+        micro = seconds * 1000000 + ((fraction * 1000000) >> exponent);
+    } else {
+        uint64_t scale = 1;
+        const unsigned exponent = interface.resolutionExponent;
+        for (unsigned i = 6; i < exponent && i < 25; ++i) scale *= 10;
+        micro = units / scale;
+        for (unsigned i = exponent; i < 6; ++i) micro *= 10;
+    }
+    return micro + uint64_t(interface.offsetSeconds * 1000000);
+}
+
+bool PcapReader::readPcapNgPacket(uint64_t& timestamp, const uint8_t*& data, size_t& size, uint16_t& linkType)
+{
+    for (;;) {
+        uint32_t blockHeader[2];
+        if (!readBytes(blockHeader, sizeof(blockHeader))) return false;
+
+        if (blockHeader[0] == PCAPNG_SECTION_HEADER) {
+            if (!readSectionHeader(blockHeader[1])) return false;
+            continue;
+        }
+
+        const uint32_t type = m_swapped ? swap32(blockHeader[0]) : blockHeader[0];
+        const uint32_t length = m_swapped ? swap32(blockHeader[1]) : blockHeader[1];
+        if (length < 12 || length % 4 != 0) return false;  // Lost framing: stop
+        const size_t bodySize = length - 12;
+
+        const bool wanted = type == BLOCK_INTERFACE || type == BLOCK_PACKET
+                         || type == BLOCK_SIMPLE_PACKET || type == BLOCK_ENHANCED_PACKET;
+        if (!wanted || bodySize > MAX_BLOCK_SIZE) {
+            if (!skipBytes(bodySize + 4)) return false;
+            if (wanted) ++m_stats.skipped;
+            continue;
+        }
+
+        m_block.resize(bodySize + 4);  // Body and trailing length
+        if (!readBytes(m_block.data(), m_block.size())) return false;
+        const uint8_t* body = m_block.data();
+
+        size_t interfaceId = 0;
+        size_t captured = 0;
+        size_t dataOffset = 0;
+        uint64_t units = 0;
+        switch (type) {
+        case BLOCK_INTERFACE:
+            readInterface(body, bodySize);
+            continue;
+        case BLOCK_ENHANCED_PACKET:
+            if (bodySize < 20) continue;
+            interfaceId = read32(body);
+            units = (uint64_t(read32(body + 4)) << 32) | read32(body + 8);
+            captured = read32(body + 12);
+            dataOffset = 20;
+            break;
+        case BLOCK_PACKET:
+            if (bodySize < 20) continue;
+            interfaceId = read16(body);
+            units = (uint64_t(read32(body + 4)) << 32) | read32(body + 8);
+            captured = read32(body + 12);
+            dataOffset = 20;
+            break;
+        case BLOCK_SIMPLE_PACKET:
+            // No timestamp: keeps the previous packet's
+            if (bodySize < 4) continue;
+            captured = std::min<size_t>(read32(body), bodySize - 4);
+            dataOffset = 4;
+            break;
+        }
+
+        if (interfaceId >= m_interfaces.size() || captured > bodySize - dataOffset) {
+            ++m_stats.skipped;
+            continue;
+        }
+        if (type != BLOCK_SIMPLE_PACKET) {
+            m_lastTimestamp = toMicroseconds(m_interfaces[interfaceId], units);
+        }
+
+        timestamp = m_lastTimestamp;
+        data = body + dataOffset;
+        size = captured;
+        linkType = m_interfaces[interfaceId].linkType;
+        return true;
+    }
+}
+
+bool PcapReader::parseLinkLayer(uint16_t linkType, const uint8_t* data, size_t size,
+                                uint64_t timestamp, Datagram& datagram)
+{
+    uint16_t protocol = 0;
+    size_t offset = 0;
+
+    switch (linkType) {
+    case LINK_NULL:
+    case LINK_LOOP: {
+        // Address family, in either byte order
+        if (size < 4) break;
+        uint32_t family;
+        std::memcpy(&family, data, sizeof(family));
+        const uint32_t swapped = swap32(family);
+        if (family == 2 || swapped == 2) {
+            protocol = ETHERTYPE_IPV4;
+        } else if (family == 24 || family == 28 || family == 30 || swapped == 24 || swapped == 28 || swapped == 30) {
+            protocol = ETHERTYPE_IPV6;
+        }
+        offset = 4;
+        break;
+    }
+    case LINK_ETHERNET:
+        if (size < 14) break;
+        protocol = be16(data + 12);
+        offset = 14;
+        // 802.1Q / 802.1ad tags
+        while ((protocol == 0x8100 || protocol == 0x88A8 || protocol == 0x9100) && size >= offset + 4) {
+            protocol = be16(data + offset + 2);
+            offset += 4;
+        }
+        break;
+    case LINK_LINUX_SLL:
+        if (size < 16) break;
+        protocol = be16(data + 14);
+        offset = 16;
+        break;
+    case LINK_LINUX_SLL2:
+        if (size < 20) break;
+        protocol = be16(data);
+        offset = 20;
+        break;
+    case LINK_RAW:
+    case LINK_RAW_BSD:
+    case LINK_RAW_OPENBSD:
+    case LINK_IPV4:
+    case LINK_IPV6:
+        if (size < 1) break;
+        protocol = (data[0] >> 4) == 4 ? ETHERTYPE_IPV4 : (data[0] >> 4) == 6 ? ETHERTYPE_IPV6 : 0;
+        break;
+    }
+
+    if (protocol == ETHERTYPE_IPV4) return parseIPv4(data + offset, size - offset, timestamp, datagram);
+    if (protocol == ETHERTYPE_IPV6) return parseIPv6(data + offset, size - offset, timestamp, datagram);
+    ++m_stats.skipped;
+    return false;
+}
+
+bool PcapReader::parseIPv4(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram)
+{
+    if (size < 20 || (data[0] >> 4) != 4) {
+        ++m_stats.skipped;
+        return false;
+    }
+    const size_t headerLength = size_t(data[0] & 0x0F) * 4;
+    const size_t totalLength = be16(data + 2);
+    if (headerLength < 20 || totalLength < headerLength) {
+        ++m_stats.skipped;
+        return false;
+    }
+    if (totalLength > size) {
+        ++m_stats.truncated;
+        return false;
+    }
+    if (data[9] != PROTOCOL_UDP) {
+        ++m_stats.skipped;
+        return false;
+    }
+
+    const uint16_t fragment = be16(data + 6);
+    const bool moreFragments = (fragment & 0x2000) != 0;
+    const size_t fragmentOffset = size_t(fragment & 0x1FFF) * 8;
+    const uint8_t* payload = data + headerLength;
+    size_t payloadSize = totalLength - headerLength;
+
+    if (moreFragments || fragmentOffset > 0) {
+        payload = reassemble(4, data + 12, be16(data + 4), fragmentOffset, moreFragments,
+                             payload, payloadSize, timestamp, payloadSize);
+        if (!payload) return false;
+        ++m_stats.reassembled;
+    }
+    return parseUDP(payload, payloadSize, timestamp, datagram);
+}
+
+bool PcapReader::parseIPv6(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram)
+{
+    if (size < 40 || (data[0] >> 4) != 6) {
+        ++m_stats.skipped;
+        return false;
+    }
+    const size_t end = 40 + size_t(be16(data + 4));
+    if (end > size) {
+        ++m_stats.truncated;
+        return false;
+    }
+
+    uint8_t nextHeader = data[6];
+    size_t offset = 40;
+    for (;;) {
+        if (nextHeader == PROTOCOL_UDP) {
+            return parseUDP(data + offset, end - offset, timestamp, datagram);
+        }
+        if ((nextHeader == 0 || nextHeader == 43 || nextHeader == 60) && offset + 2 <= end) {
+            // Hop-by-hop, routing, destination options
+            const size_t length = (size_t(data[offset + 1]) + 1) * 8;
+            nextHeader = data[offset];
+            offset += length;
+            if (offset > end) break;
+            continue;
+        }
+        if (nextHeader == 44 && offset + 8 <= end && data[offset] == PROTOCOL_UDP) {
+            // Fragment header
+            const uint16_t field = be16(data + offset + 2);
+            const uint32_t id = be32(data + offset + 4);
+            offset += 8;
+            size_t payloadSize = end - offset;
+            const uint8_t* payload = reassemble(6, data + 8, id, size_t(field >> 3) * 8, (field & 1) != 0,
+                                                data + offset, payloadSize, timestamp, payloadSize);
+            if (!payload) return false;
+            ++m_stats.reassembled;
+            return parseUDP(payload, payloadSize, timestamp, datagram);
+        }
+        break;
+    }
+    ++m_stats.skipped;
+    return false;
+}
+
+bool PcapReader::parseUDP(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram)
+{
+    if (size < 8) {
+        ++m_stats.skipped;
+        return false;
+    }
+    const size_t length = be16(data + 4);
+    if (length < 8) {
+        ++m_stats.skipped;
+        return false;
+    }
+    if (length > size) {
+        ++m_stats.truncated;
+        return false;
+    }
+
+    const uint16_t destinationPort = be16(data + 2);
+    if (m_port != 0 && destinationPort != m_port) {
+        ++m_stats.filtered;
+        return false;
+    }
+
+    datagram.timestamp = timestamp;
+    datagram.data = data + 8;
+    datagram.size = length - 8;
+    datagram.sourcePort = be16(data);
+    datagram.destinationPort = destinationPort;
+    return true;
+}
+
+const uint8_t* PcapReader::reassemble(uint8_t family, const uint8_t* addresses, uint32_t id, size_t offset,
+                                      bool moreFragments, const uint8_t* data, size_t size, uint64_t timestamp,
+                                      size_t& totalLength)
+{
+    const size_t addressBytes = family == 4 ? 8 : 32;
+    Reassembly* slot = nullptr;
+    Reassembly* oldest = nullptr;
+    Reassembly* freeSlot = nullptr;
+    for (Reassembly& candidate : m_reassembly) {
+        if (!candidate.used) {
+            if (!freeSlot) freeSlot = &candidate;
+            continue;
+        }
+        if (candidate.family == family && candidate.id == id
+            && std::memcmp(candidate.addresses, addresses, addressBytes) == 0) {
+            slot = &candidate;
+            break;
+        }
+        // Datagrams whose remaining fragments never came are given up on
+        if (timestamp > candidate.lastSeen + REASSEMBLY_TIMEOUT_US) {
+            candidate.used = false;
+            ++m_stats.fragmentsDropped;
+            if (!freeSlot) freeSlot = &candidate;
+            continue;
+        }
+        if (!oldest || candidate.lastSeen < oldest->lastSeen) oldest = &candidate;
+    }
+
+    if (!slot) {
+        if (!freeSlot && m_reassembly.size() < MAX_REASSEMBLY_SLOTS) {
+            m_reassembly.emplace_back();
+            freeSlot = &m_reassembly.back();
+            freeSlot->payload.resize(MAX_IP_PAYLOAD);
+            freeSlot->seen.resize((MAX_IP_PAYLOAD + 7) / 8);
+        } else if (!freeSlot) {
+            freeSlot = oldest;   // Table full: evict the stalest datagram
+            ++m_stats.fragmentsDropped;
+        }
+        slot = freeSlot;
+        slot->used = true;
+        slot->family = family;
+        std::memcpy(slot->addresses, addresses, addressBytes);
+        slot->id = id;
+        slot->totalLength = 0;
+        slot->blocksSeen = 0;
+        std::fill(slot->seen.begin(), slot->seen.end(), uint8_t(0));
+    }
+    slot->lastSeen = timestamp;
+
+    if (offset + size > MAX_IP_PAYLOAD) {
+        slot->used = false;
+        ++m_stats.fragmentsDropped;
+        return nullptr;
+    }
+    std::memcpy(slot->payload.data() + offset, data, size);
+    for (size_t block = offset / 8; block < (offset + size + 7) / 8; ++block) {
+        if (!slot->seen[block]) {
+            slot->seen[block] = 1;
+            ++slot->blocksSeen;
+        }
+    }
+    if (!moreFragments) {
+        slot->totalLength = offset + size;
+    }
+
+    if (slot->totalLength == 0 || slot->blocksSeen < (slot->totalLength + 7) / 8) {
+        return nullptr;
+    }
+    slot->used = false;  // Payload stays valid until the slot is reused
+    totalLength = slot->totalLength;
+    return slot->payload.data();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Streams UDP datagrams out of a tcpdump capture (.pcap or .pcapng) in one
+// sequential pass. Packets are parsed from the link layer (Ethernet with
+// VLAN tags, Linux cooked v1/v2, raw IP, BSD loopback) through IPv4/IPv6 to
+// UDP and filtered on the destination port. IP fragments are reassembled,
+// since ADC datagrams are larger than an Ethernet MTU.
+//
+// Memory stays bounded on captures of any size: one block buffer, reused,
+// plus a fixed number of fragment reassembly slots.
+class PcapReader
+{
+public:
+    struct Datagram {
+        uint64_t timestamp;       // Microseconds, Unix epoch
+        const uint8_t* data;      // UDP payload; valid until the next call to next()
+        size_t size;
+        uint16_t sourcePort;
+        uint16_t destinationPort;
+    };
+
+    struct Stats {
+        uint64_t packets;         // Link-layer packets read
+        uint64_t datagrams;       // UDP datagrams returned
+        uint64_t filtered;        // UDP datagrams to other ports
+        uint64_t reassembled;     // Datagrams rebuilt from IP fragments
+        uint64_t skipped;         // Not IP/UDP, or an unsupported link type
+        uint64_t truncated;       // Cut short by the capture snap length
+        uint64_t fragmentsDropped;  // Fragments of datagrams that never completed
+    };
+
+    PcapReader();
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+    bool rewind();
+
+    // Destination port to keep; 0 keeps every UDP datagram
+    void setPort(uint16_t port) { m_port = port; }
+
+    // Next matching datagram; false at the end of the capture
+    bool next(Datagram& datagram);
+
+    bool isPcapNg() const { return m_pcapNg; }
+    uint64_t fileSize() const { return m_fileSize; }
+    uint64_t position() const { return m_position; }  // Bytes consumed, for progress
+    const Stats& stats() const { return m_stats; }
+
+    // True if the file starts like a pcap or pcapng capture
+    static bool isCapture(const std::string& path);
+
+private:
+    struct Interface {
+        uint16_t linkType;
+        bool binaryResolution;    // Timestamp resolution 2^-n rather than 10^-n
+        uint8_t resolutionExponent;
+        int64_t offsetSeconds;
+    };
+
+    struct Reassembly {
+        bool used;
+        uint8_t family;
+        uint8_t addresses[32];    // Source then destination
+        uint32_t id;
+        uint64_t lastSeen;
+        size_t totalLength;       // Payload length, 0 until the last fragment arrived
+        size_t blocksSeen;
+        std::vector<uint8_t> payload;
+        std::vector<uint8_t> seen;  // One byte per 8-byte fragment block
+    };
+
+    bool readBytes(void* out, size_t size);
+    bool skipBytes(uint64_t size);
+    bool readPcapPacket(uint64_t& timestamp, const uint8_t*& data, size_t& size, uint16_t& linkType);
+    bool readPcapNgPacket(uint64_t& timestamp, const uint8_t*& data, size_t& size, uint16_t& linkType);
+    bool readSectionHeader(uint32_t blockLength);
+    void readInterface(const uint8_t* body, size_t size);
+    uint64_t toMicroseconds(const Interface& interface, uint64_t units) const;
+
+    bool parseLinkLayer(uint16_t linkType, const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram);
+    bool parseIPv4(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram);
+    bool parseIPv6(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram);
+    bool parseUDP(const uint8_t* data, size_t size, uint64_t timestamp, Datagram& datagram);
+    const uint8_t* reassemble(uint8_t family, const uint8_t* addresses, uint32_t id, size_t offset,
+                              bool moreFragments, const uint8_t* data, size_t size, uint64_t timestamp,
+                              size_t& totalLength);
+
+    uint16_t read16(const uint8_t* p) const;
+    uint32_t read32(const uint8_t* p) const;
+
+    std::string m_path;
+    std::FILE* m_file;
+    uint64_t m_fileSize;
+    uint64_t m_position;
+    uint16_t m_port;
+    bool m_pcapNg;
+    bool m_swapped;               // File byte order differs from the host
+
+    // Classic pcap
+    bool m_nanoseconds;
+    uint16_t m_linkType;
+
+    // pcapng: interfaces of the current section
+    std::vector<Interface> m_interfaces;
+    uint64_t m_lastTimestamp;
+
+    std::vector<uint8_t> m_block;   // Current packet/block, reused
+    std::vector<Reassembly> m_reassembly;
+    Stats m_stats;
+};
@@ -0,0 +1,112 @@
+#include "PersistenceBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PERSISTENCE_USE_SSE2 1
+#endif
+
+PersistenceBuffer::PersistenceBuffer()
+    : m_width(0)
+    , m_height(0)
+    , m_stride(0)
+    , m_dirty(false)
+{
+}
+
+void PersistenceBuffer::resize(int width, int height)
+{
+    width = std::max(0, width);
+    height = std::max(0, height);
+
+    m_width = width;
+    m_height = height;
+    m_stride = (width + 15) & ~15;
+    m_pixels.assign(size_t(m_stride) * height, 0);
+    m_dirty = false;
+}
+
+void PersistenceBuffer::clear()
+{
+    if (m_dirty) {
+        std::fill(m_pixels.begin(), m_pixels.end(), uint8_t(0));
+        m_dirty = false;
+    }
+}
+
+void PersistenceBuffer::decay(float factor)
+{
+    if (!m_dirty) return;
+
+    if (factor <= 0.0f) {
+        clear();
+        return;
+    }
+
+    // 8.8 fixed point: value * scale >> 8
+    uint16_t scale = static_cast<uint16_t>(std::min(256.0f, std::round(factor * 256.0f)));
+    if (scale >= 256) return;
+
+    // Once everything has faded out, later frames skip the pass
+    m_dirty = decayRow(m_pixels.data(), m_pixels.size(), scale);
+}
+
+bool PersistenceBuffer::decayRow(uint8_t* pixels, size_t count, uint16_t scale)
+{
+    size_t i = 0;
+    uint8_t any = 0;
+
+#ifdef PERSISTENCE_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i factor = _mm_set1_epi16(static_cast<short>(scale));
+    __m128i anyVector = zero;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+        // Widen to 16 bits, multiply, shift back down and repack
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        lo = _mm_srli_epi16(_mm_mullo_epi16(lo, factor), 8);
+        hi = _mm_srli_epi16(_mm_mullo_epi16(hi, factor), 8);
+
+        v = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), v);
+        anyVector = _mm_or_si128(anyVector, v);
+    }
+    any = static_cast<uint8_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(anyVector, zero)) != 0xFFFF);
+#endif
+
+    // Scalar tail (and the whole buffer on non-SSE2 targets, where the
+    // compiler can still auto-vectorize this loop)
+    for (; i < count; ++i) {
+        pixels[i] = static_cast<uint8_t>((pixels[i] * scale) >> 8);
+        any |= pixels[i];
+    }
+    return any != 0;
+}
+
+void PersistenceBuffer::splat(float x, float y, uint8_t intensity, int radius)
+{
+    if (m_pixels.empty()) return;
+
+    int cx = static_cast<int>(std::lround(x));
+    int cy = static_cast<int>(std::lround(y));
+    int radius2 = radius * radius;
+
+    int y0 = std::max(0, cy - radius);
+    int y1 = std::min(m_height - 1, cy + radius);
+    for (int py = y0; py <= y1; ++py) {
+        int dy = py - cy;
+        int span = static_cast<int>(std::sqrt(float(radius2 - dy * dy)));
+        int x0 = std::max(0, cx - span);
+        int x1 = std::min(m_width - 1, cx + span);
+
+        uint8_t* row = &m_pixels[size_t(py) * m_stride];
+        for (int px = x0; px <= x1; ++px) {
+            row[px] = std::max(row[px], intensity);
+        }
+        m_dirty = m_dirty || x0 <= x1;
+    }
+}
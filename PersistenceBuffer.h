@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Phosphor-style afterglow accumulation buffer.
+// Each data frame the whole image is faded with one multiply pass and the
+// new target positions are splatted on top, so the cost is independent of
+// how many past frames are still visible.
+class PersistenceBuffer
+{
+public:
+    PersistenceBuffer();
+
+    void resize(int width, int height);
+    void clear();
+
+    // Multiply every pixel by factor (0..1)
+    void decay(float factor);
+
+    // Stamp a filled disc at (x, y), keeping the brighter of old/new values
+    void splat(float x, float y, uint8_t intensity, int radius);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int bytesPerLine() const { return m_stride; }
+    const uint8_t* data() const { return m_pixels.data(); }
+    bool isEmpty() const { return m_pixels.empty(); }
+
+private:
+    // Returns whether any pixel is still non-zero
+    static bool decayRow(uint8_t* pixels, size_t count, uint16_t scale);
+
+    std::vector<uint8_t> m_pixels;
+    int m_width;
+    int m_height;
+    int m_stride;  // Row length padded to 16 bytes for the vector kernel
+    bool m_dirty;  // False while the buffer is known to be all zero; decay() skips it
+};
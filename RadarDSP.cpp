@@ -0,0 +1,191 @@
+#include "RadarDSP.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RadarDSP {
+
+namespace {
+const double PI = 3.14159265358979323846;
+}
+
+size_t nextPowerOfTwo(size_t n)
+{
+    size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+void hannWindow(size_t n, std::vector<float>& window)
+{
+    window.resize(n);
+    if (n == 1) {
+        window[0] = 1.0f;
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        window[i] = static_cast<float>(0.5 * (1.0 - std::cos(2.0 * PI * double(i) / double(n - 1))));
+    }
+}
+
+void makeWindow(WindowType type, size_t n, std::vector<float>& window)
+{
+    if (type == WindowHann) {
+        hannWindow(n, window);
+        return;
+    }
+    window.assign(n, 1.0f);
+    if (type == WindowRectangular || n == 1) return;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 2.0 * PI * double(i) / double(n - 1);
+        window[i] = static_cast<float>(type == WindowHamming
+            ? 0.54 - 0.46 * std::cos(x)
+            : 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x));
+    }
+}
+
+void applyWindow(const ComplexLineView& line, const float* window, size_t windowLength)
+{
+    const size_t count = std::min(line.count, windowLength);
+    for (size_t i = 0; i < count; ++i) {
+        line.real(i) *= window[i];
+        line.imag(i) *= window[i];
+    }
+}
+
+void fft(const ComplexLineView& line)
+{
+    const size_t n = line.count;
+    if (n <= 1) return;
+
+    // Bit-reversal permutation
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            std::swap(line.real(i), line.real(j));
+            std::swap(line.imag(i), line.imag(j));
+        }
+    }
+
+    // Butterflies
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double angle = -2.0 * PI / double(len);
+        const float wlenRe = static_cast<float>(std::cos(angle));
+        const float wlenIm = static_cast<float>(std::sin(angle));
+        const size_t half = len / 2;
+
+        for (size_t i = 0; i < n; i += len) {
+            float wRe = 1.0f;
+            float wIm = 0.0f;
+            for (size_t j = 0; j < half; ++j) {
+                const size_t a = i + j;
+                const size_t b = a + half;
+
+                float vRe = line.real(b) * wRe - line.imag(b) * wIm;
+                float vIm = line.real(b) * wIm + line.imag(b) * wRe;
+                float uRe = line.real(a);
+                float uIm = line.imag(a);
+
+                line.real(a) = uRe + vRe;
+                line.imag(a) = uIm + vIm;
+                line.real(b) = uRe - vRe;
+                line.imag(b) = uIm - vIm;
+
+                float nextRe = wRe * wlenRe - wIm * wlenIm;
+                wIm = wRe * wlenIm + wIm * wlenRe;
+                wRe = nextRe;
+            }
+        }
+    }
+}
+
+void rangeFFT(RadarDataCube& cube, const std::vector<float>& window)
+{
+    for (size_t antenna = 0; antenna < cube.antennas(); ++antenna) {
+        for (size_t chirp = 0; chirp < cube.chirps(); ++chirp) {
+            ComplexLineView line = cube.chirp(antenna, chirp);
+            if (!window.empty()) applyWindow(line, window.data(), window.size());
+            fft(line);
+        }
+    }
+}
+
+void dopplerFFT(RadarDataCube& cube, const std::vector<float>& window)
+{
+    for (size_t antenna = 0; antenna < cube.antennas(); ++antenna) {
+        for (size_t sample = 0; sample < cube.samples(); ++sample) {
+            ComplexLineView line = cube.rangeBin(antenna, sample);
+            if (!window.empty()) applyWindow(line, window.data(), window.size());
+            fft(line);
+        }
+    }
+}
+
+void magnitude(const ConstComplexLineView& line, float* out)
+{
+    if (line.isContiguousInterleaved()) {
+        // Common case: plain I/Q pairs, kept simple so it vectorizes
+        const float* iq = line.re;
+        for (size_t i = 0; i < line.count; ++i) {
+            out[i] = std::sqrt(iq[2 * i] * iq[2 * i] + iq[2 * i + 1] * iq[2 * i + 1]);
+        }
+        return;
+    }
+    for (size_t i = 0; i < line.count; ++i) {
+        out[i] = std::sqrt(line.real(i) * line.real(i) + line.imag(i) * line.imag(i));
+    }
+}
+
+void caCfar(const float* power, size_t count, size_t guard, size_t training, float scale,
+            std::vector<uint32_t>& hits)
+{
+    hits.clear();
+    if (training == 0) return;
+
+    // Running sums over the two training windows, slid one cell at a time.
+    // Windows are [i - guard - training, i - guard) and
+    // (i + guard, i + guard + training], clipped to the profile.
+    double leftSum = 0.0;
+    double rightSum = 0.0;
+    size_t leftCount = 0;
+    size_t rightCount = 0;
+    for (size_t j = guard + 1; j <= guard + training && j < count; ++j) {
+        rightSum += power[j];
+        ++rightCount;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t noiseCount = leftCount + rightCount;
+        if (noiseCount > 0 && power[i] > scale * float((leftSum + rightSum) / double(noiseCount))) {
+            hits.push_back(uint32_t(i));
+        }
+
+        // Slide to i + 1
+        if (i + 1 >= guard + 1) {
+            const size_t enter = i - guard;           // Joins the left window
+            leftSum += power[enter];
+            ++leftCount;
+            if (leftCount > training) {
+                leftSum -= power[enter - training];
+                --leftCount;
+            }
+        }
+        if (i + guard + 1 < count && rightCount > 0) {
+            rightSum -= power[i + guard + 1];       // Becomes a guard cell
+            --rightCount;
+        }
+        if (i + guard + training + 1 < count) {
+            rightSum += power[i + guard + training + 1];
+            ++rightCount;
+        }
+    }
+}
+
+} // namespace RadarDSP
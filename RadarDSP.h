@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RadarDataCube.h"
+
+// Signal processing stages that work in place on data cube lines, so a
+// frame is never repacked between range, Doppler and angle processing.
+namespace RadarDSP {
+
+size_t nextPowerOfTwo(size_t n);
+
+enum WindowType {
+    WindowRectangular,
+    WindowHann,
+    WindowHamming,
+    WindowBlackman
+};
+
+// Hann window of length n
+void hannWindow(size_t n, std::vector<float>& window);
+void makeWindow(WindowType type, size_t n, std::vector<float>& window);
+
+// Multiply the first windowLength elements of the line by the window
+void applyWindow(const ComplexLineView& line, const float* window, size_t windowLength);
+
+// In-place radix-2 FFT; line.count must be a power of two
+void fft(const ComplexLineView& line);
+
+// Window + FFT along every chirp (range) or every range bin across chirps
+// (Doppler). The window length may be shorter than the line when the data
+// is zero-padded; an empty window skips windowing.
+void rangeFFT(RadarDataCube& cube, const std::vector<float>& window);
+void dopplerFFT(RadarDataCube& cube, const std::vector<float>& window);
+
+// |x| for each element of the line
+void magnitude(const ConstComplexLineView& line, float* out);
+
+// Cell-averaging CFAR along a power profile. Cell i is a hit when it
+// exceeds scale times the mean of the training cells on both sides, past
+// the guard cells; near the ends the side that exists is used alone.
+void caCfar(const float* power, size_t count, size_t guard, size_t training, float scale,
+            std::vector<uint32_t>& hits);
+
+} // namespace RadarDSP
@@ -0,0 +1,126 @@
+#include "RadarDataCube.h"
+#include <algorithm>
+
+namespace {
+
+// Float count rounded up to a whole 64-byte cache line
+size_t alignedFloats(size_t count)
+{
+    const size_t floatsPerLine = 64 / sizeof(float);
+    return (count + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+}
+
+} // namespace
+
+RadarDataCube::RadarDataCube()
+    : m_antennas(0)
+    , m_chirps(0)
+    , m_samples(0)
+    , m_imagPlane(0)
+    , m_order(Order::SampleMajor)
+    , m_layout(Layout::Interleaved)
+{
+}
+
+void RadarDataCube::resize(size_t antennas, size_t chirps, size_t samples, Order order, Layout layout)
+{
+    m_antennas = antennas;
+    m_chirps = chirps;
+    m_samples = samples;
+    m_order = order;
+    m_layout = layout;
+
+    const size_t elements = elementCount();
+    m_imagPlane = alignedFloats(elements);
+    m_data.assign(layout == Layout::Interleaved ? 2 * elements : 2 * m_imagPlane, 0.0f);
+}
+
+void RadarDataCube::fill(float re, float im)
+{
+    const size_t elements = elementCount();
+    float* data = m_data.data();
+    if (m_layout == Layout::Interleaved) {
+        for (size_t i = 0; i < elements; ++i) {
+            data[2 * i] = re;
+            data[2 * i + 1] = im;
+        }
+    } else {
+        std::fill(data, data + elements, re);
+        std::fill(data + m_imagPlane, data + m_imagPlane + elements, im);
+    }
+}
+
+void RadarDataCube::convert(Order order, Layout layout)
+{
+    if (order == m_order && layout == m_layout) return;
+
+    // Copy out through the old indexing, then re-index into the new one
+    m_scratch.swap(m_data);
+    const AlignedVector<float>& source = m_scratch;
+    const Order oldOrder = m_order;
+    const Layout oldLayout = m_layout;
+    const size_t oldImagPlane = m_imagPlane;
+
+    m_order = order;
+    m_layout = layout;
+    const size_t elements = elementCount();
+    m_imagPlane = alignedFloats(elements);
+    m_data.resize(layout == Layout::Interleaved ? 2 * elements : 2 * m_imagPlane);
+
+    for (size_t a = 0; a < m_antennas; ++a) {
+        for (size_t c = 0; c < m_chirps; ++c) {
+            for (size_t s = 0; s < m_samples; ++s) {
+                size_t oldIndex = oldOrder == Order::SampleMajor
+                    ? (a * m_chirps + c) * m_samples + s
+                    : (a * m_samples + s) * m_chirps + c;
+                float re = oldLayout == Layout::Interleaved ? source[2 * oldIndex] : source[oldIndex];
+                float im = oldLayout == Layout::Interleaved ? source[2 * oldIndex + 1] : source[oldImagPlane + oldIndex];
+
+                size_t newIndex = index(a, c, s);
+                m_data[realOffset(newIndex)] = re;
+                m_data[imagOffset(newIndex)] = im;
+            }
+        }
+    }
+}
+
+template <typename Float>
+ComplexLine<Float> RadarDataCube::line(Float* base, size_t first, size_t count, size_t elementStride) const
+{
+    ComplexLine<Float> view;
+    view.re = base + realOffset(first);
+    view.im = base + imagOffset(first);
+    view.count = count;
+    view.stride = ptrdiff_t(m_layout == Layout::Interleaved ? 2 * elementStride : elementStride);
+    return view;
+}
+
+ComplexLineView RadarDataCube::chirp(size_t antenna, size_t chirp)
+{
+    return line(m_data.data(), index(antenna, chirp, 0), m_samples, sampleStride());
+}
+
+ComplexLineView RadarDataCube::rangeBin(size_t antenna, size_t sample)
+{
+    return line(m_data.data(), index(antenna, 0, sample), m_chirps, chirpStride());
+}
+
+ComplexLineView RadarDataCube::antennaLine(size_t chirp, size_t sample)
+{
+    return line(m_data.data(), index(0, chirp, sample), m_antennas, antennaStride());
+}
+
+ConstComplexLineView RadarDataCube::chirp(size_t antenna, size_t chirp) const
+{
+    return line(m_data.data(), index(antenna, chirp, 0), m_samples, sampleStride());
+}
+
+ConstComplexLineView RadarDataCube::rangeBin(size_t antenna, size_t sample) const
+{
+    return line(m_data.data(), index(antenna, 0, sample), m_chirps, chirpStride());
+}
+
+ConstComplexLineView RadarDataCube::antennaLine(size_t chirp, size_t sample) const
+{
+    return line(m_data.data(), index(0, chirp, sample), m_antennas, antennaStride());
+}
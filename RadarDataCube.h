@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "AlignedAllocator.h"
+
+// Strided, non-owning view of a line of complex samples inside a cube.
+// Element i is (re[i * stride], im[i * stride]); stride is in floats. The
+// same view type covers interleaved (im = re + 1) and split (separate
+// planes) storage, so DSP stages are written once for both.
+template <typename Float>
+struct ComplexLine {
+    Float* re;
+    Float* im;
+    size_t count;
+    ptrdiff_t stride;
+
+    Float& real(size_t i) const { return re[ptrdiff_t(i) * stride]; }
+    Float& imag(size_t i) const { return im[ptrdiff_t(i) * stride]; }
+    bool isContiguousInterleaved() const { return stride == 2 && im == re + 1; }
+
+    // A mutable view converts to a read-only one
+    template <typename Other, typename = typename std::enable_if<
+                  std::is_same<Other, const Float>::value && !std::is_same<Other, Float>::value>::type>
+    operator ComplexLine<Other>() const { return ComplexLine<Other>{re, im, count, stride}; }
+};
+
+using ComplexLineView = ComplexLine<float>;
+using ConstComplexLineView = ComplexLine<const float>;
+
+// Frame data cube: antennas x chirps x samples of complex float samples in
+// one 64-byte aligned allocation.
+//
+// Memory order decides which dimension is contiguous:
+//   SampleMajor - samples of one chirp are adjacent (range FFT friendly)
+//   ChirpMajor  - one range sample across chirps is adjacent (Doppler FFT friendly)
+// Antenna is always the outermost dimension.
+//
+// Complex layout:
+//   Interleaved - I, Q, I, Q, ...
+//   Split       - all I values, then all Q values (each plane 64-byte aligned)
+class RadarDataCube
+{
+public:
+    enum class Order { SampleMajor, ChirpMajor };
+    enum class Layout { Interleaved, Split };
+
+    RadarDataCube();
+
+    // Zero-filled; keeps the allocation when the size does not grow
+    void resize(size_t antennas, size_t chirps, size_t samples,
+                Order order = Order::SampleMajor, Layout layout = Layout::Interleaved);
+    void fill(float re, float im);
+
+    // Rewrite the data in another order/layout (uses a scratch buffer kept for reuse)
+    void convert(Order order, Layout layout);
+
+    size_t antennas() const { return m_antennas; }
+    size_t chirps() const { return m_chirps; }
+    size_t samples() const { return m_samples; }
+    size_t elementCount() const { return m_antennas * m_chirps * m_samples; }
+    Order order() const { return m_order; }
+    Layout layout() const { return m_layout; }
+
+    // Element access
+    float& real(size_t antenna, size_t chirp, size_t sample) { return m_data[realOffset(index(antenna, chirp, sample))]; }
+    float& imag(size_t antenna, size_t chirp, size_t sample) { return m_data[imagOffset(index(antenna, chirp, sample))]; }
+    float real(size_t antenna, size_t chirp, size_t sample) const { return m_data[realOffset(index(antenna, chirp, sample))]; }
+    float imag(size_t antenna, size_t chirp, size_t sample) const { return m_data[imagOffset(index(antenna, chirp, sample))]; }
+
+    // Lines through the cube
+    ComplexLineView chirp(size_t antenna, size_t chirp);              // along samples (range)
+    ComplexLineView rangeBin(size_t antenna, size_t sample);          // along chirps (Doppler)
+    ComplexLineView antennaLine(size_t chirp, size_t sample);         // along antennas (angle)
+    ConstComplexLineView chirp(size_t antenna, size_t chirp) const;
+    ConstComplexLineView rangeBin(size_t antenna, size_t sample) const;
+    ConstComplexLineView antennaLine(size_t chirp, size_t sample) const;
+
+    float* data() { return m_data.data(); }
+    const float* data() const { return m_data.data(); }
+
+private:
+    size_t index(size_t antenna, size_t chirp, size_t sample) const
+    {
+        return m_order == Order::SampleMajor
+            ? (antenna * m_chirps + chirp) * m_samples + sample
+            : (antenna * m_samples + sample) * m_chirps + chirp;
+    }
+    size_t realOffset(size_t element) const { return m_layout == Layout::Interleaved ? 2 * element : element; }
+    size_t imagOffset(size_t element) const { return m_layout == Layout::Interleaved ? 2 * element + 1 : m_imagPlane + element; }
+
+    // Element strides (in elements) along each dimension
+    size_t sampleStride() const { return m_order == Order::SampleMajor ? 1 : m_chirps; }
+    size_t chirpStride() const { return m_order == Order::SampleMajor ? m_samples : 1; }
+    size_t antennaStride() const { return m_chirps * m_samples; }
+
+    template <typename Float>
+    ComplexLine<Float> line(Float* base, size_t first, size_t count, size_t elementStride) const;
+
+    AlignedVector<float> m_data;
+    AlignedVector<float> m_scratch;
+    size_t m_antennas;
+    size_t m_chirps;
+    size_t m_samples;
+    size_t m_imagPlane;  // Offset of the Q plane in Split layout (floats)
+    Order m_order;
+    Layout m_layout;
+};
@@ -0,0 +1,236 @@
+#include "RadarPipeline.h"
+
+RadarPipeline::RadarPipeline()
+    : m_statDatagrams(0)
+    , m_statBytes(0)
+    , m_statTrackFrames(0)
+    , m_statADCFrames(0)
+    , m_statADCMissing(0)
+    , m_statADCReordered(0)
+    , m_lastADCId(0)
+    , m_haveADCId(false)
+    , m_sensorTracks(std::make_shared<TargetTrackData>())
+    , m_adcFrame(std::make_shared<RawADCFrameTest>())
+    , m_trackTimestamp(0)
+    , m_adcTimestamp(0)
+    , m_recorder(nullptr)
+    , m_recordRaw(true)
+    , m_recordDecoded(true)
+    , m_exporter(nullptr)
+    , m_frameProcessingEnabled(false)
+    , m_clusteringEnabled(false)
+    , m_outputTracks(m_sensorTracks)
+{
+}
+
+int RadarPipeline::processDatagram(const char* data, size_t size, uint64_t timestamp)
+{
+    if (m_recorder && m_recordRaw && m_recorder->isOpen()) {
+        m_recorder->writeDatagram(data, size, timestamp);
+    }
+
+    // Binary or text; decoded snapshots replace the current ones
+    const int decoded = m_decoder.decode(data, size, m_sensorTracks, m_adcFrame);
+
+    // Counters are written from this thread only and read from any
+    m_statDatagrams.fetch_add(1, std::memory_order_relaxed);
+    m_statBytes.fetch_add(size, std::memory_order_relaxed);
+    if (decoded & DatagramDecoder::DecodedTracks) {
+        m_statTrackFrames.fetch_add(1, std::memory_order_relaxed);
+        m_trackTimestamp = timestamp;
+    }
+    if (decoded & DatagramDecoder::DecodedADCFrame) {
+        m_statADCFrames.fetch_add(1, std::memory_order_relaxed);
+        m_adcTimestamp = timestamp;
+        const uint32_t id = m_adcFrame->msgId;
+        if (!m_haveADCId) {
+            m_haveADCId = true;
+            m_lastADCId = id;
+        } else if (id > m_lastADCId) {
+            m_statADCMissing.fetch_add(id - m_lastADCId - 1, std::memory_order_relaxed);
+            m_lastADCId = id;
+        } else if (id < m_lastADCId) {
+            m_statADCReordered.fetch_add(1, std::memory_order_relaxed);
+            if (m_statADCMissing.load(std::memory_order_relaxed) > 0) {
+                m_statADCMissing.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (recordingDecoded()) {
+        if (decoded & DatagramDecoder::DecodedTracks) {
+            m_recorder->writeTracks(m_sensorTracks, timestamp);
+        }
+        if (decoded & DatagramDecoder::DecodedADCFrame) {
+            m_recorder->writeADCFrame(m_adcFrame, timestamp);
+        }
+    }
+    return decoded;
+}
+
+void RadarPipeline::setSensorTracks(TrackSnapshotPtr tracks, uint64_t timestamp)
+{
+    m_sensorTracks = std::move(tracks);
+    m_trackTimestamp = timestamp;
+    if (recordingDecoded()) {
+        m_recorder->writeTracks(m_sensorTracks, timestamp);
+    }
+}
+
+void RadarPipeline::setADCFrame(ADCFramePtr frame, uint64_t timestamp)
+{
+    m_adcFrame = std::move(frame);
+    m_adcTimestamp = timestamp;
+    if (recordingDecoded()) {
+        m_recorder->writeADCFrame(m_adcFrame, timestamp);
+    }
+}
+
+RadarPipeline::ReceiveStats RadarPipeline::receiveStats() const
+{
+    ReceiveStats stats;
+    stats.datagrams = m_statDatagrams.load(std::memory_order_relaxed);
+    stats.bytes = m_statBytes.load(std::memory_order_relaxed);
+    stats.trackFrames = m_statTrackFrames.load(std::memory_order_relaxed);
+    stats.adcFrames = m_statADCFrames.load(std::memory_order_relaxed);
+    stats.adcMissing = m_statADCMissing.load(std::memory_order_relaxed);
+    stats.adcReordered = m_statADCReordered.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void RadarPipeline::resetReceiveStats()
+{
+    m_statDatagrams.store(0, std::memory_order_relaxed);
+    m_statBytes.store(0, std::memory_order_relaxed);
+    m_statTrackFrames.store(0, std::memory_order_relaxed);
+    m_statADCFrames.store(0, std::memory_order_relaxed);
+    m_statADCMissing.store(0, std::memory_order_relaxed);
+    m_statADCReordered.store(0, std::memory_order_relaxed);
+    m_haveADCId = false;
+}
+
+void RadarPipeline::setRecorder(RecordingWriter* recorder, bool raw, bool decoded)
+{
+    m_recorder = recorder;
+    m_recordRaw = raw;
+    m_recordDecoded = decoded;
+}
+
+void RadarPipeline::setExporter(ColumnExporter* exporter)
+{
+    m_exporter = exporter;
+    m_exportedTracks = m_outputTracks;   // Only tracks produced from now on
+}
+
+void RadarPipeline::setFrameProcessingEnabled(bool enabled)
+{
+    m_frameProcessingEnabled = enabled;
+    m_processedFrame = m_adcFrame;       // Start with the next frame
+    m_clusterer.clear();
+    m_tracker.clear();
+    m_hostInput.reset();
+}
+
+void RadarPipeline::setClusteringEnabled(bool enabled)
+{
+    m_clusteringEnabled = enabled;
+    m_clusterer.clear();
+    m_hostInput.reset();
+}
+
+void RadarPipeline::configure(const DSP_Settings_t& settings)
+{
+    const bool wasEnabled = m_tracker.isEnabled();
+    m_tracker.configure(settings);
+    if (m_tracker.isEnabled() != wasEnabled) {
+        m_tracker.clear();
+        m_hostInput.reset();
+    }
+}
+
+void RadarPipeline::resetHostProcessing()
+{
+    m_clusterer.clear();
+    m_tracker.clear();
+    m_hostInput.reset();
+    m_processedFrame = m_adcFrame;
+    m_zoneInput.reset();
+}
+
+void RadarPipeline::runHostProcessing(double timeSeconds)
+{
+    const bool newFrame = m_frameProcessingEnabled && processFrame();
+
+    if (!m_clusteringEnabled && !m_tracker.isEnabled()) {
+        m_outputTracks = m_sensorTracks;
+        exportOutput(m_trackTimestamp);
+        return;
+    }
+
+    // Only a new input is processed: the processed frame's detections, or
+    // the sensor snapshot's reports as detections
+    uint64_t timestamp;
+    if (m_frameProcessingEnabled) {
+        if (!newFrame) return;
+        m_detections = m_frameProcessor.detections();
+        timestamp = m_adcTimestamp;
+    } else {
+        if (m_sensorTracks == m_hostInput) return;
+        m_hostInput = m_sensorTracks;
+
+        m_detections.clear();
+        for (const TargetTrack& target : m_hostInput->targets) {
+            m_detections.push_back(Detection{target.radius, target.azimuth,
+                                             target.radial_speed, target.level});
+        }
+        timestamp = m_trackTimestamp;
+    }
+
+    std::shared_ptr<TargetTrackData> tracks = m_hostPool.acquire();
+    if (m_clusteringEnabled) {
+        m_clusterer.cluster(m_detections);
+    }
+
+    if (m_tracker.isEnabled()) {
+        const std::vector<Detection>& input = m_clusteringEnabled ? m_clusterer.centroids() : m_detections;
+        m_tracker.update(input, timeSeconds);
+        m_tracker.exportTracks(*tracks);
+    } else {
+        m_clusterer.exportTracks(*tracks);
+    }
+    m_outputTracks = std::move(tracks);
+    exportOutput(timestamp);
+}
+
+// True when the current ADC frame is new and held whole chirps
+bool RadarPipeline::processFrame()
+{
+    if (m_adcFrame == m_processedFrame) return false;
+    m_processedFrame = m_adcFrame;
+    if (!m_frameProcessor.process(*m_processedFrame)) return false;
+
+    if (exporting()) {
+        m_exporter->addDetections(m_frameProcessor.detections(), m_adcTimestamp);
+        m_exporter->addRangeProfile(m_frameProcessor.rangeProfileDb(), m_frameProcessor.binRange(),
+                                    m_adcTimestamp);
+    }
+    return true;
+}
+
+void RadarPipeline::exportOutput(uint64_t timestamp)
+{
+    if (!exporting() || m_outputTracks == m_exportedTracks) return;
+    m_exportedTracks = m_outputTracks;
+    m_exporter->addTracks(*m_exportedTracks, timestamp);
+}
+
+const std::vector<ZoneEvent>& RadarPipeline::evaluateZones(double timeSeconds)
+{
+    m_zoneEvents.clear();
+    if (m_zoneEngine.zones().empty() || m_outputTracks == m_zoneInput) {
+        return m_zoneEvents;
+    }
+    m_zoneInput = m_outputTracks;
+    m_zoneEngine.evaluate(*m_zoneInput, timeSeconds, m_zoneEvents);
+    return m_zoneEvents;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColumnExporter.h"
+#include "DataStructures.h"
+#include "DatagramDecoder.h"
+#include "DetectionClusterer.h"
+#include "FrameProcessor.h"
+#include "MultiTargetTracker.h"
+#include "RecordingWriter.h"
+#include "SnapshotPool.h"
+#include "ZoneEngine.h"
+
+// The receive-side processing chain, free of any UI: datagram decoding,
+// recording, clustering and tracking of the sensor's reports (or of the
+// detections FrameProcessor finds in its ADC frames), zone evaluation of
+// the resulting tracks and column export. MainWindow drives one from its event
+// loop and radard runs one per sensor on that sensor's thread.
+//
+// Not thread-safe, except that receiveStats() and malformedCount() may be
+// read from any thread. Snapshots handed out stay valid for as long as they
+// are held, like everything from DatagramDecoder.
+class RadarPipeline
+{
+public:
+    // Counts of processDatagram() calls, for checking a sender's counts.
+    // ADC frames are also checked against their msgId sequence: a jump
+    // forward counts the skipped ids as missing, an id below the highest
+    // seen counts as reordered and fills one missing id. Repeats of the
+    // last id (a sensor that does not number its frames) are not counted.
+    struct ReceiveStats {
+        uint64_t datagrams;
+        uint64_t bytes;
+        uint64_t trackFrames;
+        uint64_t adcFrames;
+        uint64_t adcMissing;
+        uint64_t adcReordered;
+    };
+
+    RadarPipeline();
+
+    // Decode a received datagram, recording it (raw and/or decoded) when a
+    // recorder is attached. Returns the DatagramDecoder::DecodeResult bits.
+    int processDatagram(const char* data, size_t size, uint64_t timestamp);
+
+    // Frames produced locally rather than received (simulation)
+    void setSensorTracks(TrackSnapshotPtr tracks, uint64_t timestamp);
+    void setADCFrame(ADCFramePtr frame, uint64_t timestamp);
+
+    // Cluster and/or track the latest sensor snapshot (with frame
+    // processing: the detections of the latest ADC frame), once per input.
+    // With both stages off the sensor tracks pass straight through.
+    void runHostProcessing(double timeSeconds);
+
+    // Zone events for the output tracks; empty when they have not changed
+    const std::vector<ZoneEvent>& evaluateZones(double timeSeconds);
+
+    // Drop tracks and cached inputs, e.g. after a replay seek
+    void resetHostProcessing();
+
+    // Recording is active while the recorder is open
+    void setRecorder(RecordingWriter* recorder, bool raw = true, bool decoded = true);
+
+    // Export is active while the exporter is open: the output tracks of
+    // every host processing pass and, with frame processing, each frame's
+    // detections and range profile. Rows carry the input's receive time.
+    void setExporter(ColumnExporter* exporter);
+
+    // Run FrameProcessor on every new ADC frame; its detections then feed
+    // the clusterer and tracker instead of the sensor's track reports
+    void setFrameProcessingEnabled(bool enabled);
+    bool isFrameProcessingEnabled() const { return m_frameProcessingEnabled; }
+    FrameProcessor& frameProcessor() { return m_frameProcessor; }
+
+    void setClusteringEnabled(bool enabled);
+    bool isClusteringEnabled() const { return m_clusteringEnabled; }
+
+    // Applies the tracker fields of the sensor's DSP settings
+    // (MultiTargetTracker::configure); switching tracking on or off drops
+    // the current tracks
+    void configure(const DSP_Settings_t& settings);
+    bool isTrackingEnabled() const { return m_tracker.isEnabled(); }
+
+    DetectionClusterer& clusterer() { return m_clusterer; }
+    MultiTargetTracker& tracker() { return m_tracker; }
+    // Zones added or removed between frames take effect with the next frame
+    ZoneEngine& zoneEngine() { return m_zoneEngine; }
+    const ZoneEngine& zoneEngine() const { return m_zoneEngine; }
+
+    const TrackSnapshotPtr& sensorTracks() const { return m_sensorTracks; }
+    const ADCFramePtr& adcFrame() const { return m_adcFrame; }
+    const TrackSnapshotPtr& outputTracks() const { return m_outputTracks; }
+    uint64_t malformedCount() const { return m_decoder.malformedCount(); }
+    ReceiveStats receiveStats() const;
+    void resetReceiveStats();   // From the thread that processes datagrams
+
+private:
+    bool recordingDecoded() const { return m_recorder && m_recordDecoded && m_recorder->isOpen(); }
+    bool exporting() const { return m_exporter && m_exporter->isOpen(); }
+    bool processFrame();
+    void exportOutput(uint64_t timestamp);
+
+    DatagramDecoder m_decoder;
+    std::atomic<uint64_t> m_statDatagrams;
+    std::atomic<uint64_t> m_statBytes;
+    std::atomic<uint64_t> m_statTrackFrames;
+    std::atomic<uint64_t> m_statADCFrames;
+    std::atomic<uint64_t> m_statADCMissing;
+    std::atomic<uint64_t> m_statADCReordered;
+    uint32_t m_lastADCId;         // Highest msgId seen
+    bool m_haveADCId;
+    TrackSnapshotPtr m_sensorTracks;
+    ADCFramePtr m_adcFrame;
+    uint64_t m_trackTimestamp;    // Receive times of the current snapshots
+    uint64_t m_adcTimestamp;
+
+    RecordingWriter* m_recorder;
+    bool m_recordRaw;
+    bool m_recordDecoded;
+
+    ColumnExporter* m_exporter;
+    TrackSnapshotPtr m_exportedTracks;
+
+    FrameProcessor m_frameProcessor;
+    bool m_frameProcessingEnabled;
+    ADCFramePtr m_processedFrame;
+
+    // Sensor reports or frame detections, which can be clustered and/or tracked
+    DetectionClusterer m_clusterer;
+    bool m_clusteringEnabled;
+    MultiTargetTracker m_tracker;
+    std::vector<Detection> m_detections;
+    TrackSnapshotPtr m_hostInput;
+    TrackSnapshotPtr m_outputTracks;
+    SnapshotPool<TargetTrackData> m_hostPool;
+
+    ZoneEngine m_zoneEngine;
+    std::vector<ZoneEvent> m_zoneEvents;
+    TrackSnapshotPtr m_zoneInput;
+};
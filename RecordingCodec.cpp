@@ -0,0 +1,262 @@
+#include "RecordingCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const int HASH_BITS = 14;
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 65535;
+const size_t END_LITERALS = 8;    // The last bytes are always literals
+
+inline uint32_t load32(const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t load64(const uint8_t* p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash32(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+inline size_t countTrailingZeroBytes(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return size_t(__builtin_ctzll(value)) / 8;
+#else
+    size_t bytes = 0;
+    while ((value & 0xFF) == 0) {
+        value >>= 8;
+        ++bytes;
+    }
+    return bytes;
+#endif
+}
+
+uint8_t* writeLength(uint8_t* out, size_t length)
+{
+    // Continuation of a nibble that was saturated at 15
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = uint8_t(length);
+    return out;
+}
+
+uint8_t* writeSequence(uint8_t* out, const uint8_t* literals, size_t literalCount,
+                       size_t offset, size_t matchLength)
+{
+    uint8_t* token = out++;
+    *token = uint8_t((literalCount < 15 ? literalCount : 15) << 4);
+    if (literalCount >= 15) {
+        out = writeLength(out, literalCount - 15);
+    }
+    std::memcpy(out, literals, literalCount);
+    out += literalCount;
+
+    if (matchLength == 0) return out;  // Final literals-only sequence
+
+    *out++ = uint8_t(offset);
+    *out++ = uint8_t(offset >> 8);
+    const size_t extra = matchLength - MIN_MATCH;
+    *token |= uint8_t(extra < 15 ? extra : 15);
+    if (extra >= 15) {
+        out = writeLength(out, extra - 15);
+    }
+    return out;
+}
+
+size_t lzCompress(const uint8_t* in, size_t size, uint8_t* out, uint32_t* table)
+{
+    std::memset(table, 0, (size_t(1) << HASH_BITS) * sizeof(uint32_t));
+    uint8_t* const start = out;
+
+    size_t anchor = 0;
+    size_t pos = 1;
+    if (size > END_LITERALS + MIN_MATCH) {
+        const size_t limit = size - END_LITERALS - MIN_MATCH;
+        table[hash32(load32(in))] = 0;
+        while (pos <= limit) {
+            const uint32_t sequence = load32(in + pos);
+            const uint32_t h = hash32(sequence);
+            const size_t candidate = table[h];
+            table[h] = uint32_t(pos);
+
+            if (pos - candidate > MAX_OFFSET || load32(in + candidate) != sequence) {
+                // Skip faster through data that does not compress
+                pos += 1 + ((pos - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match eight bytes at a time
+            size_t length = MIN_MATCH;
+            const size_t maxLength = size - END_LITERALS - pos;
+            for (;;) {
+                if (length + 8 > maxLength) {
+                    while (length < maxLength && in[pos + length] == in[candidate + length]) {
+                        ++length;
+                    }
+                    break;
+                }
+                const uint64_t diff = load64(in + pos + length) ^ load64(in + candidate + length);
+                if (diff) {
+                    length += countTrailingZeroBytes(diff);
+                    break;
+                }
+                length += 8;
+            }
+
+            out = writeSequence(out, in + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+            if (pos <= limit) {
+                table[hash32(load32(in + pos - 2))] = uint32_t(pos - 2);
+            }
+        }
+    }
+    out = writeSequence(out, in + anchor, size - anchor, 0, 0);
+    return size_t(out - start);
+}
+
+bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length)
+{
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool lzDecompress(const uint8_t* in, size_t size, uint8_t* out, size_t outSize)
+{
+    const uint8_t* const end = in + size;
+    size_t written = 0;
+
+    while (in < end) {
+        const uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(in, end, literalCount)) return false;
+        if (literalCount > size_t(end - in) || literalCount > outSize - written) return false;
+        std::memcpy(out + written, in, literalCount);
+        in += literalCount;
+        written += literalCount;
+
+        if (in == end) break;  // Final sequence has no match
+
+        if (end - in < 2) return false;
+        const size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(in, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > written || matchLength > outSize - written) return false;
+
+        uint8_t* dst = out + written;
+        if (offset >= matchLength) {
+            std::memcpy(dst, dst - offset, matchLength);
+        } else {
+            // Overlapping match repeats the last offset bytes: copy in
+            // non-overlapping blocks, doubling the distance as the run grows
+            size_t distance = offset;
+            size_t copied = 0;
+            while (copied < matchLength) {
+                const size_t count = std::min(distance, matchLength - copied);
+                std::memcpy(dst + copied, dst + copied - distance, count);
+                copied += count;
+                if (2 * distance <= copied + offset) distance *= 2;
+            }
+        }
+        written += matchLength;
+    }
+    return written == outSize;
+}
+
+// XOR each 32-bit word with the one two words back, then split into byte planes
+void shuffleEncode(const uint8_t* in, size_t size, uint8_t* out)
+{
+    const size_t words = size / 4;
+    uint8_t* planes[4] = {out, out + words, out + 2 * words, out + 3 * words};
+    for (size_t i = 0; i < words; ++i) {
+        uint32_t word = load32(in + 4 * i);
+        if (i >= 2) {
+            word ^= load32(in + 4 * (i - 2));
+        }
+        planes[0][i] = uint8_t(word);
+        planes[1][i] = uint8_t(word >> 8);
+        planes[2][i] = uint8_t(word >> 16);
+        planes[3][i] = uint8_t(word >> 24);
+    }
+    std::memcpy(out + 4 * words, in + 4 * words, size - 4 * words);
+}
+
+void shuffleDecode(const uint8_t* in, size_t size, uint8_t* out)
+{
+    const size_t words = size / 4;
+    const uint8_t* planes[4] = {in, in + words, in + 2 * words, in + 3 * words};
+    for (size_t i = 0; i < words; ++i) {
+        uint32_t word = uint32_t(planes[0][i]) | (uint32_t(planes[1][i]) << 8)
+                      | (uint32_t(planes[2][i]) << 16) | (uint32_t(planes[3][i]) << 24);
+        if (i >= 2) {
+            word ^= load32(out + 4 * (i - 2));
+        }
+        std::memcpy(out + 4 * i, &word, sizeof(word));
+    }
+    std::memcpy(out + 4 * words, in + 4 * words, size - 4 * words);
+}
+
+} // namespace
+
+namespace RecordingCodec {
+
+size_t maxEncodedSize(size_t rawSize)
+{
+    // Incompressible input costs one extra byte per 255 literals
+    return rawSize + rawSize / 255 + 16;
+}
+
+size_t encode(Recording::ChunkCodec codec, const uint8_t* raw, size_t rawSize,
+              uint8_t* out, std::vector<uint8_t>& scratch)
+{
+    if (codec != Recording::CodecShuffleLZ || rawSize == 0) return 0;
+
+    // Scratch holds the shuffled bytes followed by the hash table
+    const size_t tableOffset = size_t(Recording::paddedSize(rawSize));
+    scratch.resize(tableOffset + (size_t(1) << HASH_BITS) * sizeof(uint32_t));
+    shuffleEncode(raw, rawSize, scratch.data());
+
+    uint32_t* table = reinterpret_cast<uint32_t*>(scratch.data() + tableOffset);
+    const size_t encoded = lzCompress(scratch.data(), rawSize, out, table);
+    return encoded < rawSize ? encoded : 0;
+}
+
+bool decode(Recording::ChunkCodec codec, const uint8_t* stored, size_t storedSize,
+            uint8_t* raw, size_t rawSize, std::vector<uint8_t>& scratch)
+{
+    switch (codec) {
+    case Recording::CodecNone:
+        if (storedSize != rawSize) return false;
+        std::memcpy(raw, stored, rawSize);
+        return true;
+    case Recording::CodecShuffleLZ:
+        scratch.resize(rawSize);
+        if (!lzDecompress(stored, storedSize, scratch.data(), rawSize)) return false;
+        shuffleDecode(scratch.data(), rawSize, raw);
+        return true;
+    }
+    return false;
+}
+
+} // namespace RecordingCodec
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RecordingFormat.h"
+
+// Chunk payload codecs for recordings.
+//
+// CodecShuffleLZ is tuned for I/Q sample streams: every 32-bit word is XORed
+// with the word two positions back (the same I or Q lane of the previous
+// sample), which clears the sign, exponent and high mantissa bits that
+// neighbouring samples share. The words are then split into four byte
+// planes so those cleared bytes form long runs, and the planes are packed
+// with a byte-oriented LZ77 (LZ4-style sequences, 64 KiB window).
+// Everything is self-contained and allocation-free once the scratch buffer
+// has grown.
+namespace RecordingCodec {
+
+// Output buffer size that encode() may need for rawSize input bytes
+size_t maxEncodedSize(size_t rawSize);
+
+// Encodes raw into out (at least maxEncodedSize(rawSize) bytes).
+// Returns the encoded size, or 0 when the payload does not shrink and
+// should be stored as CodecNone.
+size_t encode(Recording::ChunkCodec codec, const uint8_t* raw, size_t rawSize,
+              uint8_t* out, std::vector<uint8_t>& scratch);
+
+// Decodes exactly rawSize bytes into raw; false if the data is damaged
+bool decode(Recording::ChunkCodec codec, const uint8_t* stored, size_t storedSize,
+            uint8_t* raw, size_t rawSize, std::vector<uint8_t>& scratch);
+
+} // namespace RecordingCodec
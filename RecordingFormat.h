@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout of a recording (.radrec). All fields are little-endian and
+// every structure is naturally aligned with no padding, so a mapped file can
+// be read in place.
+//
+//   RecordingFileHeader
+//   chunk 0: RecordingChunkHeader, RecordingChunkSummary, payload (records),
+//            padding to 8 bytes
+//   chunk 1: ...
+//   RecordingIndexEntry[chunkCount]      -- written on close
+//   RecordingFooter                      -- last 32 bytes of the file
+//
+// A payload is a sequence of RecordingRecordHeader + data, each record padded
+// to 8 bytes. It is stored as is or encoded with the chunk's codec
+// (storedSize bytes on disk, rawSize once decoded). The summary is never
+// encoded, so queries can skip chunks without decoding them. Chunks are self-describing, so a file whose writer died before
+// the index was written can still be read by scanning the chunk headers.
+
+namespace Recording {
+
+const char FILE_MAGIC[8] = {'R', 'A', 'D', 'R', 'E', 'C', '\0', '\1'};
+const uint32_t CHUNK_MAGIC = 0x4B4E4843;   // "CHNK"
+const uint32_t FOOTER_MAGIC = 0x58444952;  // "RIDX"
+const uint32_t FORMAT_VERSION = 3;   // 2: compressed chunks, 3: chunk summaries
+
+enum RecordType : uint16_t {
+    RecordDatagram = 1,   // Datagram exactly as received
+    RecordTracks = 2,     // TargetTrackData, serialized as a binary datagram
+    RecordADCFrame = 3    // RawADCFrameTest, serialized as a binary datagram
+};
+
+enum ChunkCodec : uint16_t {
+    CodecNone = 0,
+    CodecShuffleLZ = 1    // XOR-delta + byte shuffle + LZ, see RecordingCodec.h
+};
+
+enum ChunkFlags : uint16_t {
+    ChunkHasSummary = 1   // A RecordingChunkSummary follows the chunk header
+};
+
+// Record and chunk payloads start on 8-byte boundaries
+inline uint64_t paddedSize(uint64_t size) { return (size + 7) & ~uint64_t(7); }
+
+} // namespace Recording
+
+struct RecordingFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;          // sizeof(RecordingFileHeader)
+    uint64_t createdMicroseconds; // Unix epoch
+    uint64_t reserved[5];
+};
+
+struct RecordingChunkHeader {
+    uint32_t magic;
+    uint32_t chunkIndex;
+    uint64_t firstTimestamp;      // Microseconds, Unix epoch
+    uint64_t lastTimestamp;
+    uint64_t firstRecord;         // Sequence number of the first record in the file
+    uint32_t recordCount;
+    uint32_t storedSize;          // Payload bytes following this header (before padding)
+    uint32_t rawSize;             // Payload bytes once decoded
+    uint16_t codec;               // Recording::ChunkCodec
+    uint16_t flags;
+    uint32_t reserved[4];
+};
+
+// Content statistics of one chunk. Range and speed cover every track in
+// the chunk's track snapshots; fields with no data keep their initial
+// (empty-range) values.
+struct RecordingChunkSummary {
+    uint32_t trackFrames;         // Track snapshots summarized
+    uint32_t maxTrackCount;       // Most tracks in one snapshot
+    uint32_t adcFrames;           // ADC frames summarized
+    uint32_t reserved0;
+    float minRange;               // m; +FLT_MAX when there were no tracks
+    float maxRange;               // m; -FLT_MAX when there were no tracks
+    float minRadialSpeed;         // m/s
+    float maxRadialSpeed;
+    float peakMagnitudeDb;        // Largest range-spectrum bin, dB full scale; -FLT_MAX without ADC frames
+    uint32_t reserved[7];
+};
+
+struct RecordingRecordHeader {
+    uint64_t timestamp;           // Microseconds, Unix epoch
+    uint32_t size;                // Data bytes following this header (before padding)
+    uint16_t type;                // Recording::RecordType
+    uint16_t flags;
+};
+
+struct RecordingIndexEntry {
+    uint64_t offset;              // File offset of the chunk header
+    uint64_t firstTimestamp;
+    uint64_t lastTimestamp;
+    uint64_t firstRecord;
+    uint32_t recordCount;
+    uint32_t reserved;
+};
+
+struct RecordingFooter {
+    uint64_t indexOffset;
+    uint64_t chunkCount;
+    uint64_t recordCount;
+    uint32_t version;
+    uint32_t magic;               // Recording::FOOTER_MAGIC, the file's last 4 bytes
+};
+
+static_assert(sizeof(RecordingFileHeader) == 64, "RecordingFileHeader size changed");
+static_assert(sizeof(RecordingChunkHeader) == 64, "RecordingChunkHeader size changed");
+static_assert(sizeof(RecordingChunkSummary) == 64, "RecordingChunkSummary size changed");
+static_assert(sizeof(RecordingRecordHeader) == 16, "RecordingRecordHeader size changed");
+static_assert(sizeof(RecordingIndexEntry) == 40, "RecordingIndexEntry size changed");
+static_assert(sizeof(RecordingFooter) == 32, "RecordingFooter size changed");
@@ -0,0 +1,270 @@
+#include "RecordingQuery.h"
+#include "WireFormat.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+RecordingQuery::Criteria::Criteria()
+    : startTime(0)
+    , endTime(UINT64_MAX)
+    , minRange(-FLT_MAX)
+    , maxRange(FLT_MAX)
+    , minSpeed(0.0f)
+    , maxSpeed(FLT_MAX)
+    , minTracks(0)
+    , minPeakDb(-FLT_MAX)
+{
+}
+
+bool RecordingQuery::Criteria::hasTrackCriteria() const
+{
+    return minRange > -FLT_MAX || maxRange < FLT_MAX || minSpeed > 0.0f || maxSpeed < FLT_MAX || minTracks > 0;
+}
+
+bool RecordingQuery::Criteria::hasSpectrumCriteria() const
+{
+    return minPeakDb > -FLT_MAX;
+}
+
+RecordingQuery::RecordingQuery(RecordingReader& reader)
+    : m_reader(reader)
+    , m_mergeGap(1000000)
+    , m_stats()
+{
+}
+
+bool RecordingQuery::summaryMayMatch(const Criteria& criteria, const RecordingChunkSummary& summary) const
+{
+    return (!criteria.hasTrackCriteria() || summaryMayMatchTracks(criteria, summary))
+        && (!criteria.hasSpectrumCriteria() || summaryMayMatchSpectrum(criteria, summary));
+}
+
+bool RecordingQuery::summaryMayMatchTracks(const Criteria& criteria, const RecordingChunkSummary& summary) const
+{
+    if (summary.trackFrames == 0 || summary.maxTrackCount < std::max(criteria.minTracks, 1u)) return false;
+    if (summary.maxRange < criteria.minRange || summary.minRange > criteria.maxRange) return false;
+
+    // Some radial speed in [minSpeed, maxSpeed] or [-maxSpeed, -minSpeed]
+    const bool approaching = summary.maxRadialSpeed >= criteria.minSpeed
+                          && summary.minRadialSpeed <= criteria.maxSpeed;
+    const bool receding = summary.minRadialSpeed <= -criteria.minSpeed
+                       && summary.maxRadialSpeed >= -criteria.maxSpeed;
+    return approaching || receding;
+}
+
+bool RecordingQuery::summaryMayMatchSpectrum(const Criteria& criteria, const RecordingChunkSummary& summary) const
+{
+    return summary.adcFrames > 0 && summary.peakMagnitudeDb >= criteria.minPeakDb;
+}
+
+void RecordingQuery::candidateChunks(const Criteria& criteria, std::vector<size_t>& chunks)
+{
+    chunks.clear();
+    m_stats = Stats();
+
+    if (criteria.hasTrackCriteria() && criteria.hasSpectrumCriteria()) {
+        coincidentCandidateChunks(criteria, chunks);
+        return;
+    }
+
+    for (size_t i = m_reader.findChunkByTime(criteria.startTime); i < m_reader.chunkCount(); ++i) {
+        const RecordingIndexEntry& entry = m_reader.chunk(i);
+        if (entry.firstTimestamp > criteria.endTime) break;
+        ++m_stats.chunks;
+
+        RecordingChunkSummary summary;
+        if (m_reader.chunkSummary(i, summary) && !summaryMayMatch(criteria, summary)) {
+            ++m_stats.chunksSkipped;
+            continue;
+        }
+        chunks.push_back(i);
+    }
+}
+
+// With both kinds of criteria the two matches may sit in neighbouring
+// chunks: a chunk is a candidate when it may match one kind and it, or a
+// chunk within the merge gap, may match the other
+void RecordingQuery::coincidentCandidateChunks(const Criteria& criteria, std::vector<size_t>& chunks)
+{
+    enum { MayMatchTracks = 1, MayMatchSpectrum = 2 };
+
+    const size_t first = m_reader.findChunkByTime(criteria.startTime);
+    m_chunkFlags.clear();
+    for (size_t i = first; i < m_reader.chunkCount(); ++i) {
+        if (m_reader.chunk(i).firstTimestamp > criteria.endTime) break;
+        ++m_stats.chunks;
+
+        RecordingChunkSummary summary;
+        uint8_t flags = MayMatchTracks | MayMatchSpectrum;
+        if (m_reader.chunkSummary(i, summary)) {
+            flags = uint8_t((summaryMayMatchTracks(criteria, summary) ? MayMatchTracks : 0)
+                          | (summaryMayMatchSpectrum(criteria, summary) ? MayMatchSpectrum : 0));
+        }
+        m_chunkFlags.push_back(flags);
+    }
+
+    for (size_t k = 0; k < m_chunkFlags.size(); ++k) {
+        uint8_t flags = m_chunkFlags[k];
+        if (flags != 0 && flags != (MayMatchTracks | MayMatchSpectrum)) {
+            const RecordingIndexEntry& entry = m_reader.chunk(first + k);
+            for (size_t j = k; j-- > 0;) {
+                if (m_reader.chunk(first + j).lastTimestamp + m_mergeGap < entry.firstTimestamp) break;
+                flags |= m_chunkFlags[j];
+            }
+            for (size_t j = k + 1; j < m_chunkFlags.size(); ++j) {
+                if (m_reader.chunk(first + j).firstTimestamp > entry.lastTimestamp + m_mergeGap) break;
+                flags |= m_chunkFlags[j];
+            }
+        }
+        if (flags != (MayMatchTracks | MayMatchSpectrum)) {
+            ++m_stats.chunksSkipped;
+            continue;
+        }
+        chunks.push_back(first + k);
+    }
+}
+
+bool RecordingQuery::tracksMatch(const Criteria& criteria, const TargetTrackData& tracks) const
+{
+    const uint32_t needed = std::max(criteria.minTracks, 1u);
+    uint32_t found = 0;
+    for (const TargetTrack& target : tracks.targets) {
+        const float speed = std::fabs(target.radial_speed);
+        if (target.radius >= criteria.minRange && target.radius <= criteria.maxRange
+            && speed >= criteria.minSpeed && speed <= criteria.maxSpeed
+            && ++found >= needed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RecordingQuery::addMatch(uint64_t timestamp, std::vector<Match>& matches) const
+{
+    if (!matches.empty()) {
+        Match& last = matches.back();
+        if (timestamp >= last.firstTimestamp && timestamp <= last.lastTimestamp + m_mergeGap) {
+            last.lastTimestamp = std::max(last.lastTimestamp, timestamp);
+            ++last.frames;
+            return;
+        }
+    }
+    matches.push_back(Match{timestamp, timestamp, 1});
+}
+
+namespace {
+
+// Whether sorted times holds one within gap of t; t must not decrease
+// between calls with the same cursor
+bool hasNearby(const std::vector<uint64_t>& times, size_t& cursor, uint64_t t, uint64_t gap)
+{
+    while (cursor < times.size() && times[cursor] < t && t - times[cursor] > gap) ++cursor;
+    return cursor < times.size() && (times[cursor] <= t || times[cursor] - t <= gap);
+}
+
+} // namespace
+
+void RecordingQuery::addCoincidentMatches(std::vector<Match>& matches)
+{
+    std::sort(m_trackTimes.begin(), m_trackTimes.end());
+    std::sort(m_frameTimes.begin(), m_frameTimes.end());
+
+    // Both lists in time order, each timestamp checked against the other list
+    size_t t = 0;
+    size_t f = 0;
+    size_t trackCursor = 0;
+    size_t frameCursor = 0;
+    while (t < m_trackTimes.size() || f < m_frameTimes.size()) {
+        if (f == m_frameTimes.size() || (t < m_trackTimes.size() && m_trackTimes[t] <= m_frameTimes[f])) {
+            const uint64_t timestamp = m_trackTimes[t++];
+            if (hasNearby(m_frameTimes, frameCursor, timestamp, m_mergeGap)) addMatch(timestamp, matches);
+        } else {
+            const uint64_t timestamp = m_frameTimes[f++];
+            if (hasNearby(m_trackTimes, trackCursor, timestamp, m_mergeGap)) addMatch(timestamp, matches);
+        }
+    }
+}
+
+void RecordingQuery::run(const Criteria& criteria, std::vector<Match>& matches)
+{
+    matches.clear();
+    std::vector<size_t> chunks;
+    candidateChunks(criteria, chunks);
+
+    // Each kind of criteria is answered by its own kind of record; with
+    // neither, every track snapshot and ADC frame matches
+    const bool trackCriteria = criteria.hasTrackCriteria();
+    const bool spectrumCriteria = criteria.hasSpectrumCriteria();
+    const bool wantTracks = trackCriteria || !spectrumCriteria;
+    const bool wantFrames = spectrumCriteria || !trackCriteria;
+    const bool coincident = trackCriteria && spectrumCriteria;
+    m_trackTimes.clear();
+    m_frameTimes.clear();
+
+    uint64_t lastDatagram = 0;
+    for (size_t chunk : chunks) {
+        const RecordingIndexEntry& entry = m_reader.chunk(chunk);
+        if (!m_reader.seekToRecord(entry.firstRecord)) continue;
+        ++m_stats.chunksDecoded;
+
+        RecordingReader::Record record;
+        for (uint32_t n = 0; n < entry.recordCount && m_reader.next(record); ++n) {
+            if (record.timestamp < criteria.startTime || record.timestamp > criteria.endTime) continue;
+
+            // Decoded snapshots stamped like the datagram before them came from it
+            if (record.type == Recording::RecordDatagram) {
+                lastDatagram = record.timestamp;
+            } else if (record.timestamp == lastDatagram) {
+                continue;
+            }
+
+            // Binary messages that cannot match are not decoded at all
+            MessageHeader header;
+            if (WireFormat::deserializeHeader(record.data, record.size, header)) {
+                if (header.type == MessageType::TARGET_TRACK_DATA && !wantTracks) continue;
+                if (header.type == MessageType::RAW_ADC_DATA && !wantFrames) continue;
+            }
+
+            ++m_stats.recordsTested;
+            const int decoded = m_decoder.decode(reinterpret_cast<const char*>(record.data), record.size,
+                                                 m_tracks, m_frame);
+            bool trackMatched = false;
+            bool frameMatched = false;
+            if ((decoded & DatagramDecoder::DecodedTracks) && wantTracks) {
+                trackMatched = !trackCriteria || tracksMatch(criteria, *m_tracks);
+            }
+            if ((decoded & DatagramDecoder::DecodedADCFrame) && wantFrames && (coincident || !trackMatched)) {
+                frameMatched = !spectrumCriteria || m_spectrum.peakSpectrumDb(*m_frame) >= criteria.minPeakDb;
+            }
+            if (coincident) {
+                if (trackMatched) m_trackTimes.push_back(record.timestamp);
+                if (frameMatched) m_frameTimes.push_back(record.timestamp);
+            } else if (trackMatched || frameMatched) {
+                addMatch(record.timestamp, matches);
+            }
+        }
+    }
+
+    if (coincident) {
+        addCoincidentMatches(matches);
+    }
+}
+
+void RecordingQuery::runSummaries(const Criteria& criteria, std::vector<Match>& matches)
+{
+    matches.clear();
+    std::vector<size_t> chunks;
+    candidateChunks(criteria, chunks);
+
+    for (size_t chunk : chunks) {
+        const RecordingIndexEntry& entry = m_reader.chunk(chunk);
+        const uint64_t first = std::max(entry.firstTimestamp, criteria.startTime);
+        const uint64_t last = std::min(entry.lastTimestamp, criteria.endTime);
+        if (!matches.empty() && first <= matches.back().lastTimestamp + m_mergeGap) {
+            matches.back().lastTimestamp = std::max(matches.back().lastTimestamp, last);
+            matches.back().frames += entry.recordCount;
+        } else {
+            matches.push_back(Match{first, last, entry.recordCount});
+        }
+    }
+}
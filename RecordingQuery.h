@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+#include "DatagramDecoder.h"
+#include "RecordingReader.h"
+#include "RecordingSummarizer.h"
+
+// Finds the stretches of a recording whose content matches a set of
+// criteria, e.g. "a track between 19 and 21 m moving faster than 10 m/s".
+//
+// Chunks are first pruned on their RecordingChunkSummary, which is read
+// straight from the mapping, so a multi-GB recording is answered after
+// touching one page per chunk. Only the remaining candidate chunks are
+// decoded, and their track snapshots (and ADC frames, for the spectrum
+// criterion) are tested one by one. Matching frames closer together than
+// the merge gap form one match.
+//
+// Track criteria apply to track snapshots and the spectrum criterion to
+// ADC frames. When both are given, a matching frame of either kind only
+// counts if a frame of the other kind also matched within the merge gap.
+class RecordingQuery
+{
+public:
+    struct Criteria {
+        uint64_t startTime;       // Microseconds, Unix epoch; 0 = from the start
+        uint64_t endTime;         // UINT64_MAX = to the end
+        float minRange;           // A track with range in [minRange, maxRange] m
+        float maxRange;
+        float minSpeed;           // and |radial speed| in [minSpeed, maxSpeed] m/s
+        float maxSpeed;
+        uint32_t minTracks;       // At least this many such tracks in one snapshot
+        float minPeakDb;          // ADC frame range-spectrum peak, dB full scale
+
+        Criteria();
+        bool hasTrackCriteria() const;
+        bool hasSpectrumCriteria() const;
+    };
+
+    struct Match {
+        uint64_t firstTimestamp;
+        uint64_t lastTimestamp;
+        uint64_t frames;          // Matching snapshots/frames (runSummaries: records)
+    };
+
+    struct Stats {
+        size_t chunks;            // Chunks in the time range
+        size_t chunksSkipped;     // Ruled out by their summary
+        size_t chunksDecoded;
+        uint64_t recordsTested;
+    };
+
+    explicit RecordingQuery(RecordingReader& reader);
+
+    // Matches closer together than this are merged (default 1 s)
+    void setMergeGap(uint64_t microseconds) { m_mergeGap = microseconds; }
+
+    // Chunks whose summary does not rule out a match. Chunks written
+    // without a summary are always candidates.
+    void candidateChunks(const Criteria& criteria, std::vector<size_t>& chunks);
+
+    // Exact matches, from the records of the candidate chunks
+    void run(const Criteria& criteria, std::vector<Match>& matches);
+
+    // Summary-only answer: the time spans of the candidate chunks. Never
+    // misses a match, but may over-report.
+    void runSummaries(const Criteria& criteria, std::vector<Match>& matches);
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    bool summaryMayMatch(const Criteria& criteria, const RecordingChunkSummary& summary) const;
+    bool summaryMayMatchTracks(const Criteria& criteria, const RecordingChunkSummary& summary) const;
+    bool summaryMayMatchSpectrum(const Criteria& criteria, const RecordingChunkSummary& summary) const;
+    void coincidentCandidateChunks(const Criteria& criteria, std::vector<size_t>& chunks);
+    bool tracksMatch(const Criteria& criteria, const TargetTrackData& tracks) const;
+    void addMatch(uint64_t timestamp, std::vector<Match>& matches) const;
+    void addCoincidentMatches(std::vector<Match>& matches);
+
+    RecordingReader& m_reader;
+    uint64_t m_mergeGap;
+    Stats m_stats;
+
+    DatagramDecoder m_decoder;
+    TrackSnapshotPtr m_tracks;
+    ADCFramePtr m_frame;
+    RecordingSummarizer m_spectrum;
+
+    // Per-kind summary results and matching timestamps, while both kinds
+    // of criteria are given
+    std::vector<uint8_t> m_chunkFlags;
+    std::vector<uint64_t> m_trackTimes;
+    std::vector<uint64_t> m_frameTimes;
+};
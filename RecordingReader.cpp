@@ -0,0 +1,411 @@
+#include "RecordingReader.h"
+#include "RecordingCodec.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Bytes between the start of a chunk and its payload
+uint64_t chunkPrefixSize(const RecordingChunkHeader& header)
+{
+    return sizeof(RecordingChunkHeader)
+        + ((header.flags & Recording::ChunkHasSummary) ? sizeof(RecordingChunkSummary) : 0);
+}
+
+} // namespace
+
+RecordingReader::RecordingReader()
+    : m_data(nullptr)
+    , m_size(0)
+#ifdef _WIN32
+    , m_fileHandle(nullptr)
+    , m_mappingHandle(nullptr)
+#else
+    , m_fd(-1)
+#endif
+    , m_recordCount(0)
+    , m_hasIndex(false)
+    , m_chunk(0)
+    , m_payload(nullptr)
+    , m_payloadSize(0)
+    , m_payloadOffset(0)
+    , m_nextSequence(0)
+    , m_readAheadChunk(0)
+{
+}
+
+RecordingReader::~RecordingReader()
+{
+    close();
+}
+
+bool RecordingReader::open(const std::string& path, std::string* error)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        if (error) *error = "Cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        if (error) *error = path + " is empty";
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        if (error) *error = "Cannot map " + path;
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_size = uint64_t(size.QuadPart);
+    m_data = static_cast<const uint8_t*>(view);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "Cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        if (error) *error = path + " is empty";
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        if (error) *error = "Cannot map " + path;
+        return false;
+    }
+    // Replay walks the file front to back: aggressive readahead, early reclaim
+    madvise(view, size_t(info.st_size), MADV_SEQUENTIAL);
+    m_fd = fd;
+    m_size = uint64_t(info.st_size);
+    m_data = static_cast<const uint8_t*>(view);
+#endif
+
+    RecordingFileHeader header;
+    if (m_size < sizeof(header)) {
+        close();
+        if (error) *error = path + " is not a recording";
+        return false;
+    }
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, Recording::FILE_MAGIC, sizeof(header.magic)) != 0) {
+        close();
+        if (error) *error = path + " is not a recording";
+        return false;
+    }
+    if (header.version > Recording::FORMAT_VERSION || header.headerSize < sizeof(header)) {
+        close();
+        if (error) *error = path + " was written by a newer version";
+        return false;
+    }
+
+    m_hasIndex = readFooterIndex();
+    if (!m_hasIndex) {
+        scanChunks();
+    }
+    m_recordCount = 0;
+    for (const RecordingIndexEntry& entry : m_index) {
+        m_recordCount = std::max(m_recordCount, entry.firstRecord + entry.recordCount);
+    }
+
+    rewind();
+    return true;
+}
+
+void RecordingReader::close()
+{
+    cancelReadAhead();
+    if (m_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_data), size_t(m_size));
+        ::close(m_fd);
+        m_fd = -1;
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_index.clear();
+    m_recordCount = 0;
+    m_hasIndex = false;
+    m_chunk = 0;
+    m_payload = nullptr;
+    m_payloadSize = 0;
+    m_payloadOffset = 0;
+    m_nextSequence = 0;
+}
+
+bool RecordingReader::readFooterIndex()
+{
+    if (m_size < sizeof(RecordingFileHeader) + sizeof(RecordingFooter)) return false;
+
+    RecordingFooter footer;
+    std::memcpy(&footer, m_data + m_size - sizeof(footer), sizeof(footer));
+    if (footer.magic != Recording::FOOTER_MAGIC) return false;
+
+    // Checked by subtraction: a damaged footer near 2^64 must not wrap past the tests
+    const uint64_t indexEnd = m_size - sizeof(footer);
+    if (footer.indexOffset < sizeof(RecordingFileHeader) || footer.indexOffset > indexEnd
+        || footer.chunkCount > indexEnd / sizeof(RecordingIndexEntry)) {
+        return false;
+    }
+    const uint64_t indexBytes = footer.chunkCount * sizeof(RecordingIndexEntry);
+    if (indexBytes != indexEnd - footer.indexOffset) return false;
+
+    m_index.resize(size_t(footer.chunkCount));
+    std::memcpy(m_index.data(), m_data + footer.indexOffset, size_t(indexBytes));
+
+    // Trust the index only as far as it points at real chunk headers
+    for (const RecordingIndexEntry& entry : m_index) {
+        uint32_t magic;
+        if (footer.indexOffset < sizeof(RecordingChunkHeader)
+            || entry.offset > footer.indexOffset - sizeof(RecordingChunkHeader)) {
+            return false;
+        }
+        std::memcpy(&magic, m_data + entry.offset, sizeof(magic));
+        if (magic != Recording::CHUNK_MAGIC) return false;
+    }
+    return true;
+}
+
+void RecordingReader::scanChunks()
+{
+    // The writer died before close(): walk the self-describing chunk headers
+    // and stop at the first one that is truncated or damaged
+    m_index.clear();
+    uint64_t offset = sizeof(RecordingFileHeader);
+    while (offset + sizeof(RecordingChunkHeader) <= m_size) {
+        RecordingChunkHeader header;
+        std::memcpy(&header, m_data + offset, sizeof(header));
+        const uint64_t chunkBytes = chunkPrefixSize(header) + Recording::paddedSize(header.storedSize);
+        if (header.magic != Recording::CHUNK_MAGIC || offset + chunkBytes > m_size) break;
+
+        RecordingIndexEntry entry = RecordingIndexEntry();
+        entry.offset = offset;
+        entry.firstTimestamp = header.firstTimestamp;
+        entry.lastTimestamp = header.lastTimestamp;
+        entry.firstRecord = header.firstRecord;
+        entry.recordCount = header.recordCount;
+        m_index.push_back(entry);
+
+        offset += chunkBytes;
+    }
+}
+
+bool RecordingReader::chunkSummary(size_t chunkIndex, RecordingChunkSummary& summary) const
+{
+    const RecordingIndexEntry& entry = m_index[chunkIndex];
+    RecordingChunkHeader header;
+    std::memcpy(&header, m_data + entry.offset, sizeof(header));
+    if (!(header.flags & Recording::ChunkHasSummary)
+        || m_size < sizeof(header) + sizeof(summary)
+        || entry.offset > m_size - sizeof(header) - sizeof(summary)) {
+        return false;
+    }
+    std::memcpy(&summary, m_data + entry.offset + sizeof(header), sizeof(summary));
+    return true;
+}
+
+uint64_t RecordingReader::firstTimestamp() const
+{
+    return m_index.empty() ? 0 : m_index.front().firstTimestamp;
+}
+
+uint64_t RecordingReader::lastTimestamp() const
+{
+    return m_index.empty() ? 0 : m_index.back().lastTimestamp;
+}
+
+size_t RecordingReader::findChunkByTime(uint64_t timestamp) const
+{
+    // First chunk that still holds a record at or after the timestamp
+    auto it = std::partition_point(m_index.begin(), m_index.end(),
+                                   [timestamp](const RecordingIndexEntry& entry) {
+                                       return entry.lastTimestamp < timestamp;
+                                   });
+    return size_t(it - m_index.begin());
+}
+
+size_t RecordingReader::findChunkByRecord(uint64_t sequence) const
+{
+    auto it = std::partition_point(m_index.begin(), m_index.end(),
+                                   [sequence](const RecordingIndexEntry& entry) {
+                                       return entry.firstRecord + entry.recordCount <= sequence;
+                                   });
+    return size_t(it - m_index.begin());
+}
+
+bool RecordingReader::seekToTime(uint64_t timestamp)
+{
+    if (!enterChunk(findChunkByTime(timestamp))) return false;
+
+    // Chunks span at most a second, so a linear walk inside one is cheap
+    while (m_payloadOffset + sizeof(RecordingRecordHeader) <= m_payloadSize) {
+        RecordingRecordHeader header;
+        std::memcpy(&header, m_payload + m_payloadOffset, sizeof(header));
+        if (header.timestamp >= timestamp) return true;
+        m_payloadOffset += sizeof(header) + size_t(Recording::paddedSize(header.size));
+        ++m_nextSequence;
+    }
+    return enterChunk(m_chunk + 1);
+}
+
+bool RecordingReader::seekToRecord(uint64_t sequence)
+{
+    if (!enterChunk(findChunkByRecord(sequence))) return false;
+
+    while (m_nextSequence < sequence && m_payloadOffset + sizeof(RecordingRecordHeader) <= m_payloadSize) {
+        RecordingRecordHeader header;
+        std::memcpy(&header, m_payload + m_payloadOffset, sizeof(header));
+        m_payloadOffset += sizeof(header) + size_t(Recording::paddedSize(header.size));
+        ++m_nextSequence;
+    }
+    return true;
+}
+
+bool RecordingReader::next(Record& record)
+{
+    while (m_chunk < m_index.size()) {
+        if (m_payloadOffset + sizeof(RecordingRecordHeader) <= m_payloadSize) {
+            RecordingRecordHeader header;
+            std::memcpy(&header, m_payload + m_payloadOffset, sizeof(header));
+            const size_t dataOffset = m_payloadOffset + sizeof(header);
+            if (header.size <= m_payloadSize - dataOffset) {
+                record.timestamp = header.timestamp;
+                record.sequence = m_nextSequence++;
+                record.type = header.type;
+                record.data = m_payload + dataOffset;
+                record.size = header.size;
+                m_payloadOffset = dataOffset + size_t(Recording::paddedSize(header.size));
+                return true;
+            }
+        }
+        // Chunk exhausted (or a damaged record cut it short)
+        enterChunk(m_chunk + 1);
+    }
+    return false;
+}
+
+bool RecordingReader::enterChunk(size_t chunkIndex)
+{
+    // A read-ahead for another chunk is of no use any more
+    if (m_readAhead.valid() && m_readAheadChunk != chunkIndex) {
+        cancelReadAhead();
+    }
+
+    m_chunk = chunkIndex;
+    m_payload = nullptr;
+    m_payloadSize = 0;
+    m_payloadOffset = 0;
+
+    while (m_chunk < m_index.size()) {
+        const RecordingIndexEntry& entry = m_index[m_chunk];
+        m_nextSequence = entry.firstRecord;
+
+        RecordingChunkHeader header;
+        std::memcpy(&header, m_data + entry.offset, sizeof(header));
+        const uint64_t payloadOffset = entry.offset + chunkPrefixSize(header);
+        if (header.magic == Recording::CHUNK_MAGIC && payloadOffset + header.storedSize <= m_size
+            && decodeChunk(header, m_data + payloadOffset)) {
+            prefetch(m_chunk + 1);
+            return true;
+        }
+        ++m_chunk;  // Unreadable chunk: skip it
+    }
+    m_nextSequence = m_recordCount;
+    return false;
+}
+
+bool RecordingReader::decodeChunk(const RecordingChunkHeader& header, const uint8_t* stored)
+{
+    if (header.codec == Recording::CodecNone) {
+        // Records are read straight out of the mapping
+        m_payload = stored;
+        m_payloadSize = header.storedSize;
+        return true;
+    }
+
+    bool decoded;
+    if (m_readAhead.valid()) {
+        // Already being decoded for us (enterChunk dropped any other)
+        decoded = m_readAhead.get();
+        m_decoded.swap(m_readAheadDecoded);
+    } else {
+        m_decoded.resize(header.rawSize);
+        decoded = RecordingCodec::decode(Recording::ChunkCodec(header.codec), stored, header.storedSize,
+                                         m_decoded.data(), header.rawSize, m_scratch);
+    }
+    if (!decoded) return false;
+    m_payload = m_decoded.data();
+    m_payloadSize = header.rawSize;
+    return true;
+}
+
+void RecordingReader::cancelReadAhead()
+{
+    if (m_readAhead.valid()) {
+        m_readAhead.get();
+    }
+}
+
+void RecordingReader::prefetch(size_t chunkIndex)
+{
+    if (chunkIndex >= m_index.size()) return;
+
+    // Compressed chunk: decode it on a worker while this one is consumed
+    const RecordingIndexEntry& next = m_index[chunkIndex];
+    RecordingChunkHeader header;
+    std::memcpy(&header, m_data + next.offset, sizeof(header));
+    const uint64_t payloadOffset = next.offset + chunkPrefixSize(header);
+    if (header.magic == Recording::CHUNK_MAGIC && header.codec != Recording::CodecNone
+        && payloadOffset + header.storedSize <= m_size) {
+        const uint8_t* stored = m_data + payloadOffset;
+        m_readAheadChunk = chunkIndex;
+        m_readAhead = std::async(std::launch::async, [this, header, stored]() {
+            m_readAheadDecoded.resize(header.rawSize);
+            return RecordingCodec::decode(Recording::ChunkCodec(header.codec), stored, header.storedSize,
+                                          m_readAheadDecoded.data(), header.rawSize, m_readAheadScratch);
+        });
+        return;
+    }
+
+#ifndef _WIN32
+    // Start paging in the next chunk while this one is being replayed
+    static const uint64_t pageSize = uint64_t(sysconf(_SC_PAGESIZE));
+    const RecordingIndexEntry& entry = m_index[chunkIndex];
+    const uint64_t end = chunkIndex + 1 < m_index.size() ? m_index[chunkIndex + 1].offset : m_size;
+    const uint64_t begin = entry.offset & ~(pageSize - 1);
+    madvise(const_cast<uint8_t*>(m_data) + begin, size_t(end - begin), MADV_WILLNEED);
+#else
+    (void)chunkIndex;
+#endif
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+#include "RecordingFormat.h"
+
+// Read access to a .radrec recording through a read-only memory map.
+// The chunk index comes from the footer, or from a scan of the chunk
+// headers when the writer never closed the file. Seeks by timestamp or
+// record number are binary searches over the index; records are then read
+// sequentially, with the next chunk prefetched (madvise) while the current
+// one is consumed. Compressed chunks are decoded one chunk ahead on a worker
+// thread.
+class RecordingReader
+{
+public:
+    struct Record {
+        uint64_t timestamp;       // Microseconds, Unix epoch
+        uint64_t sequence;        // Record number in the file
+        uint16_t type;            // Recording::RecordType
+        const uint8_t* data;      // Valid until the next chunk is entered
+        size_t size;
+    };
+
+    RecordingReader();
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    // Whole-file information
+    uint64_t fileSize() const { return m_size; }
+    bool hasIndex() const { return m_hasIndex; }  // False: index rebuilt by scanning
+    size_t chunkCount() const { return m_index.size(); }
+    const RecordingIndexEntry& chunk(size_t index) const { return m_index[index]; }
+    uint64_t recordCount() const { return m_recordCount; }
+    uint64_t firstTimestamp() const;
+    uint64_t lastTimestamp() const;
+
+    // Content summary of a chunk, read without decoding its payload; false
+    // for chunks written before summaries existed
+    bool chunkSummary(size_t chunkIndex, RecordingChunkSummary& summary) const;
+
+    // Index lookups, O(log chunks); return chunkCount() when past the end
+    size_t findChunkByTime(uint64_t timestamp) const;
+    size_t findChunkByRecord(uint64_t sequence) const;
+
+    // Position the cursor on the first record at or after the given
+    // timestamp / with the given sequence number
+    bool seekToTime(uint64_t timestamp);
+    bool seekToRecord(uint64_t sequence);
+    void rewind() { seekToRecord(0); }
+
+    // Read the record at the cursor and advance; false at the end
+    bool next(Record& record);
+
+private:
+    bool readFooterIndex();
+    void scanChunks();
+    bool enterChunk(size_t chunkIndex);
+    bool decodeChunk(const RecordingChunkHeader& header, const uint8_t* stored);
+    void prefetch(size_t chunkIndex);
+    void cancelReadAhead();
+
+    const uint8_t* m_data;
+    uint64_t m_size;
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#else
+    int m_fd;
+#endif
+
+    std::vector<RecordingIndexEntry> m_index;
+    uint64_t m_recordCount;
+    bool m_hasIndex;
+
+    // Cursor
+    size_t m_chunk;               // Current chunk, chunkCount() when exhausted
+    const uint8_t* m_payload;     // Decoded payload of the current chunk
+    size_t m_payloadSize;
+    size_t m_payloadOffset;
+    uint64_t m_nextSequence;
+    std::vector<uint8_t> m_decoded;  // Payload of a compressed chunk
+    std::vector<uint8_t> m_scratch;
+
+    // Decoding of the following compressed chunk; owns the buffers below
+    // until it is collected
+    std::future<bool> m_readAhead;
+    size_t m_readAheadChunk;
+    std::vector<uint8_t> m_readAheadDecoded;
+    std::vector<uint8_t> m_readAheadScratch;
+};
@@ -0,0 +1,86 @@
+#include "RecordingSummarizer.h"
+#include "RadarDSP.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+RecordingSummarizer::RecordingSummarizer()
+{
+    reset();
+}
+
+void RecordingSummarizer::reset()
+{
+    m_summary = RecordingChunkSummary();
+    m_summary.minRange = FLT_MAX;
+    m_summary.maxRange = -FLT_MAX;
+    m_summary.minRadialSpeed = FLT_MAX;
+    m_summary.maxRadialSpeed = -FLT_MAX;
+    m_summary.peakMagnitudeDb = -FLT_MAX;
+}
+
+void RecordingSummarizer::addTracks(const TargetTrackData& tracks)
+{
+    ++m_summary.trackFrames;
+    m_summary.maxTrackCount = std::max(m_summary.maxTrackCount, uint32_t(tracks.targets.size()));
+
+    float minRange = m_summary.minRange;
+    float maxRange = m_summary.maxRange;
+    float minSpeed = m_summary.minRadialSpeed;
+    float maxSpeed = m_summary.maxRadialSpeed;
+    for (const TargetTrack& target : tracks.targets) {
+        minRange = std::min(minRange, target.radius);
+        maxRange = std::max(maxRange, target.radius);
+        minSpeed = std::min(minSpeed, target.radial_speed);
+        maxSpeed = std::max(maxSpeed, target.radial_speed);
+    }
+    m_summary.minRange = minRange;
+    m_summary.maxRange = maxRange;
+    m_summary.minRadialSpeed = minSpeed;
+    m_summary.maxRadialSpeed = maxSpeed;
+}
+
+void RecordingSummarizer::addADCFrame(const RawADCFrameTest& frame)
+{
+    if (frame.complex_data.empty()) return;
+
+    ++m_summary.adcFrames;
+    m_summary.peakMagnitudeDb = std::max(m_summary.peakMagnitudeDb, peakSpectrumDb(frame));
+}
+
+void RecordingSummarizer::addDatagram(const char* data, size_t size)
+{
+    const int decoded = m_decoder.decode(data, size, m_tracks, m_frame);
+    if (decoded & DatagramDecoder::DecodedTracks) {
+        addTracks(*m_tracks);
+    }
+    if (decoded & DatagramDecoder::DecodedADCFrame) {
+        addADCFrame(*m_frame);
+    }
+}
+
+float RecordingSummarizer::peakSpectrumDb(const RawADCFrameTest& frame)
+{
+    size_t count = frame.complex_data.size();
+    if (frame.num_samples_per_chirp > 0) {
+        count = std::min(count, size_t(frame.num_samples_per_chirp));
+    }
+    count = std::min(count, MAX_SPECTRUM_SAMPLES);
+    if (count == 0) return -FLT_MAX;
+
+    const size_t n = RadarDSP::nextPowerOfTwo(count);
+    m_cube.resize(1, 1, n);
+    for (size_t i = 0; i < count; ++i) {
+        m_cube.real(0, 0, i) = frame.complex_data[i].I;
+        m_cube.imag(0, 0, i) = frame.complex_data[i].Q;
+    }
+    if (m_window.size() != count) {
+        RadarDSP::hannWindow(count, m_window);
+    }
+    RadarDSP::rangeFFT(m_cube, m_window);
+
+    m_magnitudes.resize(n);
+    RadarDSP::magnitude(m_cube.chirp(0, 0), m_magnitudes.data());
+    const float peak = *std::max_element(m_magnitudes.begin(), m_magnitudes.begin() + std::max<size_t>(n / 2, 1));
+    return 20.0f * std::log10(std::max(peak / float(count), 1e-12f));
+}
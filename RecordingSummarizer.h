@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "DataStructures.h"
+#include "DatagramDecoder.h"
+#include "RadarDataCube.h"
+#include "RecordingFormat.h"
+
+// Accumulates the RecordingChunkSummary of the chunk being written: track
+// count, range and radial speed extremes of the track snapshots, and the
+// peak of each ADC frame's range spectrum. Datagrams are decoded first.
+//
+// The spectrum is the one FFTWidget shows (Hann window, FFT zero-padded to
+// a power of two) but taken over at most the first chirp, so summarizing a
+// large frame costs one short FFT.
+class RecordingSummarizer
+{
+public:
+    RecordingSummarizer();
+
+    void reset();
+    void addTracks(const TargetTrackData& tracks);
+    void addADCFrame(const RawADCFrameTest& frame);
+    void addDatagram(const char* data, size_t size);
+
+    const RecordingChunkSummary& summary() const { return m_summary; }
+
+    // Largest positive-frequency bin of the range spectrum, dB full scale
+    float peakSpectrumDb(const RawADCFrameTest& frame);
+
+private:
+    static constexpr size_t MAX_SPECTRUM_SAMPLES = 8192;
+
+    RecordingChunkSummary m_summary;
+
+    DatagramDecoder m_decoder;
+    TrackSnapshotPtr m_tracks;
+    ADCFramePtr m_frame;
+
+    RadarDataCube m_cube;
+    std::vector<float> m_window;
+    std::vector<float> m_magnitudes;
+};
@@ -0,0 +1,507 @@
+#include "RecordingWriter.h"
+#include "RecordingCodec.h"
+#include "WireFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+const size_t BYTE_BLOCK_SIZE = 1u << 20;
+const size_t MAX_FREE_BLOCKS = 64;
+const size_t CHUNKS_PER_CODEC_THREAD = 2;   // Chunks queued per encoder before the writer waits
+const size_t CHUNK_PREFIX = sizeof(RecordingChunkHeader) + sizeof(RecordingChunkSummary);
+
+} // namespace
+
+RecordingWriter::RecordingWriter()
+    : m_file(nullptr)
+    , m_queuedBytes(0)
+    , m_queueLimit(256u << 20)    // 256 MiB waiting for the disk
+    , m_offline(false)
+    , m_stopping(false)
+    , m_chunkSize(8u << 20)       // 8 MiB chunks
+    , m_chunkUsed(0)
+    , m_chunkDuration(1000000)    // 1 s
+    , m_chunkHeader()
+    , m_lastDatagramTimestamp(0)
+    , m_chunkCount(0)
+    , m_fileOffset(0)
+    , m_recordCount(0)
+    , m_writeFailed(false)
+    , m_codec(Recording::CodecNone)
+    , m_codecThreadCount(std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2)))
+    , m_codecStopping(false)
+    , m_statRecords(0)
+    , m_statChunks(0)
+    , m_statBytes(0)
+    , m_statDropped(0)
+    , m_statRawBytes(0)
+    , m_statStoredBytes(0)
+    , m_statCodecNanos(0)
+{
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    close();
+}
+
+uint64_t RecordingWriter::nowMicroseconds()
+{
+    using namespace std::chrono;
+    return uint64_t(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+void RecordingWriter::setChunkSize(size_t chunkBytes)
+{
+    if (isOpen()) return;  // The chunk buffer is sized on open
+    m_chunkSize = std::max(chunkBytes, size_t(64u << 10));
+}
+
+bool RecordingWriter::open(const std::string& path, std::string* error)
+{
+    close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        if (error) *error = "Cannot open " + path + " for writing";
+        return false;
+    }
+    // Chunks are already large; stdio buffering would only add a copy
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    m_chunk.reset(new ChunkBuffer());
+    m_chunk->raw.resize(m_chunkSize);
+    m_inFlight.clear();
+    m_spareChunks.clear();
+    m_chunkUsed = 0;
+    m_chunkHeader = RecordingChunkHeader();
+    m_summarizer.reset();
+    m_lastDatagramTimestamp = 0;
+    m_chunkCount = 0;
+    m_index.clear();
+    m_fileOffset = 0;
+    m_recordCount = 0;
+    m_writeFailed = false;
+    m_pending.clear();
+    m_pending.reserve(4096);
+    m_pendingBlocks.clear();
+    m_queuedBytes = 0;
+    m_stopping = false;
+    m_statRecords = 0;
+    m_statChunks = 0;
+    m_statBytes = 0;
+    m_statDropped = 0;
+    m_statRawBytes = 0;
+    m_statStoredBytes = 0;
+    m_statCodecNanos = 0;
+
+    RecordingFileHeader header = RecordingFileHeader();
+    std::memcpy(header.magic, Recording::FILE_MAGIC, sizeof(header.magic));
+    header.version = Recording::FORMAT_VERSION;
+    header.headerSize = sizeof(RecordingFileHeader);
+    header.createdMicroseconds = nowMicroseconds();
+    if (!writeBytes(&header, sizeof(header))) {
+        if (error) *error = "Cannot write to " + path;
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_codecStopping = false;
+    if (m_codec != Recording::CodecNone) {
+        for (unsigned i = 0; i < std::max(m_codecThreadCount, 1u); ++i) {
+            m_codecThreads.emplace_back(&RecordingWriter::runCodec, this);
+        }
+    }
+    m_thread = std::thread(&RecordingWriter::run, this);
+    return true;
+}
+
+void RecordingWriter::close()
+{
+    if (!m_file) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    // The writer thread has written every encoded chunk before returning
+    {
+        std::lock_guard<std::mutex> lock(m_codecMutex);
+        m_codecStopping = true;
+    }
+    m_codecWake.notify_all();
+    for (std::thread& thread : m_codecThreads) {
+        thread.join();
+    }
+    m_codecThreads.clear();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+bool RecordingWriter::enqueue(std::unique_lock<std::mutex>& lock, size_t bytes)
+{
+    // Called with m_mutex held; an empty queue takes a record of any size
+    if (m_offline) {
+        m_space.wait(lock, [this, bytes] { return m_queuedBytes == 0 || m_queuedBytes + bytes <= m_queueLimit; });
+    } else if (m_queuedBytes + bytes > m_queueLimit) {
+        m_statDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_queuedBytes += bytes;
+    return true;
+}
+
+char* RecordingWriter::reserveBytes(size_t size)
+{
+    // Called with m_mutex held
+    if (m_pendingBlocks.empty() || m_pendingBlocks.back().capacity - m_pendingBlocks.back().used < size) {
+        if (!m_freeBlocks.empty() && m_freeBlocks.back().capacity >= size) {
+            m_pendingBlocks.push_back(std::move(m_freeBlocks.back()));
+            m_freeBlocks.pop_back();
+        } else {
+            const size_t capacity = std::max(size, BYTE_BLOCK_SIZE);
+            m_pendingBlocks.push_back(ByteBlock{std::unique_ptr<char[]>(new char[capacity]), capacity, 0});
+        }
+    }
+
+    ByteBlock& block = m_pendingBlocks.back();
+    char* bytes = block.data.get() + block.used;
+    block.used += size;
+    return bytes;
+}
+
+void RecordingWriter::writeDatagram(const char* data, size_t size, uint64_t timestamp)
+{
+    if (!m_file) return;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!enqueue(lock, size)) return;
+        char* bytes = reserveBytes(size);
+        std::memcpy(bytes, data, size);
+        m_pending.push_back(Pending{timestamp, Recording::RecordDatagram, bytes, size, nullptr, nullptr});
+    }
+    m_wake.notify_one();
+}
+
+void RecordingWriter::writeTracks(const TrackSnapshotPtr& tracks, uint64_t timestamp)
+{
+    if (!m_file || !tracks) return;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!enqueue(lock, tracks->targets.size() * sizeof(TargetTrackRecord) + 64)) return;
+        m_pending.push_back(Pending{timestamp, Recording::RecordTracks, nullptr, 0, tracks, nullptr});
+    }
+    m_wake.notify_one();
+}
+
+void RecordingWriter::writeADCFrame(const ADCFramePtr& frame, uint64_t timestamp)
+{
+    if (!m_file || !frame) return;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!enqueue(lock, frame->complex_data.size() * sizeof(ComplexSample) + 64)) return;
+        m_pending.push_back(Pending{timestamp, Recording::RecordADCFrame, nullptr, 0, nullptr, frame});
+    }
+    m_wake.notify_one();
+}
+
+RecordingWriter::Stats RecordingWriter::stats() const
+{
+    Stats stats;
+    stats.records = m_statRecords.load(std::memory_order_relaxed);
+    stats.chunks = m_statChunks.load(std::memory_order_relaxed);
+    stats.bytes = m_statBytes.load(std::memory_order_relaxed);
+    stats.dropped = m_statDropped.load(std::memory_order_relaxed);
+    stats.rawBytes = m_statRawBytes.load(std::memory_order_relaxed);
+    stats.storedBytes = m_statStoredBytes.load(std::memory_order_relaxed);
+    stats.codecSeconds = m_statCodecNanos.load(std::memory_order_relaxed) / 1e9;
+    return stats;
+}
+
+void RecordingWriter::run()
+{
+    for (;;) {
+        bool stopping;
+        size_t drainingBytes;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(200),
+                            [this] { return !m_pending.empty() || m_stopping; });
+            m_pending.swap(m_draining);
+            m_pendingBlocks.swap(m_drainingBlocks);
+            drainingBytes = m_queuedBytes;  // Still held until appended below
+            stopping = m_stopping;
+        }
+
+        // A decoded snapshot stamped like the datagram before it was decoded
+        // from that datagram, which is already in the summary
+        for (const Pending& pending : m_draining) {
+            switch (pending.type) {
+            case Recording::RecordDatagram:
+                appendRecord(pending.type, pending.timestamp,
+                             reinterpret_cast<const uint8_t*>(pending.bytes), pending.size);
+                m_summarizer.addDatagram(pending.bytes, pending.size);
+                m_lastDatagramTimestamp = pending.timestamp;
+                break;
+            case Recording::RecordTracks:
+                WireFormat::serializeTracks(*pending.tracks, pending.timestamp, m_serialized);
+                appendRecord(pending.type, pending.timestamp, m_serialized.data(), m_serialized.size());
+                if (pending.timestamp != m_lastDatagramTimestamp) {
+                    m_summarizer.addTracks(*pending.tracks);
+                }
+                break;
+            case Recording::RecordADCFrame:
+                WireFormat::serializeADCFrame(*pending.frame, pending.timestamp, m_serialized);
+                appendRecord(pending.type, pending.timestamp, m_serialized.data(), m_serialized.size());
+                if (pending.timestamp != m_lastDatagramTimestamp) {
+                    m_summarizer.addADCFrame(*pending.frame);
+                }
+                break;
+            }
+        }
+        m_draining.clear();         // Releases the queued snapshots
+
+        // Release the batch's queue space and hand its byte blocks back for reuse
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queuedBytes -= drainingBytes;
+            for (ByteBlock& block : m_drainingBlocks) {
+                if (m_freeBlocks.size() >= MAX_FREE_BLOCKS || block.capacity != BYTE_BLOCK_SIZE) continue;
+                block.used = 0;
+                m_freeBlocks.push_back(std::move(block));
+            }
+            m_drainingBlocks.clear();
+        }
+        m_space.notify_all();
+
+        // A quiet input still gets its chunk on disk within the chunk duration
+        const uint64_t now = nowMicroseconds();
+        if (!m_offline && m_chunkHeader.recordCount > 0 && now >= m_chunkHeader.firstTimestamp
+            && now - m_chunkHeader.firstTimestamp >= m_chunkDuration) {
+            flushChunk();
+        }
+        writeEncoded(SIZE_MAX);     // Whatever the encoders have finished
+
+        if (stopping) {
+            flushChunk();
+            writeEncoded(0);
+            writeIndex();
+            return;
+        }
+    }
+}
+
+void RecordingWriter::appendRecord(uint16_t type, uint64_t timestamp, const uint8_t* data, size_t size)
+{
+    const size_t recordBytes = sizeof(RecordingRecordHeader) + Recording::paddedSize(size);
+
+    if (m_chunkHeader.recordCount > 0
+        && (m_chunkUsed + recordBytes > m_chunkSize
+            || (timestamp >= m_chunkHeader.firstTimestamp       // Unsigned: earlier stamps must not wrap
+                && timestamp - m_chunkHeader.firstTimestamp >= m_chunkDuration))) {
+        flushChunk();
+    }
+
+    if (m_chunkHeader.recordCount == 0) {
+        m_chunkUsed = CHUNK_PREFIX;
+        m_chunkHeader.firstTimestamp = timestamp;
+        m_chunkHeader.lastTimestamp = timestamp;
+        m_chunkHeader.firstRecord = m_recordCount;
+    }
+    if (m_chunkUsed + recordBytes > m_chunk->raw.size()) {
+        m_chunk->raw.resize(m_chunkUsed + recordBytes);  // Single record larger than a chunk
+    }
+
+    RecordingRecordHeader header;
+    header.timestamp = timestamp;
+    header.size = static_cast<uint32_t>(size);
+    header.type = type;
+    header.flags = 0;
+
+    uint8_t* out = m_chunk->raw.data() + m_chunkUsed;
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), data, size);
+    std::memset(out + sizeof(header) + size, 0, recordBytes - sizeof(header) - size);
+    m_chunkUsed += recordBytes;
+
+    m_chunkHeader.firstTimestamp = std::min(m_chunkHeader.firstTimestamp, timestamp);
+    m_chunkHeader.lastTimestamp = std::max(m_chunkHeader.lastTimestamp, timestamp);
+    ++m_chunkHeader.recordCount;
+    ++m_recordCount;
+}
+
+void RecordingWriter::flushChunk()
+{
+    if (m_chunkHeader.recordCount == 0) return;
+
+    m_chunkHeader.magic = Recording::CHUNK_MAGIC;
+    m_chunkHeader.chunkIndex = m_chunkCount++;
+    m_chunkHeader.storedSize = static_cast<uint32_t>(m_chunkUsed - CHUNK_PREFIX);
+    m_chunkHeader.rawSize = m_chunkHeader.storedSize;
+    m_chunkHeader.codec = Recording::CodecNone;
+    m_chunkHeader.flags = Recording::ChunkHasSummary;
+    std::memcpy(m_chunk->raw.data(), &m_chunkHeader, sizeof(m_chunkHeader));
+    std::memcpy(m_chunk->raw.data() + sizeof(m_chunkHeader), &m_summarizer.summary(), sizeof(RecordingChunkSummary));
+    m_chunk->used = m_chunkUsed;
+    m_chunk->packedUsed = 0;
+    m_chunkHeader = RecordingChunkHeader();
+    m_summarizer.reset();
+    m_chunkUsed = 0;
+
+    if (m_codecThreads.empty()) {
+        writeChunk(*m_chunk);
+        return;
+    }
+
+    // Hand the chunk to the encoders and continue in a recycled buffer
+    m_chunk->encoded = false;
+    {
+        std::lock_guard<std::mutex> lock(m_codecMutex);
+        m_codecQueue.push_back(m_chunk.get());
+    }
+    m_codecWake.notify_one();
+    m_inFlight.push_back(std::move(m_chunk));
+
+    writeEncoded(m_codecThreads.size() * CHUNKS_PER_CODEC_THREAD - 1);
+    if (!m_spareChunks.empty()) {
+        m_chunk = std::move(m_spareChunks.back());
+        m_spareChunks.pop_back();
+    } else {
+        m_chunk.reset(new ChunkBuffer());
+    }
+    if (m_chunk->raw.size() < m_chunkSize) {
+        m_chunk->raw.resize(m_chunkSize);
+    }
+}
+
+void RecordingWriter::writeEncoded(size_t maxInFlight)
+{
+    // Chunks go to the file in order; wait only while too many are queued
+    while (!m_inFlight.empty()) {
+        ChunkBuffer& head = *m_inFlight.front();
+        {
+            std::unique_lock<std::mutex> lock(m_codecMutex);
+            if (m_inFlight.size() > maxInFlight) {
+                m_codecDone.wait(lock, [&head] { return head.encoded; });
+            } else if (!head.encoded) {
+                return;
+            }
+        }
+        writeChunk(head);
+        m_spareChunks.push_back(std::move(m_inFlight.front()));
+        m_inFlight.pop_front();
+    }
+}
+
+void RecordingWriter::runCodec()
+{
+    for (;;) {
+        ChunkBuffer* buffer;
+        {
+            std::unique_lock<std::mutex> lock(m_codecMutex);
+            m_codecWake.wait(lock, [this] { return !m_codecQueue.empty() || m_codecStopping; });
+            if (m_codecQueue.empty()) return;
+            buffer = m_codecQueue.front();
+            m_codecQueue.pop_front();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        encodeChunk(*buffer);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        m_statCodecNanos.fetch_add(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                   std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(m_codecMutex);
+            buffer->encoded = true;
+        }
+        m_codecDone.notify_all();
+    }
+}
+
+void RecordingWriter::encodeChunk(ChunkBuffer& buffer)
+{
+    RecordingChunkHeader header;
+    std::memcpy(&header, buffer.raw.data(), sizeof(header));
+
+    const size_t rawSize = buffer.used - CHUNK_PREFIX;
+    const size_t capacity = CHUNK_PREFIX + Recording::paddedSize(RecordingCodec::maxEncodedSize(rawSize));
+    if (buffer.packed.size() < capacity) {
+        buffer.packed.resize(capacity);
+    }
+
+    const size_t encoded = RecordingCodec::encode(m_codec, buffer.raw.data() + CHUNK_PREFIX, rawSize,
+                                                  buffer.packed.data() + CHUNK_PREFIX, buffer.scratch);
+    if (encoded == 0) {
+        buffer.packedUsed = 0;  // Did not shrink: store as is
+        return;
+    }
+
+    // The summary stays readable without decoding
+    header.storedSize = static_cast<uint32_t>(encoded);
+    header.codec = m_codec;
+    std::memcpy(buffer.packed.data(), &header, sizeof(header));
+    std::memcpy(buffer.packed.data() + sizeof(header), buffer.raw.data() + sizeof(header), sizeof(RecordingChunkSummary));
+    buffer.packedUsed = CHUNK_PREFIX + size_t(Recording::paddedSize(encoded));
+    std::memset(buffer.packed.data() + CHUNK_PREFIX + encoded, 0, buffer.packedUsed - CHUNK_PREFIX - encoded);
+}
+
+void RecordingWriter::writeChunk(const ChunkBuffer& buffer)
+{
+    RecordingChunkHeader header;
+    std::memcpy(&header, buffer.raw.data(), sizeof(header));
+
+    RecordingIndexEntry entry = RecordingIndexEntry();
+    entry.offset = m_fileOffset;
+    entry.firstTimestamp = header.firstTimestamp;
+    entry.lastTimestamp = header.lastTimestamp;
+    entry.firstRecord = header.firstRecord;
+    entry.recordCount = header.recordCount;
+
+    const bool packed = buffer.packedUsed > 0;
+    const uint8_t* data = packed ? buffer.packed.data() : buffer.raw.data();
+    const size_t size = packed ? buffer.packedUsed : buffer.used;
+    if (writeBytes(data, size)) {
+        m_index.push_back(entry);
+        m_statRecords.fetch_add(header.recordCount, std::memory_order_relaxed);
+        m_statChunks.fetch_add(1, std::memory_order_relaxed);
+        m_statRawBytes.fetch_add(header.rawSize, std::memory_order_relaxed);
+        m_statStoredBytes.fetch_add(size - CHUNK_PREFIX, std::memory_order_relaxed);
+    } else {
+        m_statDropped.fetch_add(header.recordCount, std::memory_order_relaxed);
+    }
+}
+
+void RecordingWriter::writeIndex()
+{
+    const uint64_t indexOffset = m_fileOffset;
+    writeBytes(m_index.data(), m_index.size() * sizeof(RecordingIndexEntry));
+
+    RecordingFooter footer;
+    footer.indexOffset = indexOffset;
+    footer.chunkCount = m_index.size();
+    footer.recordCount = m_recordCount;
+    footer.version = Recording::FORMAT_VERSION;
+    footer.magic = Recording::FOOTER_MAGIC;
+    writeBytes(&footer, sizeof(footer));
+}
+
+bool RecordingWriter::writeBytes(const void* data, size_t size)
+{
+    if (m_writeFailed) return false;
+    if (size > 0 && std::fwrite(data, 1, size, m_file) != size) {
+        m_writeFailed = true;  // Disk full or removed: stop writing, keep counting drops
+        return false;
+    }
+    m_fileOffset += size;
+    m_statBytes.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
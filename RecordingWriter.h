@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "DataStructures.h"
+#include "RecordingFormat.h"
+#include "RecordingSummarizer.h"
+
+// Appends datagrams and decoded snapshots to a chunked recording file.
+// The write*() calls only queue the data: datagram bytes are copied into
+// recycled fixed-size blocks and snapshots are queued by reference (they are
+// immutable).
+// A background thread serializes records into a large page-aligned chunk
+// buffer, keeps the chunk's content summary (RecordingSummarizer), and
+// writes each chunk with one unbuffered fwrite, so ingest and display never
+// wait on the disk. If the disk falls behind, records beyond
+// the queue limit are dropped and counted rather than blocking; in offline
+// mode (reprocessing files) the producer waits for the queue instead.
+// With a codec set, finished chunks are encoded by a pool of worker threads
+// and written in order as they complete, so the disk rather than one core
+// bounds the recording rate.
+class RecordingWriter
+{
+public:
+    struct Stats {
+        uint64_t records;
+        uint64_t chunks;
+        uint64_t bytes;       // Written to the file
+        uint64_t dropped;     // Records lost to a full queue
+        uint64_t rawBytes;    // Chunk payloads before encoding
+        uint64_t storedBytes; // Chunk payloads as written
+        double codecSeconds;  // Encoding time summed over the workers
+
+        double compressionRatio() const { return storedBytes ? double(rawBytes) / storedBytes : 1.0; }
+        double codecMBps() const { return codecSeconds > 0.0 ? rawBytes / codecSeconds / 1e6 : 0.0; }
+    };
+
+    RecordingWriter();
+    ~RecordingWriter();
+
+    RecordingWriter(const RecordingWriter&) = delete;
+    RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();  // Flushes, writes the chunk index and footer
+    bool isOpen() const { return m_file != nullptr; }
+
+    // A chunk is written once it holds chunkBytes or spans chunkMicroseconds
+    void setChunkSize(size_t chunkBytes);
+    void setChunkDuration(uint64_t chunkMicroseconds) { m_chunkDuration = chunkMicroseconds; }
+    void setQueueLimit(size_t bytes) { m_queueLimit = bytes; }
+
+    // Offline: block on a full queue rather than drop, and close chunks on
+    // record timestamps only (they need not be near the wall clock)
+    void setOffline(bool offline) { m_offline = offline; }
+
+    // Chunk codec and encoder threads; take effect on the next open()
+    void setCodec(Recording::ChunkCodec codec) { m_codec = codec; }
+    Recording::ChunkCodec codec() const { return m_codec; }
+    void setCodecThreads(unsigned threads) { m_codecThreadCount = threads; }
+
+    // Producer side; safe to call from one thread while the writer runs
+    void writeDatagram(const char* data, size_t size, uint64_t timestamp);
+    void writeTracks(const TrackSnapshotPtr& tracks, uint64_t timestamp);
+    void writeADCFrame(const ADCFramePtr& frame, uint64_t timestamp);
+
+    Stats stats() const;
+
+    static uint64_t nowMicroseconds();
+
+private:
+    struct Pending {
+        uint64_t timestamp;
+        uint16_t type;          // Recording::RecordType
+        const char* bytes;      // Datagram copy, inside one of the byte blocks
+        size_t size;
+        TrackSnapshotPtr tracks;
+        ADCFramePtr frame;
+    };
+
+    // Datagram bytes are appended to blocks that are never reallocated, so
+    // queueing never moves earlier data
+    struct ByteBlock {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        size_t used;
+    };
+
+    // One chunk on its way to the disk; recycled once written
+    struct ChunkBuffer {
+        std::vector<uint8_t, AlignedAllocator<uint8_t, 4096>> raw;     // Header, summary, payload
+        std::vector<uint8_t, AlignedAllocator<uint8_t, 4096>> packed;  // Header, summary, encoded payload
+        std::vector<uint8_t> scratch;
+        size_t used;            // Bytes of raw in use
+        size_t packedUsed;      // Bytes of packed to write, 0 to write raw
+        bool encoded;           // Guarded by m_codecMutex
+    };
+
+    bool enqueue(std::unique_lock<std::mutex>& lock, size_t bytes);
+    char* reserveBytes(size_t size);
+    void run();
+    void runCodec();
+    void encodeChunk(ChunkBuffer& buffer);
+    void appendRecord(uint16_t type, uint64_t timestamp, const uint8_t* data, size_t size);
+    void flushChunk();
+    void writeEncoded(size_t maxInFlight);
+    void writeChunk(const ChunkBuffer& buffer);
+    void writeIndex();
+    bool writeBytes(const void* data, size_t size);
+
+    std::FILE* m_file;
+    std::thread m_thread;
+
+    // Producer/writer hand-off: the writer swaps these with its own copies
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_space;    // Offline producers waiting on a full queue
+    std::vector<Pending> m_pending;
+    std::vector<ByteBlock> m_pendingBlocks;
+    std::vector<ByteBlock> m_freeBlocks;
+    size_t m_queuedBytes;
+    size_t m_queueLimit;
+    bool m_offline;
+    bool m_stopping;
+
+    // Writer thread only
+    std::vector<Pending> m_draining;
+    std::vector<ByteBlock> m_drainingBlocks;
+    std::vector<uint8_t> m_serialized;
+    std::unique_ptr<ChunkBuffer> m_chunk;   // Being filled
+    std::deque<std::unique_ptr<ChunkBuffer>> m_inFlight;  // Encoding, in file order
+    std::vector<std::unique_ptr<ChunkBuffer>> m_spareChunks;
+    size_t m_chunkSize;
+    size_t m_chunkUsed;
+    uint64_t m_chunkDuration;
+    RecordingChunkHeader m_chunkHeader;
+    RecordingSummarizer m_summarizer;
+    uint64_t m_lastDatagramTimestamp;
+    uint32_t m_chunkCount;
+    std::vector<RecordingIndexEntry> m_index;
+    uint64_t m_fileOffset;
+    uint64_t m_recordCount;
+    bool m_writeFailed;
+
+    // Encoder pool: the writer thread queues chunks, workers mark them encoded
+    Recording::ChunkCodec m_codec;
+    unsigned m_codecThreadCount;
+    std::vector<std::thread> m_codecThreads;
+    std::mutex m_codecMutex;
+    std::condition_variable m_codecWake;
+    std::condition_variable m_codecDone;
+    std::deque<ChunkBuffer*> m_codecQueue;
+    bool m_codecStopping;
+
+    std::atomic<uint64_t> m_statRecords;
+    std::atomic<uint64_t> m_statChunks;
+    std::atomic<uint64_t> m_statBytes;
+    std::atomic<uint64_t> m_statDropped;
+    std::atomic<uint64_t> m_statRawBytes;
+    std::atomic<uint64_t> m_statStoredBytes;
+    std::atomic<uint64_t> m_statCodecNanos;
+};
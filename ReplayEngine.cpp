@@ -0,0 +1,254 @@
+#include "ReplayEngine.h"
+#include <algorithm>
+
+ReplayEngine::ReplayEngine(QObject* parent)
+    : QObject(parent)
+    , m_capturePort(0)
+    , m_captureSequence(0)
+    , m_speed(1.0)
+    , m_typeMask(1u << Recording::RecordDatagram)
+    , m_playing(false)
+    , m_next()
+    , m_hasNext(false)
+    , m_anchorTimestamp(0)
+    , m_position(0)
+    , m_startTime(0)
+    , m_endTime(0)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayEngine::deliver);
+}
+
+bool ReplayEngine::open(const QString& path, QString* error)
+{
+    close();
+
+    std::string message;
+    if (PcapReader::isCapture(path.toStdString())) {
+        if (!m_capture.open(path.toStdString(), &message)) {
+            if (error) *error = QString::fromStdString(message);
+            return false;
+        }
+        m_capture.setPort(m_capturePort);
+        m_typeMask = 1u << Recording::RecordDatagram;
+        if (!fetch()) {
+            m_capture.close();
+            if (error) *error = m_capturePort
+                ? QString("%1 holds no UDP datagrams to port %2").arg(path).arg(m_capturePort)
+                : path + " holds no UDP datagrams";
+            return false;
+        }
+        m_startTime = m_next.timestamp;
+        m_endTime = 0;
+        m_position = m_startTime;
+        return true;
+    }
+
+    if (!m_reader.open(path.toStdString(), &message)) {
+        if (error) *error = QString::fromStdString(message);
+        return false;
+    }
+    if (m_reader.recordCount() == 0) {
+        m_reader.close();
+        if (error) *error = path + " holds no records";
+        return false;
+    }
+
+    // Prefer the raw datagrams; decoded frames are only replayed when the
+    // first chunk shows the datagrams were not recorded
+    uint32_t seen = 0;
+    RecordingReader::Record record;
+    for (uint32_t i = 0; i < m_reader.chunk(0).recordCount && m_reader.next(record); ++i) {
+        seen |= 1u << record.type;
+    }
+    m_typeMask = (seen & (1u << Recording::RecordDatagram))
+        ? (1u << Recording::RecordDatagram)
+        : (1u << Recording::RecordTracks) | (1u << Recording::RecordADCFrame);
+
+    m_reader.rewind();
+    m_startTime = m_reader.firstTimestamp();
+    m_endTime = m_reader.lastTimestamp();
+    m_position = m_startTime;
+    return true;
+}
+
+void ReplayEngine::close()
+{
+    pause();
+    m_reader.close();
+    m_capture.close();
+    m_captureSequence = 0;
+    m_hasNext = false;
+    m_position = 0;
+    m_startTime = 0;
+    m_endTime = 0;
+}
+
+void ReplayEngine::setSpeed(double speed)
+{
+    m_speed = std::max(speed, 0.0);
+    rebase();
+}
+
+void ReplayEngine::play()
+{
+    if (!isOpen() || m_playing) return;
+    m_playing = true;
+    rebase();
+    m_timer.start(0);
+}
+
+void ReplayEngine::pause()
+{
+    m_playing = false;
+    m_timer.stop();
+}
+
+bool ReplayEngine::seekToTime(uint64_t timestamp)
+{
+    if (isCapture()) {
+        const bool found = scanCapture(timestamp, 0, 0);
+        m_position = found ? m_next.timestamp : timestamp;
+        rebase();
+        return found;
+    }
+
+    m_hasNext = false;
+    const bool found = m_reader.seekToTime(timestamp);
+    m_position = timestamp;
+    rebase();
+    return found;
+}
+
+bool ReplayEngine::seekToRecord(uint64_t sequence)
+{
+    bool found;
+    if (isCapture()) {
+        found = scanCapture(0, sequence, 0);
+    } else {
+        m_hasNext = false;
+        found = m_reader.seekToRecord(sequence);
+    }
+    rebase();
+    if (m_hasNext) m_position = m_next.timestamp;
+    return found;
+}
+
+bool ReplayEngine::seekToFraction(double fraction)
+{
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    if (isCapture()) {
+        const bool found = scanCapture(0, 0, uint64_t(fraction * double(m_capture.fileSize())));
+        rebase();
+        if (m_hasNext) m_position = m_next.timestamp;
+        return found;
+    }
+    return seekToTime(m_startTime + uint64_t(fraction * double(m_endTime - m_startTime)));
+}
+
+double ReplayEngine::progress() const
+{
+    if (isCapture()) {
+        return m_capture.fileSize() ? double(m_capture.position()) / double(m_capture.fileSize()) : 0.0;
+    }
+    return m_endTime > m_startTime ? double(elapsed()) / double(m_endTime - m_startTime) : 0.0;
+}
+
+void ReplayEngine::rewindCapture()
+{
+    m_capture.rewind();
+    m_captureSequence = 0;
+    m_hasNext = false;
+}
+
+bool ReplayEngine::scanCapture(uint64_t timestamp, uint64_t sequence, uint64_t offset)
+{
+    // First datagram at or past every target. Reading resumes from the
+    // pending datagram when the target lies ahead of it.
+    auto reached = [&]() {
+        return m_next.timestamp >= timestamp && m_next.sequence >= sequence && m_capture.position() >= offset;
+    };
+    if (!fetch() || reached()) {
+        rewindCapture();
+    }
+    while (fetch()) {
+        if (reached()) return true;
+        m_hasNext = false;
+    }
+    return false;
+}
+
+bool ReplayEngine::fetch()
+{
+    if (isCapture()) {
+        if (m_hasNext) return true;
+        PcapReader::Datagram datagram;
+        if (!m_capture.next(datagram)) {
+            m_endTime = std::max(m_endTime, m_position);
+            return false;
+        }
+        m_next.timestamp = datagram.timestamp;
+        m_next.sequence = m_captureSequence++;
+        m_next.type = Recording::RecordDatagram;
+        m_next.data = datagram.data;
+        m_next.size = datagram.size;
+        m_hasNext = true;
+        return true;
+    }
+
+    while (!m_hasNext) {
+        if (!m_reader.next(m_next)) return false;
+        m_hasNext = m_next.type < 32 && ((m_typeMask >> m_next.type) & 1u);
+    }
+    return true;
+}
+
+void ReplayEngine::rebase()
+{
+    // Playback time restarts from the next record
+    if (fetch()) {
+        m_anchorTimestamp = m_next.timestamp;
+    }
+    m_clock.start();
+}
+
+void ReplayEngine::deliver()
+{
+    if (!m_playing) return;
+
+    QElapsedTimer batch;
+    batch.start();
+    for (;;) {
+        if (!fetch()) {
+            pause();
+            emit finished();
+            return;
+        }
+
+        if (m_speed > 0.0) {
+            const uint64_t due = m_anchorTimestamp + uint64_t(m_clock.nsecsElapsed() / 1000 * m_speed);
+            if (m_next.timestamp > due) {
+                const uint64_t wait = m_next.timestamp - due;
+                if (wait > MAX_IDLE_US) {
+                    rebase();
+                    continue;
+                }
+                const int waitMs = int(wait / m_speed / 1000.0);
+                m_timer.start(std::max(waitMs, 1));
+                return;
+            }
+        }
+
+        m_hasNext = false;
+        m_position = m_next.timestamp;
+        emit recordReady(reinterpret_cast<const char*>(m_next.data), m_next.size, m_next.timestamp);
+
+        // The receiver may have paused or seeked
+        if (!m_playing) return;
+        if (batch.nsecsElapsed() > BATCH_BUDGET_NS) {
+            m_timer.start(0);
+            return;
+        }
+    }
+}
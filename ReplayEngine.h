@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include <QTimer>
+#include <cstdint>
+#include "PcapReader.h"
+#include "RecordingReader.h"
+
+// Plays a recording back through the live pipeline. Records are emitted
+// with recordReady() at their recorded pace scaled by the speed factor, or
+// as fast as the receiver can take them (speed 0), in time-boxed batches so
+// the event loop and display keep running.
+//
+// Packet captures (.pcap/.pcapng) play the same way: their UDP datagrams to
+// the capture port are streamed in one pass with the captured timing.
+// Captures have no index, so seeking scans forward from the current
+// datagram, or from the start when the target lies behind it.
+class ReplayEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReplayEngine(QObject* parent = nullptr);
+
+    bool open(const QString& path, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return m_reader.isOpen() || m_capture.isOpen(); }
+    bool isCapture() const { return m_capture.isOpen(); }
+    const RecordingReader& reader() const { return m_reader; }
+    const PcapReader& capture() const { return m_capture; }
+
+    // UDP destination port replayed from captures; 0 = every port
+    void setCapturePort(uint16_t port) { m_capturePort = port; }
+
+    // 1.0 = recorded pace, 0 = as fast as possible
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+
+    // Bitmask of (1 << Recording::RecordType). open() picks the raw
+    // datagrams when the file has them, else the decoded frames, so a
+    // recording holding both is not replayed twice.
+    void setRecordTypes(uint32_t mask) { m_typeMask = mask; }
+    uint32_t recordTypes() const { return m_typeMask; }
+
+    void play();
+    void pause();
+    bool isPlaying() const { return m_playing; }
+
+    bool seekToTime(uint64_t timestamp);
+    bool seekToRecord(uint64_t sequence);
+    bool seekToFraction(double fraction);
+
+    // Timestamp of the last record emitted (microseconds, Unix epoch)
+    uint64_t position() const { return m_position; }
+    uint64_t startTime() const { return m_startTime; }
+    // End of the recording; 0 for a capture until its end has been reached
+    uint64_t endTime() const { return m_endTime; }
+    uint64_t elapsed() const { return m_position > m_startTime ? m_position - m_startTime : 0; }
+    // 0..1, by time for recordings and by bytes read for captures
+    double progress() const;
+
+signals:
+    void recordReady(const char* data, size_t size, uint64_t timestamp);
+    void finished();
+
+private slots:
+    void deliver();
+
+private:
+    bool fetch();
+    void rebase();
+    void rewindCapture();
+    bool scanCapture(uint64_t timestamp, uint64_t sequence, uint64_t offset);
+
+    static constexpr qint64 BATCH_BUDGET_NS = 20000000;     // Event loop gets control every 20 ms
+    static constexpr uint64_t MAX_IDLE_US = 2000000;         // Recording gaps longer than 2 s are skipped
+
+    RecordingReader m_reader;
+    PcapReader m_capture;
+    uint16_t m_capturePort;
+    uint64_t m_captureSequence;   // Datagrams read from the capture so far
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    double m_speed;
+    uint32_t m_typeMask;
+    bool m_playing;
+
+    RecordingReader::Record m_next;
+    bool m_hasNext;
+    uint64_t m_anchorTimestamp;   // Recording time at m_clock's start
+    uint64_t m_position;
+    uint64_t m_startTime;
+    uint64_t m_endTime;
+};
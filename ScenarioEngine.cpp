@@ -0,0 +1,400 @@
+#include "ScenarioEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace {
+
+const float PI = 3.14159265358979f;
+const float QUARTER_PI = 0.785398163397448f;
+const float DEG_TO_RAD = PI / 180.0f;
+const float RAD_TO_DEG = 180.0f / PI;
+const double NEVER = std::numeric_limits<double>::infinity();
+
+// atan2(y, x) in radians, within 3e-6 of libm. atan(|y|/|x|) is
+// pi/4 + atan((|y| - |x|) / (|y| + |x|)), whose argument lies in [-1, 1]
+// where an odd minimax polynomial fits. The quadrant fix-ups use sign bits
+// instead of comparisons, which GCC will not if-convert without fast-math,
+// so loops calling this vectorize.
+inline float atan2Approx(float y, float x)
+{
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    const float t = (ay - ax) / (ay + ax + 1e-30f);
+    const float s = t * t;
+    float a = QUARTER_PI + t * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f
+                                + s * (0.05265332f + s * -0.01172120f)))));
+    const float behind = 0.5f - 0.5f * std::copysign(1.0f, x);    // 1 for x < 0
+    a += behind * (PI - 2.0f * a);
+    return std::copysign(a, y);
+}
+
+// position += velocity * dt. One call per axis: with all six columns in one
+// loop GCC gives up on the runtime alias checks and leaves it scalar.
+void advance(float* position, const float* velocity, size_t count, float dt)
+{
+    for (size_t i = 0; i < count; ++i) position[i] += velocity[i] * dt;
+}
+
+// Stable in-place removal of the rows whose keep flag is 0
+template <typename T>
+void compact(AlignedVector<T>& column, const uint8_t* keep)
+{
+    size_t out = 0;
+    for (size_t i = 0; i < column.size(); ++i) {
+        if (keep[i]) column[out++] = column[i];
+    }
+    column.resize(out);
+}
+
+} // namespace
+
+ScenarioEngine::Config::Config()
+    : targets(8)
+    , minRange(100.0f)
+    , maxRange(500.0f)
+    , maxAzimuth(90.0f)
+    , maxElevation(30.0f)
+    , minSpeed(-50.0f)
+    , maxSpeed(50.0f)
+    , maxAzimuthRate(5.0f)
+    , maxElevationRate(2.0f)
+    , minLevel(10.0f)
+    , maxLevel(100.0f)
+    , meanLifetime(60.0f)
+    , seed(1)
+{
+}
+
+ScenarioEngine::ScenarioEngine(const Config& config)
+    : m_config(config)
+{
+    reset();
+}
+
+void ScenarioEngine::setConfig(const Config& config)
+{
+    m_config = config;
+}
+
+void ScenarioEngine::reset()
+{
+    m_random.seed(m_config.seed);
+    m_time = 0.0;
+    m_spawned = 0;
+    m_retired = 0;
+    m_randomCount = 0;
+
+    m_nextId = 1;
+    for (Script& script : m_scripts) {
+        script.alive = false;
+        script.finished = false;
+        script.segment = 0;
+        m_nextId = std::max(m_nextId, script.id + 1);
+    }
+
+    for (AlignedVector<float>* column : {&m_x, &m_y, &m_z, &m_vx, &m_vy, &m_vz, &m_level, &m_range, &m_azimuth,
+                                         &m_elevation, &m_radialSpeed, &m_azimuthRate, &m_elevationRate}) {
+        column->clear();
+    }
+    m_id.clear();
+    m_expiry.clear();
+    m_script.clear();
+}
+
+bool ScenarioEngine::loadScript(const std::string& path, std::string* error)
+{
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    std::map<uint32_t, Script> scripts;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        double id;
+        double time;
+        float range;
+        float azimuth;
+        float elevation;
+        if (!(fields >> id)) continue;   // Blank or comment
+        if (!(fields >> time >> range >> azimuth >> elevation) || id < 1.0 || id > 4294967295.0
+            || range < 0.0f || !std::isfinite(time)) {
+            if (error) *error = path + ":" + std::to_string(number) + ": expected id time range azimuth elevation [level]";
+            return false;
+        }
+        float level;
+        const bool hasLevel = bool(fields >> level);
+
+        Script& script = scripts[uint32_t(id)];
+        if (script.waypoints.empty()) {
+            script.id = uint32_t(id);
+            script.level = hasLevel ? level : 60.0f;
+        }
+        const float a = azimuth * DEG_TO_RAD;
+        const float e = elevation * DEG_TO_RAD;
+        script.waypoints.push_back(Waypoint{time, range * std::cos(e) * std::sin(a),
+                                            range * std::cos(e) * std::cos(a), range * std::sin(e)});
+    }
+
+    std::vector<Script> loaded;
+    for (auto& entry : scripts) {
+        Script& script = entry.second;
+        std::stable_sort(script.waypoints.begin(), script.waypoints.end(),
+                         [](const Waypoint& a, const Waypoint& b) { return a.time < b.time; });
+        if (script.waypoints.size() < 2 || script.waypoints.front().time == script.waypoints.back().time) {
+            if (error) *error = path + ": target " + std::to_string(entry.first) + " needs waypoints at two different times";
+            return false;
+        }
+        loaded.push_back(std::move(script));
+    }
+    if (loaded.empty()) {
+        if (error) *error = path + ": no waypoints";
+        return false;
+    }
+
+    m_scripts = std::move(loaded);
+    reset();
+    return true;
+}
+
+void ScenarioEngine::clearScript()
+{
+    m_scripts.clear();
+    reset();
+}
+
+size_t ScenarioEngine::addRow(uint32_t id, float level, double expiry, int32_t script)
+{
+    for (AlignedVector<float>* column : {&m_x, &m_y, &m_z, &m_vx, &m_vy, &m_vz, &m_range, &m_azimuth,
+                                         &m_elevation, &m_radialSpeed, &m_azimuthRate, &m_elevationRate}) {
+        column->push_back(0.0f);
+    }
+    m_id.push_back(id);
+    m_level.push_back(level);
+    m_expiry.push_back(expiry);
+    m_script.push_back(script);
+    ++m_spawned;
+    return m_id.size() - 1;
+}
+
+void ScenarioEngine::step(double dt)
+{
+    m_time += dt;
+
+    // Constant velocity; scripted rows are overwritten below
+    advance(m_x.data(), m_vx.data(), size(), float(dt));
+    advance(m_y.data(), m_vy.data(), size(), float(dt));
+    advance(m_z.data(), m_vz.data(), size(), float(dt));
+
+    startScripts();
+    moveScripts();
+    updatePolar(0, size());
+    retire();
+    spawnRandom();
+}
+
+void ScenarioEngine::startScripts()
+{
+    for (size_t s = 0; s < m_scripts.size(); ++s) {
+        Script& script = m_scripts[s];
+        if (script.alive || script.finished || script.waypoints.front().time > m_time) continue;
+        if (script.waypoints.back().time <= m_time) {
+            script.finished = true;      // Stepped over its whole lifetime
+            continue;
+        }
+        script.row = addRow(script.id, script.level, NEVER, int32_t(s));
+        script.segment = 0;
+        script.alive = true;
+    }
+}
+
+void ScenarioEngine::moveScripts()
+{
+    for (Script& script : m_scripts) {
+        if (!script.alive) continue;
+
+        const std::vector<Waypoint>& points = script.waypoints;
+        while (script.segment + 1 < points.size() && points[script.segment + 1].time <= m_time) {
+            ++script.segment;
+        }
+        if (script.segment + 1 >= points.size()) {
+            m_expiry[script.row] = -NEVER;   // Past the last waypoint
+            continue;
+        }
+
+        const Waypoint& from = points[script.segment];
+        const Waypoint& to = points[script.segment + 1];
+        const float span = float(to.time - from.time);
+        const float into = float(m_time - from.time);
+        const size_t row = script.row;
+        m_vx[row] = span > 0.0f ? (to.x - from.x) / span : 0.0f;
+        m_vy[row] = span > 0.0f ? (to.y - from.y) / span : 0.0f;
+        m_vz[row] = span > 0.0f ? (to.z - from.z) / span : 0.0f;
+        m_x[row] = from.x + m_vx[row] * into;
+        m_y[row] = from.y + m_vy[row] * into;
+        m_z[row] = from.z + m_vz[row] * into;
+    }
+}
+
+void ScenarioEngine::updatePolar(size_t begin, size_t end)
+{
+    const float* x = m_x.data();
+    const float* y = m_y.data();
+    const float* z = m_z.data();
+    const float* vx = m_vx.data();
+    const float* vy = m_vy.data();
+    const float* vz = m_vz.data();
+    float* range = m_range.data();
+    float* azimuth = m_azimuth.data();
+    float* elevation = m_elevation.data();
+    float* radialSpeed = m_radialSpeed.data();
+    float* azimuthRate = m_azimuthRate.data();
+    float* elevationRate = m_elevationRate.data();
+
+    // One loop per output, so each stays within the compiler's alias-check
+    // budget and vectorizes; the shared terms are cheap to recompute. The
+    // small offsets only keep a target at the origin finite.
+    for (size_t i = begin; i < end; ++i) {
+        range[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+    }
+    for (size_t i = begin; i < end; ++i) {
+        azimuth[i] = atan2Approx(x[i], y[i]) * RAD_TO_DEG;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        elevation[i] = atan2Approx(z[i], std::sqrt(x[i] * x[i] + y[i] * y[i])) * RAD_TO_DEG;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        const float r = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        radialSpeed[i] = -(x[i] * vx[i] + y[i] * vy[i] + z[i] * vz[i]) / (r + 1e-6f);
+    }
+    for (size_t i = begin; i < end; ++i) {
+        azimuthRate[i] = (y[i] * vx[i] - x[i] * vy[i]) / (x[i] * x[i] + y[i] * y[i] + 1e-12f) * RAD_TO_DEG;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        // d/dt atan2(z, g) = (g dz - z dg) / r^2, with g dg = x dx + y dy
+        const float ground2 = x[i] * x[i] + y[i] * y[i];
+        const float range2 = ground2 + z[i] * z[i];
+        const float horizontal = x[i] * vx[i] + y[i] * vy[i];
+        elevationRate[i] = (ground2 * vz[i] - z[i] * horizontal)
+                           / ((std::sqrt(ground2) + 1e-6f) * (range2 + 1e-12f)) * RAD_TO_DEG;
+    }
+}
+
+void ScenarioEngine::retire()
+{
+    const size_t count = size();
+    m_keep.resize(count);
+    uint8_t* keep = m_keep.data();
+    const float minRange = m_config.minRange;
+    const float maxRange = m_config.maxRange;
+    const float maxAzimuth = m_config.maxAzimuth;
+    const float maxElevation = m_config.maxElevation;
+    const float* range = m_range.data();
+    const float* azimuth = m_azimuth.data();
+    const float* elevation = m_elevation.data();
+    const double* expiry = m_expiry.data();
+    const int32_t* script = m_script.data();
+    const double now = m_time;
+
+    // & rather than && keeps the loop free of branches
+    size_t kept = 0;
+    size_t randomKept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const bool inside = (range[i] >= minRange) & (range[i] <= maxRange)
+                            & (std::fabs(azimuth[i]) <= maxAzimuth) & (std::fabs(elevation[i]) <= maxElevation);
+        const bool scripted = script[i] >= 0;
+        keep[i] = (expiry[i] > now) & (inside | scripted);
+        kept += keep[i];
+        randomKept += keep[i] & !scripted;
+    }
+
+    // Lowered target count: the newest random targets go first
+    for (size_t i = count; i-- > 0 && randomKept > m_config.targets; ) {
+        if (keep[i] && m_script[i] < 0) {
+            keep[i] = 0;
+            --randomKept;
+            --kept;
+        }
+    }
+    m_randomCount = randomKept;
+    if (kept == count) return;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!keep[i] && m_script[i] >= 0) {
+            m_scripts[m_script[i]].alive = false;
+            m_scripts[m_script[i]].finished = true;
+        }
+    }
+    for (AlignedVector<float>* column : {&m_x, &m_y, &m_z, &m_vx, &m_vy, &m_vz, &m_level, &m_range, &m_azimuth,
+                                         &m_elevation, &m_radialSpeed, &m_azimuthRate, &m_elevationRate}) {
+        compact(*column, keep);
+    }
+    compact(m_id, keep);
+    compact(m_expiry, keep);
+    compact(m_script, keep);
+    m_retired += count - kept;
+
+    for (size_t i = 0; i < kept; ++i) {
+        if (m_script[i] >= 0) m_scripts[m_script[i]].row = i;
+    }
+}
+
+void ScenarioEngine::spawnRandom()
+{
+    if (m_randomCount >= m_config.targets) return;
+
+    const Config& c = m_config;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto uniform = [&](float low, float high) { return low + (high - low) * unit(m_random); };
+    std::exponential_distribution<double> lifetime(c.meanLifetime > 0.0f ? 1.0 / c.meanLifetime : 1.0);
+
+    const size_t first = size();
+    for (; m_randomCount < c.targets; ++m_randomCount) {
+        const float range = uniform(c.minRange, c.maxRange);
+        const float azimuth = uniform(-c.maxAzimuth, c.maxAzimuth) * DEG_TO_RAD;
+        const float elevation = uniform(-c.maxElevation, c.maxElevation) * DEG_TO_RAD;
+        const float rangeRate = -uniform(c.minSpeed, c.maxSpeed);
+        const float azimuthRate = uniform(-c.maxAzimuthRate, c.maxAzimuthRate) * DEG_TO_RAD;
+        const float elevationRate = uniform(-c.maxElevationRate, c.maxElevationRate) * DEG_TO_RAD;
+        const float level = uniform(c.minLevel, c.maxLevel);
+        const double expiry = c.meanLifetime > 0.0f ? m_time + lifetime(m_random) : NEVER;
+
+        const size_t row = addRow(m_nextId++, level, expiry, -1);
+        const float sinA = std::sin(azimuth), cosA = std::cos(azimuth);
+        const float sinE = std::sin(elevation), cosE = std::cos(elevation);
+        m_x[row] = range * cosE * sinA;
+        m_y[row] = range * cosE * cosA;
+        m_z[row] = range * sinE;
+
+        // Velocity with exactly the drawn polar rates at the spawn point
+        const float ground = range * cosE;
+        m_vx[row] = rangeRate * cosE * sinA + ground * azimuthRate * cosA - range * elevationRate * sinE * sinA;
+        m_vy[row] = rangeRate * cosE * cosA - ground * azimuthRate * sinA - range * elevationRate * sinE * cosA;
+        m_vz[row] = rangeRate * sinE + range * elevationRate * cosE;
+    }
+    updatePolar(first, size());
+}
+
+void ScenarioEngine::snapshot(TargetTrackData& tracks) const
+{
+    const size_t count = size();
+    tracks.resize(uint32_t(count));
+    TargetTrack* out = tracks.targets.data();
+    for (size_t i = 0; i < count; ++i) {
+        out[i].target_id = m_id[i];
+        out[i].level = m_level[i];
+        out[i].radius = m_range[i];
+        out[i].azimuth = m_azimuth[i];
+        out[i].elevation = m_elevation[i];
+        out[i].radial_speed = m_radialSpeed[i];
+        out[i].azimuth_speed = m_azimuthRate[i];
+        out[i].elevation_speed = m_elevationRate[i];
+    }
+}
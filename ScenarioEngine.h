@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "DataStructures.h"
+
+// Simulated targets with persistent kinematics, for the simulation mode and
+// for loading the display and tracking paths with realistic target counts.
+//
+// Targets move in straight lines in sensor Cartesian coordinates (x east,
+// y along 0° azimuth, z up, metres). Random targets spawn anywhere in the
+// coverage (range, azimuth and elevation limits) with the configured radial
+// speed and angular rates, and retire when they leave it or when their
+// lifetime (exponential, Config::meanLifetime) ends; the population is
+// topped up to Config::targets after every step. IDs are never reused.
+//
+// Scripted targets follow waypoints loaded from a text file, one per line:
+//
+//   # id  time_s  range_m  azimuth_deg  elevation_deg  [level_dB]
+//   1     0       450      -30          2              70
+//   1     20      150      10           2
+//   1     35      150      40           5
+//
+// A scripted target exists from its first to its last waypoint and moves in
+// a straight line between consecutive ones; it keeps its file ID and the
+// level of its first waypoint (default 60 dB). Loading a script restarts the
+// scenario at time 0, and random IDs continue above the scripted ones.
+//
+// State is kept in 64-byte aligned columns. A step integrates all positions
+// in one pass and converts them to range/azimuth/elevation and their rates
+// in another, both branch-free (polynomial atan2), so GCC vectorizes them;
+// only spawning, retiring and the scripted targets are per-target code.
+class ScenarioEngine
+{
+public:
+    struct Config {
+        size_t targets;             // Random targets kept alive
+        float minRange;             // m
+        float maxRange;
+        float maxAzimuth;           // degrees either side of 0
+        float maxElevation;
+        float minSpeed;             // m/s radial, positive = approaching
+        float maxSpeed;
+        float maxAzimuthRate;       // deg/s either way
+        float maxElevationRate;
+        float minLevel;             // dB
+        float maxLevel;
+        float meanLifetime;         // s
+        uint64_t seed;
+
+        Config();
+    };
+
+    explicit ScenarioEngine(const Config& config = Config());
+
+    // Applies to spawning and retiring from the next step on; existing
+    // targets keep their motion
+    void setConfig(const Config& config);
+    const Config& config() const { return m_config; }
+
+    // Replaces the scripted targets and restarts the scenario. On failure
+    // the scenario is left as it was.
+    bool loadScript(const std::string& path, std::string* error = nullptr);
+    void clearScript();
+    size_t scriptedTargets() const { return m_scripts.size(); }
+
+    // No targets, time 0, random sequence restarted from Config::seed
+    void reset();
+
+    // Advance by dt seconds
+    void step(double dt);
+
+    double time() const { return m_time; }
+    size_t size() const { return m_id.size(); }
+    uint64_t spawnedCount() const { return m_spawned; }
+    uint64_t retiredCount() const { return m_retired; }
+
+    // Targets as of the last step, in the sensor's polar track layout
+    void snapshot(TargetTrackData& tracks) const;
+
+private:
+    struct Waypoint {
+        double time;
+        float x, y, z;
+    };
+
+    struct Script {
+        uint32_t id;
+        float level;
+        std::vector<Waypoint> waypoints;
+        size_t segment;             // Waypoint the target is heading away from
+        size_t row;                 // While alive
+        bool alive;
+        bool finished;
+    };
+
+    size_t addRow(uint32_t id, float level, double expiry, int32_t script);
+    void spawnRandom();
+    void startScripts();
+    void moveScripts();
+    void retire();
+    void updatePolar(size_t begin, size_t end);
+
+    Config m_config;
+    std::mt19937_64 m_random;
+    double m_time;
+    uint32_t m_nextId;
+    uint64_t m_spawned;
+    uint64_t m_retired;
+    size_t m_randomCount;
+
+    // Per-target columns
+    AlignedVector<float> m_x, m_y, m_z;
+    AlignedVector<float> m_vx, m_vy, m_vz;
+    AlignedVector<uint32_t> m_id;
+    AlignedVector<float> m_level;
+    AlignedVector<double> m_expiry;          // Retire at this scenario time
+    AlignedVector<int32_t> m_script;         // Index into m_scripts, -1 = random
+
+    // Polar view, recomputed after every step
+    AlignedVector<float> m_range, m_azimuth, m_elevation;
+    AlignedVector<float> m_radialSpeed, m_azimuthRate, m_elevationRate;
+
+    std::vector<Script> m_scripts;
+    std::vector<uint8_t> m_keep;             // Retire pass scratch
+};
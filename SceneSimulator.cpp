@@ -0,0 +1,144 @@
+#include "SceneSimulator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const double SPEED_OF_LIGHT = 299792458.0;
+const double PI = 3.14159265358979323846;
+}
+
+SceneSimulator::Config::Config()
+    : sampleRate(100000.0f)
+    , sweepTime(0.0015f)
+    , bandwidth(100000000.0f)
+    , centerFrequency(24125000000.0f)
+    , samplesPerChirp(256)
+    , chirps(16)
+    , antennas(1)
+    , noiseLevel(0.01f)
+    , referenceRange(10.0f)
+    , referenceAmplitude(0.5f)
+    , seed(1)
+{
+}
+
+SceneSimulator::SceneSimulator(const Config& config)
+{
+    setConfig(config);
+}
+
+void SceneSimulator::setConfig(const Config& config)
+{
+    m_config = config;
+    m_config.samplesPerChirp = std::max<size_t>(m_config.samplesPerChirp, 1);
+    m_config.chirps = std::max<size_t>(m_config.chirps, 1);
+    m_config.antennas = std::max<size_t>(m_config.antennas, 1);
+
+    // splitmix64 of the seed: any seed, including 0, gives a usable state
+    uint64_t z = m_config.seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    m_state = (z ^ (z >> 31)) | 1;
+}
+
+float SceneSimulator::maxRange() const
+{
+    return float(m_config.sampleRate / 2.0 * SPEED_OF_LIGHT * m_config.sweepTime / (2.0 * m_config.bandwidth));
+}
+
+uint64_t SceneSimulator::nextRandom()
+{
+    // xorshift64*
+    m_state ^= m_state >> 12;
+    m_state ^= m_state << 25;
+    m_state ^= m_state >> 27;
+    return m_state * 0x2545F4914F6CDD1Dull;
+}
+
+void SceneSimulator::synthesize(const std::vector<Target>& targets, RawADCFrameTest& frame)
+{
+    const size_t samples = m_config.samplesPerChirp;
+    const size_t chirps = m_config.chirps;
+    const size_t antennas = m_config.antennas;
+    const double sampleRate = m_config.sampleRate;
+    const double sweepTime = m_config.sweepTime;
+    const double wavelength = SPEED_OF_LIGHT / m_config.centerFrequency;
+    const double beatPerMetre = 2.0 * m_config.bandwidth / (SPEED_OF_LIGHT * sweepTime);
+
+    frame.complex_data.resize(antennas * chirps * samples);
+    frame.num_samples_per_chirp = uint32_t(samples);
+    frame.invalidateDerived();
+    m_re.resize(samples);
+    m_im.resize(samples);
+
+    // Uniform noise with the requested RMS: a * sqrt(3) bounds, 2^-31 per step
+    const float noiseScale = m_config.noiseLevel * std::sqrt(3.0f) / 2147483648.0f;
+
+    ComplexSample* out = frame.complex_data.data();
+    for (size_t a = 0; a < antennas; ++a) {
+        for (size_t c = 0; c < chirps; ++c) {
+            std::fill(m_re.begin(), m_re.end(), 0.0f);
+            std::fill(m_im.begin(), m_im.end(), 0.0f);
+
+            for (const Target& target : targets) {
+                const double range = target.range - double(target.radialSpeed) * sweepTime * double(c);
+                if (range <= 0.0) continue;
+                const double beat = beatPerMetre * range + 2.0 * target.radialSpeed / wavelength;
+                if (std::fabs(beat) >= sampleRate / 2.0) continue;
+
+                const double spreading = m_config.referenceRange / std::max(range, 0.1);
+                const float amplitude = float(std::min(1.0, m_config.referenceAmplitude
+                                                           * std::sqrt(std::max(target.rcs, 0.0f))
+                                                           * spreading * spreading));
+                const double carrier = std::fmod(-4.0 * PI * range / wavelength, 2.0 * PI);
+                const double steering = PI * std::sin(target.azimuth * PI / 180.0) * double(a);
+                addTone(carrier + steering, 2.0 * PI * beat / sampleRate, amplitude);
+            }
+
+            ComplexSample* chirp = out + (a * chirps + c) * samples;
+            for (size_t k = 0; k < samples; ++k) {
+                const uint64_t random = nextRandom();
+                chirp[k].I = m_re[k] + float(int32_t(uint32_t(random))) * noiseScale;
+                chirp[k].Q = m_im[k] + float(int32_t(uint32_t(random >> 32))) * noiseScale;
+            }
+        }
+    }
+}
+
+void SceneSimulator::addTone(double phase, double step, float amplitude)
+{
+    const size_t samples = m_re.size();
+    float* re = m_re.data();
+    float* im = m_im.data();
+
+    const float stepRe = float(std::cos(LANES * step));
+    const float stepIm = float(std::sin(LANES * step));
+
+    for (size_t block = 0; block < samples; block += ANCHOR_SAMPLES) {
+        const size_t end = std::min(samples, block + ANCHOR_SAMPLES);
+
+        // Lane l holds sample k + l; every lane advances by LANES samples
+        float zr[LANES];
+        float zi[LANES];
+        for (size_t l = 0; l < LANES; ++l) {
+            const double p = phase + step * double(block + l);
+            zr[l] = amplitude * float(std::cos(p));
+            zi[l] = amplitude * float(std::sin(p));
+        }
+
+        size_t k = block;
+        for (; k + LANES <= end; k += LANES) {
+            for (size_t l = 0; l < LANES; ++l) {
+                re[k + l] += zr[l];
+                im[k + l] += zi[l];
+                const float r = zr[l] * stepRe - zi[l] * stepIm;
+                zi[l] = zr[l] * stepIm + zi[l] * stepRe;
+                zr[l] = r;
+            }
+        }
+        for (size_t l = 0; k + l < end; ++l) {
+            re[k + l] += zr[l];
+            im[k + l] += zi[l];
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "DataStructures.h"
+
+// Synthesizes FMCW ADC frames (complex beat signals) of a scene of point
+// targets, in the FrameProcessor frame layout: antennas x chirps x samples,
+// antenna outermost, chirps back to back.
+//
+// Each target contributes a tone at its beat frequency 2 B R / (c T) plus
+// its Doppler shift, with a carrier phase of -4 pi R / lambda, so the phase
+// advances from chirp to chirp for an approaching target and the range
+// walks by v T per chirp. Receive antennas are half a wavelength apart.
+// Amplitude follows the radar equation: sqrt(RCS) / R^2, scaled so a 1 m^2
+// target at Config::referenceRange has Config::referenceAmplitude. Targets
+// whose beat frequency is beyond the ADC's Nyquist limit are left out, as
+// the IF filter would.
+//
+// Tones are generated by phase accumulation: a complex rotator per lane,
+// eight lanes advanced together, re-anchored on exact sin/cos every few
+// hundred samples. Noise comes from a seeded xorshift generator, so a seed
+// and a target list always give the same frame.
+class SceneSimulator
+{
+public:
+    struct Config {
+        float sampleRate;           // Hz
+        float sweepTime;            // s
+        float bandwidth;            // Hz
+        float centerFrequency;      // Hz
+        size_t samplesPerChirp;
+        size_t chirps;
+        size_t antennas;
+        float noiseLevel;           // RMS of I and Q, full scale = 1
+        float referenceRange;       // m
+        float referenceAmplitude;
+        uint64_t seed;
+
+        Config();
+    };
+
+    struct Target {
+        float range;                // m
+        float azimuth;              // degrees
+        float radialSpeed;          // m/s, positive = approaching
+        float rcs;                  // m^2
+    };
+
+    explicit SceneSimulator(const Config& config = Config());
+
+    // Restarts the noise sequence from config.seed
+    void setConfig(const Config& config);
+    const Config& config() const { return m_config; }
+
+    // Range of the highest beat frequency the ADC can take
+    float maxRange() const;
+
+    // Replaces frame's samples with the scene
+    void synthesize(const std::vector<Target>& targets, RawADCFrameTest& frame);
+
+private:
+    static constexpr size_t LANES = 8;
+    static constexpr size_t ANCHOR_SAMPLES = 512;   // Rotator re-anchored this often
+
+    void addTone(double phase, double step, float amplitude);
+    uint64_t nextRandom();
+
+    Config m_config;
+    uint64_t m_state;
+    AlignedVector<float> m_re;    // One chirp being summed
+    AlignedVector<float> m_im;
+};
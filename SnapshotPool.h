@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Recycling pool for per-frame snapshot objects (TargetTrackData,
+// RawADCFrameTest, ...). acquire() hands out a shared_ptr whose deleter puts
+// the object back instead of freeing it, so its vectors keep their capacity;
+// the shared_ptr control blocks are recycled the same way. Once the pool has
+// warmed up, publishing a frame allocates nothing.
+//
+// T must be default-constructible and provide reset() (empty, keep capacity).
+// Snapshots may outlive the pool and may be released from any thread.
+template <typename T>
+class SnapshotPool
+{
+public:
+    explicit SnapshotPool(size_t maxIdle = 16)
+        : m_state(std::make_shared<State>(maxIdle))
+    {
+    }
+
+    std::shared_ptr<T> acquire()
+    {
+        T* object = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            if (!m_state->idle.empty()) {
+                object = m_state->idle.back();
+                m_state->idle.pop_back();
+            }
+        }
+        if (!object) {
+            object = new T();
+        }
+        object->reset();
+
+        return std::shared_ptr<T>(object, Recycler{m_state}, BlockAllocator<T>(m_state));
+    }
+
+    size_t idleCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->idle.size();
+    }
+
+private:
+    struct State {
+        explicit State(size_t maxIdleObjects) : maxIdle(maxIdleObjects), blockSize(0)
+        {
+            idle.reserve(maxIdle);
+            freeBlocks.reserve(maxIdle * 2);
+        }
+        ~State()
+        {
+            for (T* object : idle) delete object;
+            for (void* block : freeBlocks) ::operator delete(block);
+        }
+
+        mutable std::mutex mutex;
+        std::vector<T*> idle;
+        size_t maxIdle;
+
+        // Control blocks all have one size per T; keep the freed ones
+        std::vector<void*> freeBlocks;
+        size_t blockSize;
+    };
+
+    // Returns the object to the pool, or deletes it if the pool is full
+    struct Recycler {
+        std::shared_ptr<State> state;
+
+        void operator()(T* object) const
+        {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->idle.size() < state->maxIdle) {
+                    state->idle.push_back(object);
+                    return;
+                }
+            }
+            delete object;
+        }
+    };
+
+    // Allocator for the shared_ptr control block. It holds its own reference
+    // to the State: the control block is freed after the Recycler (and its
+    // reference) has already been destroyed.
+    template <typename U>
+    struct BlockAllocator {
+        using value_type = U;
+
+        explicit BlockAllocator(const std::shared_ptr<State>& s) : state(s) {}
+        template <typename V>
+        BlockAllocator(const BlockAllocator<V>& other) : state(other.state) {}
+
+        U* allocate(size_t count)
+        {
+            const size_t bytes = count * sizeof(U);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (bytes == state->blockSize && !state->freeBlocks.empty()) {
+                    void* block = state->freeBlocks.back();
+                    state->freeBlocks.pop_back();
+                    return static_cast<U*>(block);
+                }
+                if (state->blockSize == 0) state->blockSize = bytes;
+            }
+            return static_cast<U*>(::operator new(bytes));
+        }
+
+        void deallocate(U* pointer, size_t count)
+        {
+            const size_t bytes = count * sizeof(U);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (bytes == state->blockSize && state->freeBlocks.size() < state->freeBlocks.capacity()) {
+                    state->freeBlocks.push_back(pointer);
+                    return;
+                }
+            }
+            ::operator delete(pointer);
+        }
+
+        template <typename V>
+        bool operator==(const BlockAllocator<V>& other) const { return state == other.state; }
+        template <typename V>
+        bool operator!=(const BlockAllocator<V>& other) const { return state != other.state; }
+
+        std::shared_ptr<State> state;
+    };
+
+    std::shared_ptr<State> m_state;
+};
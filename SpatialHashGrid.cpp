@@ -0,0 +1,56 @@
+#include "SpatialHashGrid.h"
+#include <algorithm>
+
+SpatialHashGrid::SpatialHashGrid()
+    : m_cellSize(1.0f)
+    , m_inverseCellSize(1.0f)
+    , m_hashShift(64)
+{
+}
+
+void SpatialHashGrid::clear()
+{
+    m_cellOf.clear();
+    m_bucketStart.clear();
+    m_sorted.clear();
+}
+
+void SpatialHashGrid::build(const float* x, const float* y, size_t count, float cellSize)
+{
+    m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+    m_inverseCellSize = 1.0f / m_cellSize;
+
+    if (count == 0) {
+        clear();
+        return;
+    }
+
+    // About two buckets per point keeps chains short
+    int bits = 1;
+    while ((size_t(1) << bits) < 2 * count && bits < 31) ++bits;
+    const size_t bucketCount = size_t(1) << bits;
+    m_hashShift = 64 - bits;
+
+    m_cellOf.resize(count);
+    m_bucketStart.assign(bucketCount + 1, 0);
+    m_sorted.resize(count);
+
+    // Count per bucket (shifted by one so the prefix sum yields start offsets)
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t key = cellKey(cellCoord(x[i]), cellCoord(y[i]));
+        m_cellOf[i] = key;
+        ++m_bucketStart[bucketOf(key) + 1];
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        m_bucketStart[b + 1] += m_bucketStart[b];
+    }
+
+    // Scatter, then restore the start offsets that the scatter advanced
+    for (size_t i = 0; i < count; ++i) {
+        m_sorted[m_bucketStart[bucketOf(m_cellOf[i])]++] = uint32_t(i);
+    }
+    for (size_t b = bucketCount; b > 0; --b) {
+        m_bucketStart[b] = m_bucketStart[b - 1];
+    }
+    m_bucketStart[0] = 0;
+}
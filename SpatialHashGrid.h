@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over 2D points, hashed so the covered area is unbounded.
+// build() buckets all points with one counting sort (O(n), buffers reused
+// between builds); queries visit only the cells overlapping the search area.
+// Bucket collisions are possible, so callers always test the real distance.
+class SpatialHashGrid
+{
+public:
+    SpatialHashGrid();
+
+    void build(const float* x, const float* y, size_t count, float cellSize);
+    void clear();
+
+    float cellSize() const { return m_cellSize; }
+    size_t size() const { return m_cellOf.size(); }
+
+    // Call visit(index) for every point in cells overlapping the
+    // axis-aligned box [minX, maxX] x [minY, maxY]
+    template <typename Visit>
+    void forEachInBox(float minX, float minY, float maxX, float maxY, Visit visit) const
+    {
+        if (m_bucketStart.empty()) return;
+
+        const int64_t cx0 = cellCoord(minX);
+        const int64_t cx1 = cellCoord(maxX);
+        const int64_t cy0 = cellCoord(minY);
+        const int64_t cy1 = cellCoord(maxY);
+
+        // A box much larger than the data: one pass over everything is cheaper
+        if ((cx1 - cx0 + 1) * (cy1 - cy0 + 1) >= int64_t(m_bucketStart.size())) {
+            for (size_t i = 0; i < m_cellOf.size(); ++i) visit(i);
+            return;
+        }
+
+        for (int64_t cy = cy0; cy <= cy1; ++cy) {
+            for (int64_t cx = cx0; cx <= cx1; ++cx) {
+                const uint64_t key = cellKey(cx, cy);
+                const size_t bucket = bucketOf(key);
+                for (uint32_t k = m_bucketStart[bucket]; k < m_bucketStart[bucket + 1]; ++k) {
+                    const uint32_t index = m_sorted[k];
+                    if (m_cellOf[index] == key) visit(index);
+                }
+            }
+        }
+    }
+
+    template <typename Visit>
+    void forEachInRadius(float x, float y, float radius, Visit visit) const
+    {
+        forEachInBox(x - radius, y - radius, x + radius, y + radius, visit);
+    }
+
+private:
+    int64_t cellCoord(float value) const { return int64_t(std::floor(value * m_inverseCellSize)); }
+    static uint64_t cellKey(int64_t cx, int64_t cy)
+    {
+        return (uint64_t(uint32_t(int32_t(cx))) << 32) | uint64_t(uint32_t(int32_t(cy)));
+    }
+    size_t bucketOf(uint64_t key) const
+    {
+        // Fibonacci hashing into a power-of-two table
+        return size_t((key * 0x9E3779B97F4A7C15ull) >> m_hashShift);
+    }
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    int m_hashShift;
+    std::vector<uint64_t> m_cellOf;       // Cell key per point
+    std::vector<uint32_t> m_bucketStart;  // Prefix sums, bucketCount + 1 entries
+    std::vector<uint32_t> m_sorted;       // Point indices grouped by bucket
+};
@@ -0,0 +1,94 @@
+#include "TrackArrays.h"
+
+void TrackArrays::resize(size_t count)
+{
+    target_id.resize(count);
+    level.resize(count);
+    radius.resize(count);
+    azimuth.resize(count);
+    elevation.resize(count);
+    radial_speed.resize(count);
+    azimuth_speed.resize(count);
+    elevation_speed.resize(count);
+}
+
+void TrackArrays::assign(const TargetTrackData& trackData)
+{
+    const size_t count = trackData.targets.size();
+    resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        set(i, trackData.targets[i]);
+    }
+}
+
+void TrackArrays::set(size_t index, const TargetTrack& target)
+{
+    target_id[index] = target.target_id;
+    level[index] = target.level;
+    radius[index] = target.radius;
+    azimuth[index] = target.azimuth;
+    elevation[index] = target.elevation;
+    radial_speed[index] = target.radial_speed;
+    azimuth_speed[index] = target.azimuth_speed;
+    elevation_speed[index] = target.elevation_speed;
+}
+
+TargetTrack TrackArrays::at(size_t index) const
+{
+    TargetTrack target;
+    target.target_id = target_id[index];
+    target.level = level[index];
+    target.radius = radius[index];
+    target.azimuth = azimuth[index];
+    target.elevation = elevation[index];
+    target.radial_speed = radial_speed[index];
+    target.azimuth_speed = azimuth_speed[index];
+    target.elevation_speed = elevation_speed[index];
+    return target;
+}
+
+void TrackArrays::toTrackData(TargetTrackData& trackData) const
+{
+    trackData.resize(static_cast<uint32_t>(size()));
+    for (size_t i = 0; i < size(); ++i) {
+        trackData.targets[i] = at(i);
+    }
+}
+
+void polarToScreen(const float* range, const float* azimuthDeg, size_t count,
+                   const PolarScreenMapping& mapping, float* x, float* y)
+{
+    const float degToRad = 3.14159265358979f / 180.0f;
+    const float inverseTwoPi = 0.159154943091895f;
+    const float twoPi = 6.28318530717959f;
+    const float roundingBias = 12582912.0f;
+
+    const float cx = mapping.centerX;
+    const float cy = mapping.centerY;
+    const float scale = mapping.pixelsPerMeter;
+
+    for (size_t i = 0; i < count; ++i) {
+        // Wrap to [-pi, pi]. Rounding via the 1.5 * 2^23 trick instead of an
+        // int conversion, which GCC will not if-convert without fast-math
+        float a = azimuthDeg[i] * degToRad;
+        float turns = (a * inverseTwoPi + roundingBias) - roundingBias;
+        a -= twoPi * turns;
+
+        // Evaluate at the half angle, which lies in [-pi/2, pi/2] where the
+        // polynomials are accurate, then double it. Unlike folding into a
+        // quadrant this needs no comparisons, which would block vectorization.
+        float h = 0.5f * a;
+        float h2 = h * h;
+        float sinH = h * (1.0f + h2 * (-1.0f / 6.0f + h2 * (1.0f / 120.0f
+                   + h2 * (-1.0f / 5040.0f + h2 * (1.0f / 362880.0f
+                   + h2 * (-1.0f / 39916800.0f))))));
+        float cosH = 1.0f + h2 * (-0.5f + h2 * (1.0f / 24.0f + h2 * (-1.0f / 720.0f
+                   + h2 * (1.0f / 40320.0f + h2 * (-1.0f / 3628800.0f)))));
+        float sinA = 2.0f * sinH * cosH;
+        float cosA = 1.0f - 2.0f * sinH * sinH;
+
+        float r = range[i] * scale;
+        x[i] = cx + r * sinA;
+        y[i] = cy - r * cosA;
+    }
+}
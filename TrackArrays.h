@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "AlignedAllocator.h"
+#include "DataStructures.h"
+
+// Structure-of-arrays copy of a track set.
+// Each TargetTrack field lives in its own 64-byte aligned column, so per-frame
+// passes over one or two fields (range/azimuth for drawing, rates for
+// extrapolation) stream contiguous floats and vectorize.
+struct TrackArrays {
+    AlignedVector<uint32_t> target_id;
+    AlignedVector<float> level;
+    AlignedVector<float> radius;
+    AlignedVector<float> azimuth;
+    AlignedVector<float> elevation;
+    AlignedVector<float> radial_speed;
+    AlignedVector<float> azimuth_speed;
+    AlignedVector<float> elevation_speed;
+
+    size_t size() const { return target_id.size(); }
+    bool empty() const { return target_id.empty(); }
+
+    void resize(size_t count);
+    void clear() { resize(0); }
+
+    void assign(const TargetTrackData& trackData);
+    void set(size_t index, const TargetTrack& target);
+    TargetTrack at(size_t index) const;
+    void toTrackData(TargetTrackData& trackData) const;
+};
+
+// Polar (range, azimuth) to screen mapping used by the PPI:
+// 0° azimuth points up, positive azimuth is clockwise, y grows downwards.
+//   x = centerX + range * pixelsPerMeter * sin(azimuth)
+//   y = centerY - range * pixelsPerMeter * cos(azimuth)
+struct PolarScreenMapping {
+    float centerX;
+    float centerY;
+    float pixelsPerMeter;
+};
+
+// Convert count points in one branch-free pass (polynomial sin/cos, no libm
+// calls) that the compiler vectorizes. Accurate to well under 0.01 px at
+// typical plot radii.
+void polarToScreen(const float* range, const float* azimuthDeg, size_t count,
+                   const PolarScreenMapping& mapping, float* x, float* y);
@@ -0,0 +1,67 @@
+#include "TrackExtrapolator.h"
+#include <algorithm>
+
+TrackExtrapolator::TrackExtrapolator()
+    : m_maxExtrapolation(0.25f)
+    , m_reportTime(0.0)
+{
+}
+
+void TrackExtrapolator::setReports(const TrackArrays& tracks, double reportTime)
+{
+    const size_t count = tracks.size();
+    m_reportTime = reportTime;
+
+    // The input is already column-major, so latching is straight copies
+    m_range0.assign(tracks.radius.begin(), tracks.radius.end());
+    m_azimuth0.assign(tracks.azimuth.begin(), tracks.azimuth.end());
+    m_azimuthRate.assign(tracks.azimuth_speed.begin(), tracks.azimuth_speed.end());
+    m_range = m_range0;
+    m_azimuth = m_azimuth0;
+    m_coasting.assign(count, 0);
+
+    m_rangeRate.resize(count);
+    const float* radialSpeed = tracks.radial_speed.data();
+    float* rangeRate = m_rangeRate.data();
+    for (size_t i = 0; i < count; ++i) {
+        rangeRate[i] = -radialSpeed[i];
+    }
+}
+
+void TrackExtrapolator::clear()
+{
+    m_range0.clear();
+    m_azimuth0.clear();
+    m_rangeRate.clear();
+    m_azimuthRate.clear();
+    m_range.clear();
+    m_azimuth.clear();
+    m_coasting.clear();
+}
+
+void TrackExtrapolator::extrapolate(double displayTime)
+{
+    const size_t count = m_range0.size();
+    const float age = static_cast<float>(displayTime - m_reportTime);
+    const float dt = age < 0.0f ? 0.0f : (age > m_maxExtrapolation ? m_maxExtrapolation : age);
+
+    const float* range0 = m_range0.data();
+    const float* azimuth0 = m_azimuth0.data();
+    const float* rangeRate = m_rangeRate.data();
+    const float* azimuthRate = m_azimuthRate.data();
+    float* range = m_range.data();
+    float* azimuth = m_azimuth.data();
+
+    // Branch-free and split per output so each loop stays within the
+    // compiler's alias-check budget and vectorizes across tracks
+    for (size_t i = 0; i < count; ++i) {
+        float r = range0[i] + rangeRate[i] * dt;
+        range[i] = r > 0.0f ? r : 0.0f;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        azimuth[i] = azimuth0[i] + azimuthRate[i] * dt;
+    }
+
+    std::fill(m_coasting.begin(), m_coasting.end(), static_cast<uint8_t>(age > m_maxExtrapolation));
+}
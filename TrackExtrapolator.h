@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "AlignedAllocator.h"
+#include "TrackArrays.h"
+
+// Dead-reckoning of reported tracks to the display time.
+// Positions are advanced from the last report with the track's own rates:
+//   range(t)   = range   - radial_speed  * dt   (positive speed = approaching)
+//   azimuth(t) = azimuth + azimuth_speed * dt
+// dt is capped at maxExtrapolation; tracks whose report is older than the cap
+// are flagged as coasting so the display can mark them.
+// State is kept as flat arrays so one pass updates every track.
+class TrackExtrapolator
+{
+public:
+    TrackExtrapolator();
+
+    void setMaxExtrapolation(double seconds) { m_maxExtrapolation = static_cast<float>(seconds); }
+    double maxExtrapolation() const { return m_maxExtrapolation; }
+
+    // Latch a new set of reports, all taken at reportTime (seconds)
+    void setReports(const TrackArrays& tracks, double reportTime);
+    void clear();
+
+    // Advance every track to displayTime (seconds, same clock as reportTime)
+    void extrapolate(double displayTime);
+
+    size_t size() const { return m_range0.size(); }
+    const float* ranges() const { return m_range.data(); }
+    const float* azimuths() const { return m_azimuth.data(); }
+    const uint8_t* coasting() const { return m_coasting.data(); }
+
+private:
+    float m_maxExtrapolation;
+    double m_reportTime;              // All latched reports share it
+
+    // Last report
+    AlignedVector<float> m_range0;
+    AlignedVector<float> m_azimuth0;
+    AlignedVector<float> m_rangeRate;   // m/s, already negated radial_speed
+    AlignedVector<float> m_azimuthRate; // deg/s
+
+    // Extrapolated output
+    AlignedVector<float> m_range;
+    AlignedVector<float> m_azimuth;
+    AlignedVector<uint8_t> m_coasting;
+};
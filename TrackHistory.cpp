@@ -0,0 +1,152 @@
+#include "TrackHistory.h"
+#include <algorithm>
+
+TrackHistory::TrackHistory(int pointsPerTrack, size_t memoryLimitBytes, double maxAgeSeconds)
+    : m_capacity(std::max(2, pointsPerTrack))
+    , m_memoryLimit(memoryLimitBytes)
+    , m_maxAge(maxAgeSeconds)
+    , m_maxTracks(0)
+    , m_lruHead(-1)
+    , m_lruTail(-1)
+    , m_geometryGeneration(0)
+{
+    reallocate();
+}
+
+void TrackHistory::setPointsPerTrack(int points)
+{
+    points = std::max(2, points);
+    if (points == m_capacity) return;
+
+    m_capacity = points;
+    reallocate();
+}
+
+void TrackHistory::setMemoryLimit(size_t bytes)
+{
+    if (bytes == m_memoryLimit) return;
+
+    m_memoryLimit = bytes;
+    reallocate();
+}
+
+void TrackHistory::reallocate()
+{
+    // Every point costs its polar record plus its cached screen position
+    const size_t bytesPerTrack = size_t(m_capacity) * (sizeof(TrackHistoryPoint) + sizeof(QPointF)) + sizeof(Slot);
+    m_maxTracks = static_cast<int>(std::max<size_t>(1, m_memoryLimit / bytesPerTrack));
+
+    m_points.assign(size_t(m_maxTracks) * m_capacity, TrackHistoryPoint{0.0, 0.0f, 0.0f});
+    m_screenPoints.assign(size_t(m_maxTracks) * m_capacity, QPointF());
+    m_slots.assign(m_maxTracks, Slot{});
+
+    clear();
+}
+
+void TrackHistory::clear()
+{
+    m_slotById.clear();
+    m_freeSlots.clear();
+    m_freeSlots.reserve(m_maxTracks);
+    for (int i = m_maxTracks - 1; i >= 0; --i) {
+        m_freeSlots.push_back(i);
+    }
+    m_lruHead = -1;
+    m_lruTail = -1;
+}
+
+void TrackHistory::update(const TargetTrackData& trackData, double timeSeconds)
+{
+    for (const auto& target : trackData.targets) {
+        int slotIndex = m_slotById.value(target.target_id, -1);
+        if (slotIndex < 0) {
+            slotIndex = acquireSlot(target.target_id);
+        } else {
+            lruUnlink(slotIndex);
+        }
+        lruPushFront(slotIndex);
+
+        Slot& slot = m_slots[slotIndex];
+        slot.lastSeen = timeSeconds;
+
+        int position;
+        if (slot.count < m_capacity) {
+            position = (slot.head + slot.count) % m_capacity;
+            ++slot.count;
+        } else {
+            // Ring full: overwrite the oldest point
+            position = slot.head;
+            slot.head = (slot.head + 1) % m_capacity;
+        }
+
+        m_points[size_t(slotIndex) * m_capacity + position] =
+            TrackHistoryPoint{timeSeconds, target.radius, target.azimuth};
+        ++slot.appended;
+    }
+
+    // Age out tracks from the cold end of the LRU list
+    const double cutoff = timeSeconds - m_maxAge;
+    while (m_lruTail >= 0 && m_slots[m_lruTail].lastSeen < cutoff) {
+        releaseSlot(m_lruTail);
+    }
+}
+
+int TrackHistory::acquireSlot(uint32_t targetId)
+{
+    if (m_freeSlots.empty()) {
+        // Memory limit reached: recycle the least recently updated track
+        releaseSlot(m_lruTail);
+    }
+
+    int slotIndex = m_freeSlots.back();
+    m_freeSlots.pop_back();
+
+    Slot& slot = m_slots[slotIndex];
+    slot = Slot{};
+    slot.targetId = targetId;
+    slot.cacheGeneration = m_geometryGeneration;
+    slot.lruPrev = -1;
+    slot.lruNext = -1;
+
+    m_slotById.insert(targetId, slotIndex);
+    return slotIndex;
+}
+
+void TrackHistory::releaseSlot(int slotIndex)
+{
+    lruUnlink(slotIndex);
+    m_slotById.remove(m_slots[slotIndex].targetId);
+    m_slots[slotIndex].count = 0;
+    m_freeSlots.push_back(slotIndex);
+}
+
+void TrackHistory::lruUnlink(int slotIndex)
+{
+    Slot& slot = m_slots[slotIndex];
+    if (slot.lruPrev >= 0) {
+        m_slots[slot.lruPrev].lruNext = slot.lruNext;
+    } else if (m_lruHead == slotIndex) {
+        m_lruHead = slot.lruNext;
+    }
+    if (slot.lruNext >= 0) {
+        m_slots[slot.lruNext].lruPrev = slot.lruPrev;
+    } else if (m_lruTail == slotIndex) {
+        m_lruTail = slot.lruPrev;
+    }
+    slot.lruPrev = -1;
+    slot.lruNext = -1;
+}
+
+void TrackHistory::lruPushFront(int slotIndex)
+{
+    Slot& slot = m_slots[slotIndex];
+    slot.lruPrev = -1;
+    slot.lruNext = m_lruHead;
+    if (m_lruHead >= 0) {
+        m_slots[m_lruHead].lruPrev = slotIndex;
+    }
+    m_lruHead = slotIndex;
+    if (m_lruTail < 0) {
+        m_lruTail = slotIndex;
+    }
+}
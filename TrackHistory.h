@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QHash>
+#include <QLineF>
+#include <QPointF>
+#include <QVector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+
+// One reported position of a track
+struct TrackHistoryPoint {
+    double time;     // seconds
+    float range;     // m
+    float azimuth;   // degrees
+};
+
+// Per-track position history for drawing motion trails.
+// Every track owns a fixed-capacity ring in one preallocated slab, so appends
+// never allocate. Tracks not seen for maxAge seconds are dropped, and when the
+// memory limit is reached the least recently updated track is recycled.
+// Screen coordinates are cached per point and only recomputed after a
+// geometry change, so drawing does no trig for points already on screen.
+class TrackHistory
+{
+public:
+    explicit TrackHistory(int pointsPerTrack = 32, size_t memoryLimitBytes = 16 * 1024 * 1024,
+                          double maxAgeSeconds = 5.0);
+
+    void setPointsPerTrack(int points);
+    void setMemoryLimit(size_t bytes);
+    void setMaxAge(double seconds) { m_maxAge = seconds; }
+
+    int pointsPerTrack() const { return m_capacity; }
+    int maxTracks() const { return m_maxTracks; }
+    int trackCount() const { return m_slotById.size(); }
+
+    void update(const TargetTrackData& trackData, double timeSeconds);
+    void clear();
+
+    // Call when the range scale or widget geometry changes
+    void invalidateGeometry() { ++m_geometryGeneration; }
+
+    // Append every trail as line segments, refreshing stale screen coordinates
+    // with toScreen(range, azimuth) -> QPointF
+    template <typename Transform>
+    void collectSegments(QVector<QLineF>& segments, Transform toScreen);
+
+private:
+    struct Slot {
+        uint32_t targetId;
+        int head;              // Index of the oldest point in the ring
+        int count;
+        double lastSeen;
+        uint64_t appended;     // Points ever appended (for incremental caching)
+        uint64_t cachedUpTo;   // Value of appended when the screen cache was last refreshed
+        uint64_t cacheGeneration;
+        int lruPrev;
+        int lruNext;
+    };
+
+    void reallocate();
+    int acquireSlot(uint32_t targetId);
+    void releaseSlot(int slot);
+    void lruUnlink(int slot);
+    void lruPushFront(int slot);
+
+    int m_capacity;            // Points per track
+    size_t m_memoryLimit;
+    double m_maxAge;
+    int m_maxTracks;
+
+    std::vector<TrackHistoryPoint> m_points;  // m_maxTracks * m_capacity
+    std::vector<QPointF> m_screenPoints;      // Cached screen position per point
+    std::vector<Slot> m_slots;
+    std::vector<int> m_freeSlots;
+    QHash<uint32_t, int> m_slotById;
+
+    int m_lruHead;             // Most recently updated
+    int m_lruTail;             // Least recently updated
+    uint64_t m_geometryGeneration;
+};
+
+template <typename Transform>
+void TrackHistory::collectSegments(QVector<QLineF>& segments, Transform toScreen)
+{
+    for (int slotIndex = m_lruHead; slotIndex >= 0; slotIndex = m_slots[slotIndex].lruNext) {
+        Slot& slot = m_slots[slotIndex];
+        if (slot.count < 2) continue;
+
+        const size_t base = size_t(slotIndex) * m_capacity;
+
+        // Only points appended since the last refresh need converting,
+        // unless the geometry changed underneath the whole cache
+        int stale = slot.count;
+        if (slot.cacheGeneration == m_geometryGeneration) {
+            stale = static_cast<int>(std::min<uint64_t>(slot.count, slot.appended - slot.cachedUpTo));
+        }
+        for (int i = slot.count - stale; i < slot.count; ++i) {
+            size_t index = base + (slot.head + i) % m_capacity;
+            m_screenPoints[index] = toScreen(m_points[index].range, m_points[index].azimuth);
+        }
+        slot.cacheGeneration = m_geometryGeneration;
+        slot.cachedUpTo = slot.appended;
+
+        QPointF previous = m_screenPoints[base + slot.head];
+        for (int i = 1; i < slot.count; ++i) {
+            const QPointF& current = m_screenPoints[base + (slot.head + i) % m_capacity];
+            segments.append(QLineF(previous, current));
+            previous = current;
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "TrackTableModel.h"
+#include <algorithm>
+
+TrackTableModel::TrackTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void TrackTableModel::updateTracks(const TargetTrackData& trackData)
+{
+    const std::vector<TargetTrack>& incoming = trackData.targets;
+    const int count = static_cast<int>(std::min<size_t>(trackData.numTracks, incoming.size()));
+
+    // Index the update by target_id (a duplicated ID keeps its last entry)
+    m_incomingById.clear();
+    m_incomingById.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        m_incomingById.insert(incoming[i].target_id, i);
+    }
+
+    // Remove rows whose target is gone, back to front in contiguous runs
+    int row = static_cast<int>(m_rows.size()) - 1;
+    while (row >= 0) {
+        if (m_incomingById.contains(m_rows[row].target_id)) {
+            --row;
+            continue;
+        }
+
+        int last = row;
+        while (row >= 0 && !m_incomingById.contains(m_rows[row].target_id)) {
+            --row;
+        }
+        int first = row + 1;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    // Update surviving rows in place, signalling only runs that changed
+    int runStart = -1;
+    for (int r = 0; r < static_cast<int>(m_rows.size()); ++r) {
+        const TargetTrack& update = incoming[m_incomingById.value(m_rows[r].target_id)];
+        bool changed = !sameValues(m_rows[r], update);
+        if (changed) {
+            m_rows[r] = update;
+            if (runStart < 0) {
+                runStart = r;
+            }
+        } else if (runStart >= 0) {
+            emit dataChanged(index(runStart, 0), index(r - 1, ColumnCount - 1));
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0) {
+        emit dataChanged(index(runStart, 0), index(static_cast<int>(m_rows.size()) - 1, ColumnCount - 1));
+    }
+
+    rebuildRowIndex();
+
+    // Append new targets in the order they arrived
+    int newCount = 0;
+    for (int i = 0; i < count; ++i) {
+        uint32_t id = incoming[i].target_id;
+        if (m_incomingById.value(id) == i && !m_rowById.contains(id)) {
+            ++newCount;
+        }
+    }
+
+    if (newCount > 0) {
+        int first = static_cast<int>(m_rows.size());
+        beginInsertRows(QModelIndex(), first, first + newCount - 1);
+        for (int i = 0; i < count; ++i) {
+            uint32_t id = incoming[i].target_id;
+            if (m_incomingById.value(id) == i && !m_rowById.contains(id)) {
+                m_rowById.insert(id, static_cast<int>(m_rows.size()));
+                m_rows.push_back(incoming[i]);
+            }
+        }
+        endInsertRows();
+    }
+}
+
+void TrackTableModel::updateTracks(const TrackSnapshotPtr& snapshot)
+{
+    if (!snapshot) {
+        clear();
+        return;
+    }
+    if (snapshot == m_snapshot) return;
+
+    m_snapshot = snapshot;
+    updateTracks(*snapshot);
+}
+
+void TrackTableModel::clear()
+{
+    m_snapshot.reset();
+    if (m_rows.empty()) return;
+
+    beginResetModel();
+    m_rows.clear();
+    m_rowById.clear();
+    endResetModel();
+}
+
+int TrackTableModel::rowForTargetId(uint32_t targetId) const
+{
+    return m_rowById.value(targetId, -1);
+}
+
+uint32_t TrackTableModel::targetIdAt(int row) const
+{
+    if (row < 0 || row >= static_cast<int>(m_rows.size())) return 0;
+    return m_rows[row].target_id;
+}
+
+int TrackTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int TrackTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TrackTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size())) {
+        return QVariant();
+    }
+
+    if (role == Qt::TextAlignmentRole) {
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const TargetTrack& target = m_rows[index.row()];
+    switch (index.column()) {
+    case ColumnId:             return QString::number(target.target_id);
+    case ColumnLevel:          return QString::number(target.level, 'f', 1);
+    case ColumnRange:          return QString::number(target.radius, 'f', 2);
+    case ColumnAzimuth:        return QString::number(target.azimuth, 'f', 1);
+    case ColumnElevation:      return QString::number(target.elevation, 'f', 1);
+    case ColumnRadialSpeed:    return QString::number(target.radial_speed, 'f', 1);
+    case ColumnAzimuthSpeed:   return QString::number(target.azimuth_speed, 'f', 2);
+    case ColumnElevationSpeed: return QString::number(target.elevation_speed, 'f', 2);
+    default:                   return QVariant();
+    }
+}
+
+QVariant TrackTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case ColumnId:             return QStringLiteral("ID");
+    case ColumnLevel:          return QStringLiteral("Level (dB)");
+    case ColumnRange:          return QStringLiteral("Range (m)");
+    case ColumnAzimuth:        return QStringLiteral("Azimuth (°)");
+    case ColumnElevation:      return QStringLiteral("Elevation (°)");
+    case ColumnRadialSpeed:    return QStringLiteral("Radial Speed (m/s)");
+    case ColumnAzimuthSpeed:   return QStringLiteral("Azimuth Speed (°/s)");
+    case ColumnElevationSpeed: return QStringLiteral("Elevation Speed (°/s)");
+    default:                   return QVariant();
+    }
+}
+
+bool TrackTableModel::sameValues(const TargetTrack& a, const TargetTrack& b)
+{
+    return a.level == b.level
+        && a.radius == b.radius
+        && a.azimuth == b.azimuth
+        && a.elevation == b.elevation
+        && a.radial_speed == b.radial_speed
+        && a.azimuth_speed == b.azimuth_speed
+        && a.elevation_speed == b.elevation_speed;
+}
+
+void TrackTableModel::rebuildRowIndex()
+{
+    m_rowById.clear();
+    m_rowById.reserve(static_cast<int>(m_rows.size()));
+    for (int r = 0; r < static_cast<int>(m_rows.size()); ++r) {
+        m_rowById.insert(m_rows[r].target_id, r);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <vector>
+#include "DataStructures.h"
+
+// Table model over the current track snapshot.
+// Rows are keyed by target_id: an update only emits dataChanged for rows
+// whose values changed and row insert/remove for tracks that appeared or
+// disappeared, so the view never rebuilds its items on a tick.
+class TrackTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        ColumnId = 0,
+        ColumnLevel,
+        ColumnRange,
+        ColumnAzimuth,
+        ColumnElevation,
+        ColumnRadialSpeed,
+        ColumnAzimuthSpeed,
+        ColumnElevationSpeed,
+        ColumnCount
+    };
+
+    explicit TrackTableModel(QObject *parent = nullptr);
+
+    void updateTracks(const TargetTrackData& trackData);
+    void updateTracks(const TrackSnapshotPtr& snapshot);  // No-op for the snapshot already shown
+    void clear();
+
+    int rowForTargetId(uint32_t targetId) const;  // -1 if not present
+    uint32_t targetIdAt(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    static bool sameValues(const TargetTrack& a, const TargetTrack& b);
+    void rebuildRowIndex();
+
+    std::vector<TargetTrack> m_rows;
+    QHash<uint32_t, int> m_rowById;      // target_id -> row
+    QHash<uint32_t, int> m_incomingById; // scratch: target_id -> index in update
+    TrackSnapshotPtr m_snapshot;         // Last snapshot applied
+};
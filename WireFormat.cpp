@@ -0,0 +1,274 @@
+#include "WireFormat.h"
+#include <cstring>
+
+namespace {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool HOST_IS_LITTLE_ENDIAN = false;
+#else
+const bool HOST_IS_LITTLE_ENDIAN = true;
+#endif
+
+// Little-endian field access; byte-wise so unaligned buffers are fine
+class Writer
+{
+public:
+    explicit Writer(uint8_t* out) : m_out(out) {}
+
+    void u8(uint8_t value) { *m_out++ = value; }
+    void u16(uint16_t value)
+    {
+        m_out[0] = uint8_t(value);
+        m_out[1] = uint8_t(value >> 8);
+        m_out += 2;
+    }
+    void u32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) m_out[i] = uint8_t(value >> (8 * i));
+        m_out += 4;
+    }
+    void u64(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i) m_out[i] = uint8_t(value >> (8 * i));
+        m_out += 8;
+    }
+    void f32(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    // Bulk copy of float32 values (fast path: plain memcpy on little-endian hosts)
+    void f32Array(const float* values, size_t count)
+    {
+        if (HOST_IS_LITTLE_ENDIAN) {
+            std::memcpy(m_out, values, count * sizeof(float));
+            m_out += count * sizeof(float);
+        } else {
+            for (size_t i = 0; i < count; ++i) f32(values[i]);
+        }
+    }
+
+private:
+    uint8_t* m_out;
+};
+
+class Reader
+{
+public:
+    Reader(const uint8_t* data, size_t size) : m_data(data), m_remaining(size) {}
+
+    size_t remaining() const { return m_remaining; }
+    bool has(size_t bytes) const { return m_remaining >= bytes; }
+
+    // Callers check has() first
+    uint8_t u8() { m_remaining -= 1; return *m_data++; }
+    uint16_t u16()
+    {
+        uint16_t value = uint16_t(m_data[0] | (m_data[1] << 8));
+        advance(2);
+        return value;
+    }
+    uint32_t u32()
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= uint32_t(m_data[i]) << (8 * i);
+        advance(4);
+        return value;
+    }
+    uint64_t u64()
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) value |= uint64_t(m_data[i]) << (8 * i);
+        advance(8);
+        return value;
+    }
+    float f32()
+    {
+        uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void f32Array(float* values, size_t count)
+    {
+        if (HOST_IS_LITTLE_ENDIAN) {
+            std::memcpy(values, m_data, count * sizeof(float));
+            advance(count * sizeof(float));
+        } else {
+            for (size_t i = 0; i < count; ++i) values[i] = f32();
+        }
+    }
+
+private:
+    void advance(size_t bytes) { m_data += bytes; m_remaining -= bytes; }
+
+    const uint8_t* m_data;
+    size_t m_remaining;
+};
+
+void writeSettings(Writer& writer, const DSP_Settings_t& settings)
+{
+    writer.u8(settings.range_mvg_avg_length);
+    writer.u16(settings.min_range_cm);
+    writer.u16(settings.max_range_cm);
+    writer.u16(settings.min_speed_kmh);
+    writer.u16(settings.max_speed_kmh);
+    writer.u16(settings.min_angle_degree);
+    writer.u16(settings.max_angle_degree);
+    writer.u16(settings.range_threshold);
+    writer.u16(settings.speed_threshold);
+    writer.u8(settings.enable_tracking);
+    writer.u8(settings.num_of_tracks);
+    writer.u8(settings.median_filter_length);
+    writer.u8(settings.enable_mti_filter);
+    writer.u16(settings.mti_filter_length);
+}
+
+void readSettings(Reader& reader, DSP_Settings_t& settings)
+{
+    settings.range_mvg_avg_length = reader.u8();
+    settings.min_range_cm = reader.u16();
+    settings.max_range_cm = reader.u16();
+    settings.min_speed_kmh = reader.u16();
+    settings.max_speed_kmh = reader.u16();
+    settings.min_angle_degree = reader.u16();
+    settings.max_angle_degree = reader.u16();
+    settings.range_threshold = reader.u16();
+    settings.speed_threshold = reader.u16();
+    settings.enable_tracking = reader.u8();
+    settings.num_of_tracks = reader.u8();
+    settings.median_filter_length = reader.u8();
+    settings.enable_mti_filter = reader.u8();
+    settings.mti_filter_length = reader.u16();
+}
+
+} // namespace
+
+namespace WireFormat {
+
+void serializeHeader(const MessageHeader& header, uint8_t* out)
+{
+    Writer writer(out);
+    writer.u8(static_cast<uint8_t>(header.type));
+    writer.u32(header.data_size);
+    writer.u64(header.timestamp);
+}
+
+bool deserializeHeader(const uint8_t* data, size_t size, MessageHeader& header)
+{
+    Reader reader(data, size);
+    if (!reader.has(sizeof(MessageHeader))) return false;
+
+    uint8_t type = reader.u8();
+    if (type != uint8_t(MessageType::TARGET_TRACK_DATA) && type != uint8_t(MessageType::RAW_ADC_DATA)) {
+        return false;
+    }
+    header.type = static_cast<MessageType>(type);
+    header.data_size = reader.u32();
+    header.timestamp = reader.u64();
+    return true;
+}
+
+void serializeTracks(const TargetTrackData& trackData, uint64_t timestamp, std::vector<uint8_t>& out)
+{
+    const size_t payloadSize = sizeof(TargetTrackListHeader) + trackData.targets.size() * sizeof(TargetTrackRecord);
+    out.resize(sizeof(MessageHeader) + payloadSize);
+
+    MessageHeader header;
+    header.type = MessageType::TARGET_TRACK_DATA;
+    header.data_size = static_cast<uint32_t>(payloadSize);
+    header.timestamp = timestamp;
+    serializeHeader(header, out.data());
+
+    Writer writer(out.data() + sizeof(MessageHeader));
+    writer.u32(static_cast<uint32_t>(trackData.targets.size()));
+    for (const TargetTrack& target : trackData.targets) {
+        writer.u32(target.target_id);
+        writer.f32(target.level);
+        writer.f32(target.radius * 100.0f);  // m -> cm
+        writer.f32(target.azimuth);
+        writer.f32(target.elevation);
+        writer.f32(target.radial_speed);
+        writer.f32(target.azimuth_speed);
+        writer.f32(target.elevation_speed);
+    }
+}
+
+bool deserializeTracks(const uint8_t* payload, size_t size, TargetTrackData& trackData)
+{
+    Reader reader(payload, size);
+    if (!reader.has(sizeof(TargetTrackListHeader))) return false;
+
+    uint32_t numTracks = reader.u32();
+    if (reader.remaining() / sizeof(TargetTrackRecord) < numTracks) return false;
+
+    trackData.resize(numTracks);
+    for (TargetTrack& target : trackData.targets) {
+        target.target_id = reader.u32();
+        target.level = reader.f32();
+        target.radius = reader.f32() / 100.0f;  // cm -> m
+        target.azimuth = reader.f32();
+        target.elevation = reader.f32();
+        target.radial_speed = reader.f32();
+        target.azimuth_speed = reader.f32();
+        target.elevation_speed = reader.f32();
+    }
+    return true;
+}
+
+void serializeADCFrame(const RawADCFrameTest& frame, uint64_t timestamp, std::vector<uint8_t>& out)
+{
+    const size_t numSamples = frame.complex_data.size();
+    const size_t payloadSize = sizeof(ADCFrameRecord) + numSamples * sizeof(ComplexSample);
+    out.resize(sizeof(MessageHeader) + payloadSize);
+
+    MessageHeader header;
+    header.type = MessageType::RAW_ADC_DATA;
+    header.data_size = static_cast<uint32_t>(payloadSize);
+    header.timestamp = timestamp;
+    serializeHeader(header, out.data());
+
+    Writer writer(out.data() + sizeof(MessageHeader));
+    writer.u32(frame.msgId);
+    writer.u32(static_cast<uint32_t>(numSamples));
+    writer.f32Array(reinterpret_cast<const float*>(frame.complex_data.data()), numSamples * 2);
+}
+
+bool deserializeADCFrame(const uint8_t* payload, size_t size, RawADCFrameTest& frame)
+{
+    Reader reader(payload, size);
+    if (!reader.has(sizeof(ADCFrameRecord))) return false;
+
+    uint32_t msgId = reader.u32();
+    uint32_t numSamples = reader.u32();
+    if (reader.remaining() / sizeof(ComplexSample) < numSamples) return false;
+
+    frame.msgId = msgId;
+    frame.num_samples_per_chirp = numSamples;
+    frame.complex_data.resize(numSamples);
+    reader.f32Array(reinterpret_cast<float*>(frame.complex_data.data()), size_t(numSamples) * 2);
+    frame.invalidateDerived();
+    return true;
+}
+
+void serializeDspMessage(const dsp_message_t& message, uint8_t* out)
+{
+    Writer writer(out);
+    writer.u32(message.msg_type);
+    writeSettings(writer, message.settings);
+}
+
+bool deserializeDspMessage(const uint8_t* data, size_t size, dsp_message_t& message)
+{
+    Reader reader(data, size);
+    if (!reader.has(sizeof(dsp_message_t))) return false;
+
+    message.msg_type = reader.u32();
+    readSettings(reader, message.settings);
+    return true;
+}
+
+} // namespace WireFormat
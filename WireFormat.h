@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataStructures.h"
+
+// On-wire (UDP) message layouts.
+// These structs are packed and only describe the byte layout; they are never
+// used in place. All multi-byte fields are little-endian on the wire and are
+// read/written field by field with the functions below, so the in-memory
+// types in DataStructures.h stay naturally aligned.
+//
+// Binary datagram: MessageHeader followed by data_size payload bytes.
+//   TARGET_TRACK_DATA: TargetTrackListHeader, then num_tracks TargetTrackRecord
+//   RAW_ADC_DATA:      ADCFrameRecord, then num_samples (I, Q) float32 pairs
+
+// UDP Message types
+enum class MessageType : uint8_t {
+    TARGET_TRACK_DATA = 1,
+    RAW_ADC_DATA = 2
+};
+
+// DSP command types
+typedef enum {
+    DSP_CMD_SET = 1,      // Set DSP parameters
+    DSP_CMD_GET = 2,      // Get DSP parameters
+    DSP_CMD_RESPONSE = 3  // Response with DSP parameters
+} dsp_command_type_t;
+
+#pragma pack(push, 1)
+
+// UDP Message header
+struct MessageHeader {
+    MessageType type;
+    uint32_t data_size;
+    uint64_t timestamp;
+};
+
+struct TargetTrackListHeader {
+    uint32_t num_tracks;
+};
+
+struct TargetTrackRecord {
+    uint32_t target_id;
+    float level;
+    float radius;          // cm, as in the text protocol
+    float azimuth;
+    float elevation;
+    float radial_speed;
+    float azimuth_speed;
+    float elevation_speed;
+};
+
+struct ADCFrameRecord {
+    uint32_t msg_id;
+    uint32_t num_samples;  // Complex samples that follow
+};
+
+// DSP settings payload for UDP communication
+typedef struct {
+    uint8_t range_mvg_avg_length;  // Moving average length
+    uint16_t min_range_cm;         // Minimum range (cm)
+    uint16_t max_range_cm;         // Maximum range (cm)
+    uint16_t min_speed_kmh;        // Minimum speed (km/h)
+    uint16_t max_speed_kmh;        // Maximum speed (km/h)
+    uint16_t min_angle_degree;     // Minimum angle (degrees)
+    uint16_t max_angle_degree;     // Maximum angle (degrees)
+    uint16_t range_threshold;      // Range FFT threshold
+    uint16_t speed_threshold;      // Doppler FFT threshold
+    uint8_t enable_tracking;       // Enable tracking
+    uint8_t num_of_tracks;         // Number of active tracks
+    uint8_t median_filter_length;  // Depth of median filter
+    uint8_t enable_mti_filter;     // Enable MTI filter
+    uint16_t mti_filter_length;    // MTI filter length
+} DSP_Settings_t;
+
+// DSP message structure for UDP communication
+typedef struct {
+    uint32_t msg_type;      // DSP_CMD_SET, DSP_CMD_GET, DSP_CMD_RESPONSE
+    DSP_Settings_t settings;
+} dsp_message_t;
+
+#pragma pack(pop)
+
+// The wire sizes are part of the protocol; catch accidental layout changes
+static_assert(sizeof(MessageHeader) == 13, "MessageHeader wire size changed");
+static_assert(sizeof(TargetTrackListHeader) == 4, "TargetTrackListHeader wire size changed");
+static_assert(sizeof(TargetTrackRecord) == 32, "TargetTrackRecord wire size changed");
+static_assert(sizeof(ADCFrameRecord) == 8, "ADCFrameRecord wire size changed");
+static_assert(sizeof(DSP_Settings_t) == 23, "DSP_Settings_t wire size changed");
+static_assert(sizeof(dsp_message_t) == 27, "dsp_message_t wire size changed");
+
+namespace WireFormat {
+
+// Header
+void serializeHeader(const MessageHeader& header, uint8_t* out);  // Writes sizeof(MessageHeader) bytes
+bool deserializeHeader(const uint8_t* data, size_t size, MessageHeader& header);
+
+// Complete datagrams (header + payload); the deserializers take the payload
+// only and return false on truncated or inconsistent input
+void serializeTracks(const TargetTrackData& trackData, uint64_t timestamp, std::vector<uint8_t>& out);
+bool deserializeTracks(const uint8_t* payload, size_t size, TargetTrackData& trackData);
+
+void serializeADCFrame(const RawADCFrameTest& frame, uint64_t timestamp, std::vector<uint8_t>& out);
+bool deserializeADCFrame(const uint8_t* payload, size_t size, RawADCFrameTest& frame);
+
+// DSP command messages carry no MessageHeader
+void serializeDspMessage(const dsp_message_t& message, uint8_t* out);  // Writes sizeof(dsp_message_t) bytes
+bool deserializeDspMessage(const uint8_t* data, size_t size, dsp_message_t& message);
+
+} // namespace WireFormat
@@ -0,0 +1,358 @@
+#include "ZoneEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+
+uint64_t membershipKey(uint32_t targetId, uint32_t zoneId)
+{
+    return (uint64_t(targetId) << 32) | zoneId;
+}
+
+// Liang-Barsky: does segment (x0,y0)-(x1,y1) touch the box?
+bool segmentTouchesBox(float x0, float y0, float x1, float y1,
+                       float minX, float minY, float maxX, float maxY)
+{
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {x0 - minX, maxX - x0, y0 - minY, maxY - y0};
+
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0f) {
+            if (q[i] < 0.0f) return false;
+            continue;
+        }
+        const float t = q[i] / p[i];
+        if (p[i] < 0.0f) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+ZoneEngine::ZoneEngine()
+    : m_nextZoneId(1)
+    , m_rangeCells(256)
+    , m_azimuthCells(360)
+    , m_gridRange(0.0f)
+    , m_rangeCellSize(1.0f)
+    , m_gridDirty(false)
+    , m_frame(0)
+    , m_enterFrames(2)
+    , m_exitFrames(3)
+    , m_dwellTime(10.0)
+{
+}
+
+uint32_t ZoneEngine::addZone(const std::string& name, const std::vector<ZoneVertex>& vertices)
+{
+    if (vertices.size() < 3) return 0;
+
+    Zone zone;
+    zone.id = m_nextZoneId++;
+    zone.name = name;
+    zone.vertices = vertices;
+    zone.minX = zone.maxX = vertices[0].x;
+    zone.minY = zone.maxY = vertices[0].y;
+    for (const ZoneVertex& v : vertices) {
+        zone.minX = std::min(zone.minX, v.x);
+        zone.maxX = std::max(zone.maxX, v.x);
+        zone.minY = std::min(zone.minY, v.y);
+        zone.maxY = std::max(zone.maxY, v.y);
+    }
+
+    m_zones.push_back(zone);
+    m_occupancy.push_back(0);
+    m_gridDirty = true;
+    return zone.id;
+}
+
+void ZoneEngine::removeZone(uint32_t zoneId)
+{
+    auto it = std::find_if(m_zones.begin(), m_zones.end(),
+                           [zoneId](const Zone& zone) { return zone.id == zoneId; });
+    if (it == m_zones.end()) return;
+
+    const uint32_t index = uint32_t(it - m_zones.begin());
+    m_zones.erase(it);
+    m_occupancy.erase(m_occupancy.begin() + index);
+
+    // Drop its memberships and renumber the ones of later zones
+    m_memberships.erase(std::remove_if(m_memberships.begin(), m_memberships.end(),
+                                       [index](const Membership& m) { return m.zoneIndex == index; }),
+                        m_memberships.end());
+    for (Membership& m : m_memberships) {
+        if (m.zoneIndex > index) --m.zoneIndex;
+    }
+    m_gridDirty = true;
+}
+
+void ZoneEngine::clearZones()
+{
+    m_zones.clear();
+    m_occupancy.clear();
+    m_memberships.clear();
+    m_gridDirty = true;
+}
+
+void ZoneEngine::setGridResolution(size_t rangeCells, size_t azimuthCells)
+{
+    m_rangeCells = std::max<size_t>(rangeCells, 1);
+    m_azimuthCells = std::max<size_t>(azimuthCells, 1);
+    m_gridDirty = true;
+}
+
+void ZoneEngine::setHysteresis(uint16_t enterFrames, uint16_t exitFrames)
+{
+    m_enterFrames = std::max<uint16_t>(enterFrames, 1);
+    m_exitFrames = std::max<uint16_t>(exitFrames, 1);
+}
+
+void ZoneEngine::rebuildGrid()
+{
+    m_gridDirty = false;
+    m_cellStart.assign(m_rangeCells * m_azimuthCells + 1, 0);
+    m_cellEntries.clear();
+
+    // The grid only needs to reach the farthest vertex of any zone
+    float farthest = 0.0f;
+    for (const Zone& zone : m_zones) {
+        for (const ZoneVertex& v : zone.vertices) {
+            farthest = std::max(farthest, std::sqrt(v.x * v.x + v.y * v.y));
+        }
+    }
+    m_gridRange = farthest * 1.001f + 1.0f;
+    m_rangeCellSize = m_gridRange / float(m_rangeCells);
+
+    m_scratchEntries.clear();
+    for (uint32_t z = 0; z < m_zones.size(); ++z) {
+        rasterizeZone(z);
+    }
+
+    // Group by cell (stable on zone order) into the CSR arrays
+    std::sort(m_scratchEntries.begin(), m_scratchEntries.end());
+    m_cellEntries.resize(m_scratchEntries.size());
+    for (size_t i = 0; i < m_scratchEntries.size(); ++i) {
+        ++m_cellStart[(m_scratchEntries[i] >> 32) + 1];
+        m_cellEntries[i] = uint32_t(m_scratchEntries[i]);
+    }
+    for (size_t c = 0; c + 1 < m_cellStart.size(); ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+}
+
+void ZoneEngine::rasterizeZone(uint32_t zoneIndex)
+{
+    const Zone& zone = m_zones[zoneIndex];
+    const float azimuthCellSize = 360.0f / float(m_azimuthCells);
+
+    for (size_t a = 0; a < m_azimuthCells; ++a) {
+        const float az0 = -180.0f + float(a) * azimuthCellSize;
+        const float az1 = az0 + azimuthCellSize;
+        const float s0 = std::sin(az0 * DEG_TO_RAD);
+        const float c0 = std::cos(az0 * DEG_TO_RAD);
+        const float s1 = std::sin(az1 * DEG_TO_RAD);
+        const float c1 = std::cos(az1 * DEG_TO_RAD);
+        const float centerAzimuth = (az0 + az1) * 0.5f * DEG_TO_RAD;
+
+        for (size_t r = 0; r < m_rangeCells; ++r) {
+            const float r0 = float(r) * m_rangeCellSize;
+            const float r1 = r0 + m_rangeCellSize;
+
+            // Bounding box of the annular sector: its corners plus the
+            // extreme points of the outer arc where it crosses an axis
+            float minX = std::min({r0 * s0, r0 * s1, r1 * s0, r1 * s1});
+            float maxX = std::max({r0 * s0, r0 * s1, r1 * s0, r1 * s1});
+            float minY = std::min({r0 * c0, r0 * c1, r1 * c0, r1 * c1});
+            float maxY = std::max({r0 * c0, r0 * c1, r1 * c0, r1 * c1});
+            if (az0 <= 90.0f && az1 >= 90.0f) maxX = r1;
+            if (az0 <= -90.0f && az1 >= -90.0f) minX = -r1;
+            if (az0 <= 0.0f && az1 >= 0.0f) maxY = r1;
+            if (az0 <= -180.0f || az1 >= 180.0f) minY = -r1;
+
+            if (maxX < zone.minX || minX > zone.maxX || maxY < zone.minY || minY > zone.maxY) {
+                continue;
+            }
+
+            // No edge through the box: the whole cell is on one side
+            uint32_t entry;
+            if (cellCrossesZone(zone, minX, minY, maxX, maxY)) {
+                entry = (zoneIndex << 1) | 1u;
+            } else {
+                const float centerRange = (r0 + r1) * 0.5f;
+                if (!containsPoint(zone, centerRange * std::sin(centerAzimuth),
+                                   centerRange * std::cos(centerAzimuth))) {
+                    continue;
+                }
+                entry = zoneIndex << 1;
+            }
+
+            const uint64_t cell = a * m_rangeCells + r;
+            m_scratchEntries.push_back((cell << 32) | entry);
+        }
+    }
+}
+
+bool ZoneEngine::cellCrossesZone(const Zone& zone, float minX, float minY, float maxX, float maxY) const
+{
+    const size_t count = zone.vertices.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const ZoneVertex& a = zone.vertices[j];
+        const ZoneVertex& b = zone.vertices[i];
+        if (segmentTouchesBox(a.x, a.y, b.x, b.y, minX, minY, maxX, maxY)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ZoneEngine::containsPoint(const Zone& zone, float x, float y)
+{
+    if (x < zone.minX || x > zone.maxX || y < zone.minY || y > zone.maxY) return false;
+
+    // Crossing number
+    bool inside = false;
+    const size_t count = zone.vertices.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const ZoneVertex& a = zone.vertices[i];
+        const ZoneVertex& b = zone.vertices[j];
+        if ((a.y > y) != (b.y > y) && x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool ZoneEngine::cellOf(float range, float azimuth, size_t& cell) const
+{
+    if (!(range >= 0.0f && range < m_gridRange)) return false;
+
+    float wrapped = std::fmod(azimuth + 180.0f, 360.0f);
+    if (wrapped < 0.0f) wrapped += 360.0f;
+
+    const size_t r = std::min(size_t(range / m_rangeCellSize), m_rangeCells - 1);
+    const size_t a = std::min(size_t(wrapped * float(m_azimuthCells) / 360.0f), m_azimuthCells - 1);
+    cell = a * m_rangeCells + r;
+    return true;
+}
+
+void ZoneEngine::evaluate(const TargetTrackData& tracks, double timeSeconds, std::vector<ZoneEvent>& events)
+{
+    if (m_gridDirty) rebuildGrid();
+    ++m_frame;
+
+    // Pass 1: positions and grid cells for the whole frame
+    const size_t count = tracks.targets.size();
+    m_trackX.resize(count);
+    m_trackY.resize(count);
+    m_trackCell.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const TargetTrack& target = tracks.targets[i];
+        const float azimuth = target.azimuth * DEG_TO_RAD;
+        m_trackX[i] = target.radius * std::sin(azimuth);
+        m_trackY[i] = target.radius * std::cos(azimuth);
+
+        size_t cell;
+        m_trackCell[i] = cellOf(target.radius, target.azimuth, cell) ? int32_t(cell) : -1;
+    }
+
+    // Pass 2: zones listed in each track's cell; exact test on edge cells only
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t cell = m_trackCell[i];
+        if (cell < 0) continue;
+
+        const uint32_t targetId = tracks.targets[i].target_id;
+        for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+            const uint32_t entry = m_cellEntries[k];
+            const uint32_t zoneIndex = entry >> 1;
+            const Zone& zone = m_zones[zoneIndex];
+            if ((entry & 1u) && !containsPoint(zone, m_trackX[i], m_trackY[i])) {
+                continue;
+            }
+
+            const uint64_t key = membershipKey(targetId, zone.id);
+            auto it = std::lower_bound(m_memberships.begin(), m_memberships.end(), key,
+                                       [](const Membership& m, uint64_t k) { return m.key < k; });
+            if (it == m_memberships.end() || it->key != key) {
+                it = m_memberships.insert(it, Membership{key, zoneIndex, 0, 0, 0, false, false, 0.0});
+            }
+            Membership& membership = *it;
+            if (membership.lastFrame == m_frame) continue;  // Duplicate target ID
+            membership.lastFrame = m_frame;
+            updateMembership(membership, true, zone.id, targetId, timeSeconds, events);
+        }
+    }
+
+    // Memberships not refreshed this frame count as outside (or gone)
+    std::fill(m_occupancy.begin(), m_occupancy.end(), 0);
+    size_t kept = 0;
+    for (size_t m = 0; m < m_memberships.size(); ++m) {
+        Membership& membership = m_memberships[m];
+        if (membership.lastFrame != m_frame) {
+            const uint32_t targetId = uint32_t(membership.key >> 32);
+            const uint32_t zoneId = uint32_t(membership.key);
+            updateMembership(membership, false, zoneId, targetId, timeSeconds, events);
+            if (!membership.inside && membership.insideRun == 0) continue;
+        }
+        if (membership.inside) ++m_occupancy[membership.zoneIndex];
+        m_memberships[kept++] = membership;
+    }
+    m_memberships.resize(kept);
+}
+
+void ZoneEngine::updateMembership(Membership& membership, bool inside, uint32_t zoneId, uint32_t targetId,
+                                  double time, std::vector<ZoneEvent>& events)
+{
+    if (inside) {
+        membership.outsideRun = 0;
+        if (membership.insideRun < 0xFFFF) ++membership.insideRun;
+        if (!membership.inside && membership.insideRun >= m_enterFrames) {
+            membership.inside = true;
+            membership.dwellReported = false;
+            membership.enterTime = time;
+            events.push_back(ZoneEvent{ZoneEvent::Enter, zoneId, targetId, time});
+        }
+    } else {
+        membership.insideRun = 0;
+        if (membership.outsideRun < 0xFFFF) ++membership.outsideRun;
+        if (membership.inside && membership.outsideRun >= m_exitFrames) {
+            membership.inside = false;
+            events.push_back(ZoneEvent{ZoneEvent::Exit, zoneId, targetId, time});
+        }
+    }
+
+    if (membership.inside && !membership.dwellReported && m_dwellTime > 0.0
+        && time - membership.enterTime >= m_dwellTime) {
+        membership.dwellReported = true;
+        events.push_back(ZoneEvent{ZoneEvent::Dwell, zoneId, targetId, time});
+    }
+}
+
+void ZoneEngine::zonesAt(float range, float azimuth, std::vector<uint32_t>& zoneIds)
+{
+    zoneIds.clear();
+    if (m_gridDirty) rebuildGrid();
+
+    size_t cell;
+    if (!cellOf(range, azimuth, cell)) return;
+
+    const float x = range * std::sin(azimuth * DEG_TO_RAD);
+    const float y = range * std::cos(azimuth * DEG_TO_RAD);
+    for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+        const uint32_t entry = m_cellEntries[k];
+        const Zone& zone = m_zones[entry >> 1];
+        if (!(entry & 1u) || containsPoint(zone, x, y)) {
+            zoneIds.push_back(zone.id);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DataStructures.h"
+
+// Polygon vertex in metres: x to the right, y along 0° azimuth
+struct ZoneVertex {
+    float x;
+    float y;
+};
+
+struct ZoneEvent {
+    enum Type {
+        Enter,
+        Exit,
+        Dwell
+    };
+
+    Type type;
+    uint32_t zoneId;
+    uint32_t targetId;
+    double time;          // Seconds, as passed to evaluate()
+};
+
+// Geofence zones evaluated against every track once per frame.
+// All zones are pre-rasterized into one range-azimuth grid. Each cell lists
+// the zones that fully contain it or cross it, so a track costs one cell
+// lookup plus an exact point-in-polygon test only for zones whose edge runs
+// through its cell. Zone membership goes through frame-count hysteresis
+// before Enter/Exit are reported; Dwell fires once per visit after the
+// dwell time.
+class ZoneEngine
+{
+public:
+    struct Zone {
+        uint32_t id;
+        std::string name;
+        std::vector<ZoneVertex> vertices;
+        float minX, minY, maxX, maxY;   // Bounding box
+    };
+
+    ZoneEngine();
+
+    uint32_t addZone(const std::string& name, const std::vector<ZoneVertex>& vertices);
+    void removeZone(uint32_t zoneId);
+    void clearZones();
+
+    const std::vector<Zone>& zones() const { return m_zones; }
+    bool isZoneOccupied(size_t index) const { return m_occupancy[index] != 0; }
+    uint32_t zoneOccupancy(size_t index) const { return m_occupancy[index]; }
+
+    // Grid resolution; the range extent follows the farthest zone vertex
+    void setGridResolution(size_t rangeCells, size_t azimuthCells);
+
+    // Frames in a row a track must be inside/outside before Enter/Exit fire,
+    // and the time inside before Dwell fires
+    void setHysteresis(uint16_t enterFrames, uint16_t exitFrames);
+    void setDwellTime(double seconds) { m_dwellTime = seconds; }
+
+    // Test every track of one frame; events are appended to the vector
+    void evaluate(const TargetTrackData& tracks, double timeSeconds, std::vector<ZoneEvent>& events);
+
+    // Zones containing a point (exact, no hysteresis)
+    void zonesAt(float range, float azimuth, std::vector<uint32_t>& zoneIds);
+
+private:
+    struct Membership {
+        uint64_t key;          // (targetId << 32) | zoneId
+        uint32_t zoneIndex;
+        uint32_t lastFrame;    // Frame the track was last seen inside the zone
+        uint16_t insideRun;
+        uint16_t outsideRun;
+        bool inside;           // After hysteresis
+        bool dwellReported;
+        double enterTime;
+    };
+
+    void rebuildGrid();
+    void rasterizeZone(uint32_t zoneIndex);
+    bool cellCrossesZone(const Zone& zone, float minX, float minY, float maxX, float maxY) const;
+    static bool containsPoint(const Zone& zone, float x, float y);
+    bool cellOf(float range, float azimuth, size_t& cell) const;
+    void updateMembership(Membership& membership, bool inside, uint32_t zoneId, uint32_t targetId,
+                          double time, std::vector<ZoneEvent>& events);
+
+    std::vector<Zone> m_zones;
+    std::vector<uint32_t> m_occupancy;  // Tracks inside, per zone
+    uint32_t m_nextZoneId;
+
+    // Range-azimuth lookup grid, CSR: entries are (zoneIndex << 1) | edgeFlag
+    size_t m_rangeCells;
+    size_t m_azimuthCells;
+    float m_gridRange;
+    float m_rangeCellSize;
+    bool m_gridDirty;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellEntries;
+    std::vector<uint64_t> m_scratchEntries;  // (cell << 32) | entry, during rebuild
+
+    // Hysteresis state per (target, zone), sorted by key. A flat vector keeps
+    // its capacity, so steady-state frames do not allocate.
+    std::vector<Membership> m_memberships;
+    uint32_t m_frame;
+    uint16_t m_enterFrames;
+    uint16_t m_exitFrames;
+    double m_dwellTime;
+
+    // Per-frame scratch
+    std::vector<float> m_trackX;
+    std::vector<float> m_trackY;
+    std::vector<int32_t> m_trackCell;        // -1 outside the grid
+};
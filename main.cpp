@@ -1,43 +1,43 @@
-#include <QApplication>
-#include <QStyleFactory>
-#include <QDir>
-#include "MainWindow.h"
-
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-    
-    // Set application properties
-    app.setApplicationName("Radar Data Visualization");
-    app.setApplicationVersion("1.0.0");
-    app.setOrganizationName("Radar Systems");
-    
-    // Set a modern dark style if available
-    QStringList availableStyles = QStyleFactory::keys();
-    if (availableStyles.contains("Fusion")) {
-        app.setStyle("Fusion");
-        
-        // Dark theme palette
-        QPalette darkPalette;
-        darkPalette.setColor(QPalette::Window, QColor(53, 53, 53));
-        darkPalette.setColor(QPalette::WindowText, Qt::white);
-        darkPalette.setColor(QPalette::Base, QColor(25, 25, 25));
-        darkPalette.setColor(QPalette::AlternateBase, QColor(53, 53, 53));
-        darkPalette.setColor(QPalette::ToolTipBase, Qt::white);
-        darkPalette.setColor(QPalette::ToolTipText, Qt::white);
-        darkPalette.setColor(QPalette::Text, Qt::white);
-        darkPalette.setColor(QPalette::Button, QColor(53, 53, 53));
-        darkPalette.setColor(QPalette::ButtonText, Qt::white);
-        darkPalette.setColor(QPalette::BrightText, Qt::red);
-        darkPalette.setColor(QPalette::Link, QColor(42, 130, 218));
-        darkPalette.setColor(QPalette::Highlight, QColor(42, 130, 218));
-        darkPalette.setColor(QPalette::HighlightedText, Qt::black);
-        app.setPalette(darkPalette);
-    }
-    
-    // Create and show main window
-    MainWindow window;
-    window.show();
-    
-    return app.exec();
+#include <QApplication>
+#include <QStyleFactory>
+#include <QDir>
+#include "MainWindow.h"
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    
+    // Set application properties
+    app.setApplicationName("Radar Data Visualization");
+    app.setApplicationVersion("1.0.0");
+    app.setOrganizationName("Radar Systems");
+    
+    // Set a modern dark style if available
+    QStringList availableStyles = QStyleFactory::keys();
+    if (availableStyles.contains("Fusion")) {
+        app.setStyle("Fusion");
+        
+        // Dark theme palette
+        QPalette darkPalette;
+        darkPalette.setColor(QPalette::Window, QColor(53, 53, 53));
+        darkPalette.setColor(QPalette::WindowText, Qt::white);
+        darkPalette.setColor(QPalette::Base, QColor(25, 25, 25));
+        darkPalette.setColor(QPalette::AlternateBase, QColor(53, 53, 53));
+        darkPalette.setColor(QPalette::ToolTipBase, Qt::white);
+        darkPalette.setColor(QPalette::ToolTipText, Qt::white);
+        darkPalette.setColor(QPalette::Text, Qt::white);
+        darkPalette.setColor(QPalette::Button, QColor(53, 53, 53));
+        darkPalette.setColor(QPalette::ButtonText, Qt::white);
+        darkPalette.setColor(QPalette::BrightText, Qt::red);
+        darkPalette.setColor(QPalette::Link, QColor(42, 130, 218));
+        darkPalette.setColor(QPalette::Highlight, QColor(42, 130, 218));
+        darkPalette.setColor(QPalette::HighlightedText, Qt::black);
+        app.setPalette(darkPalette);
+    }
+    
+    // Create and show main window
+    MainWindow window;
+    window.show();
+    
+    return app.exec();
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+// alloccheck - check that steady-state ingest does not touch the heap
+//
+//   alloccheck [--frames N] [--warmup N] [--targets N] [--samples N] [--chirps N]
+//
+// Replaces the global operator new with a counting one, then feeds binary and
+// text track and ADC datagrams through RadarPipeline (decoding, receive
+// counters, clustering and tracking of the sensor reports, then again of
+// FrameProcessor's detections, and zones) the way the receive loop does,
+// reading each ADC frame's derived magnitudes and phases like the spectrum
+// display.
+// After the warm-up frames every allocation is a failure: the tool prints the
+// count and exits with 1. Registered with CTest.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "DataStructures.h"
+#include "DatagramDecoder.h"
+#include "FrameProcessor.h"
+#include "RadarPipeline.h"
+#include "SceneSimulator.h"
+#include "WireFormat.h"
+
+namespace {
+
+std::atomic<bool> g_counting(false);
+std::atomic<uint64_t> g_allocations(0);
+
+void* allocate(std::size_t size)
+{
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size ? size : 1);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    const std::size_t align = std::max(std::size_t(alignment), sizeof(void*));
+    return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = allocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = allocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+const size_t FRAME_VARIANTS = 16;
+const double FRAME_INTERVAL = 0.05;    // s
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: alloccheck [--frames N] [--warmup N] [--targets N] [--samples N] [--chirps N]\n"
+                 "  --frames       frames checked after the warm-up (default 2000)\n"
+                 "  --warmup       frames before counting starts (default 200)\n"
+                 "  --targets      targets per frame (default 16)\n"
+                 "  --samples, --chirps   ADC frame shape (default 256 x 16)\n");
+}
+
+struct Config {
+    size_t frames = 2000;
+    size_t warmup = 200;
+    size_t targets = 16;
+    uint32_t samples = 256;
+    uint32_t chirps = 16;
+};
+
+// Targets circling at different rates, as udploadgen sends them
+void sceneAt(const Config& config, double time, std::vector<SceneSimulator::Target>& scene, TargetTrackData& tracks)
+{
+    scene.clear();
+    tracks.resize(uint32_t(config.targets));
+    for (size_t i = 0; i < config.targets; ++i) {
+        const float radius = 10.0f + 90.0f * float(i + 1) / float(config.targets + 1);
+        const float rate = 0.2f + 0.05f * float(i % 5);     // rad/s
+        const float angle = float(i) * 0.7f + rate * float(time);
+        const float x = radius * std::sin(angle);
+        const float y = 20.0f + radius * std::cos(angle);
+        const float range = std::sqrt(x * x + y * y);
+        const float speed = -radius * rate * (x * std::cos(angle) - y * std::sin(angle)) / range;
+
+        TargetTrack& track = tracks.targets[i];
+        track = TargetTrack();
+        track.target_id = uint32_t(i + 1);
+        track.level = 40.0f + float(i % 4) * 10.0f;
+        track.radius = range;
+        track.azimuth = std::atan2(x, y) * 180.0f / 3.14159265f;
+        track.radial_speed = speed;
+        scene.push_back(SceneSimulator::Target{range, track.azimuth, speed, 1.0f + float(i % 4)});
+    }
+}
+
+// The text formats, as the sensor firmware sends them (range in cm)
+std::string textTracks(const TargetTrackData& tracks)
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), "NumTargets: %u\n", unsigned(tracks.targets.size()));
+    std::string out = line;
+    for (const TargetTrack& t : tracks.targets) {
+        std::snprintf(line, sizeof(line),
+                      "TgtId: %u Level: %.1f Range: %.1f Azimuth: %.2f Elevation: %.2f RadialSpeed: %.2f "
+                      "AzimuthSpeed: %.2f ElevationSpeed: %.2f\n",
+                      unsigned(t.target_id), t.level, t.radius * 100.0f, t.azimuth, t.elevation,
+                      t.radial_speed, t.azimuth_speed, t.elevation_speed);
+        out += line;
+    }
+    return out;
+}
+
+// Each block's I values, then its Q values (DatagramDecoder::TEXT_ADC_BLOCK)
+std::string textADCFrame(const RawADCFrameTest& frame, uint32_t msgId)
+{
+    char value[64];
+    std::snprintf(value, sizeof(value), "MsgId: %u NumSamples: %u\n", unsigned(msgId),
+                  unsigned(frame.num_samples_per_chirp * 2));
+    std::string out = value;
+    const size_t count = frame.complex_data.size();
+    for (size_t block = 0; block < count; block += DatagramDecoder::TEXT_ADC_BLOCK) {
+        const size_t end = std::min(block + DatagramDecoder::TEXT_ADC_BLOCK, count);
+        for (size_t i = block; i < end; ++i) {
+            std::snprintf(value, sizeof(value), "ADC: %.5f\n", frame.complex_data[i].I);
+            out += value;
+        }
+        for (size_t i = block; i < end; ++i) {
+            std::snprintf(value, sizeof(value), "ADC: %.5f\n", frame.complex_data[i].Q);
+            out += value;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = value != nullptr;
+        if (!ok) {
+        } else if (arg == "--frames") {
+            config.frames = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--warmup") {
+            config.warmup = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--targets") {
+            config.targets = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--samples") {
+            config.samples = uint32_t(std::strtoul(value, nullptr, 10));
+            ok = config.samples > 0;
+        } else if (arg == "--chirps") {
+            config.chirps = uint32_t(std::strtoul(value, nullptr, 10));
+            ok = config.chirps > 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "alloccheck: bad argument %s\n", arg.c_str());
+            usage();
+            return 2;
+        }
+        ++i;
+    }
+
+    // Datagrams are built up front: binary and text, tracks and ADC frames
+    SceneSimulator::Config sceneConfig;
+    sceneConfig.samplesPerChirp = config.samples;
+    sceneConfig.chirps = config.chirps;
+    SceneSimulator simulator(sceneConfig);
+
+    std::vector<std::vector<uint8_t>> datagrams;
+    std::vector<SceneSimulator::Target> scene;
+    TargetTrackData tracks;
+    RawADCFrameTest frame;
+    for (size_t v = 0; v < FRAME_VARIANTS; ++v) {
+        sceneAt(config, double(v) * FRAME_INTERVAL, scene, tracks);
+        simulator.synthesize(scene, frame);
+        frame.msgId = uint32_t(v + 1);
+
+        std::vector<uint8_t> bytes;
+        WireFormat::serializeTracks(tracks, 0, bytes);
+        datagrams.push_back(bytes);
+        WireFormat::serializeADCFrame(frame, 0, bytes);
+        datagrams.push_back(bytes);
+        const std::string text = v % 2 ? textTracks(tracks) : textADCFrame(frame, frame.msgId);
+        datagrams.emplace_back(text.begin(), text.end());
+    }
+
+    // Once with the sensor's track reports and once with FrameProcessor's
+    // detections feeding the clusterer and tracker
+    int result = 0;
+    for (const bool frameProcessing : {false, true}) {
+        RadarPipeline pipeline;
+        FrameProcessor::Settings processing;
+        processing.samplesPerChirp = config.samples;
+        pipeline.frameProcessor().setSettings(processing);
+        pipeline.setFrameProcessingEnabled(frameProcessing);
+        pipeline.setClusteringEnabled(true);
+        DSP_Settings_t settings{};
+        settings.enable_tracking = 1;
+        pipeline.configure(settings);
+        pipeline.zoneEngine().setDwellTime(0.5);
+        pipeline.zoneEngine().addZone("check", {{-20.0f, 10.0f}, {20.0f, 10.0f}, {20.0f, 60.0f}, {-20.0f, 60.0f}});
+
+        // Ingest as the receive loop does: decode, host processing, zones, display reads
+        double time = 0.0;
+        float checksum = 0.0f;
+        uint64_t zoneEvents = 0;
+        auto runFrame = [&](size_t index) {
+            time += FRAME_INTERVAL;
+            for (size_t d = 0; d < 3; ++d) {
+                const std::vector<uint8_t>& datagram = datagrams[(index % FRAME_VARIANTS) * 3 + d];
+                pipeline.processDatagram(reinterpret_cast<const char*>(datagram.data()), datagram.size(),
+                                         uint64_t(time * 1e6));
+                pipeline.runHostProcessing(time);
+            }
+            zoneEvents += pipeline.evaluateZones(time).size();
+            const ADCFramePtr& adc = pipeline.adcFrame();
+            if (!adc->complex_data.empty()) {
+                checksum += adc->magnitudes()[0] + adc->phases()[0];
+            }
+            checksum += float(pipeline.outputTracks()->targets.size());
+        };
+
+        g_allocations.store(0);
+        for (size_t i = 0; i < config.warmup; ++i) {
+            runFrame(i);
+        }
+        g_counting.store(true);
+        for (size_t i = 0; i < config.frames; ++i) {
+            runFrame(config.warmup + i);
+        }
+        g_counting.store(false);
+
+        const uint64_t allocations = g_allocations.load();
+        const RadarPipeline::ReceiveStats stats = pipeline.receiveStats();
+        std::printf("%s: %zu frames after %zu warm-up frames: %llu datagrams (%llu track, %llu ADC, "
+                    "%llu malformed), %zu output tracks, %llu zone events, %llu allocations (checksum %.1f)\n",
+                    frameProcessing ? "frame detections" : "sensor reports", config.frames, config.warmup,
+                    (unsigned long long)stats.datagrams, (unsigned long long)stats.trackFrames,
+                    (unsigned long long)stats.adcFrames, (unsigned long long)pipeline.malformedCount(),
+                    pipeline.outputTracks()->targets.size(), (unsigned long long)zoneEvents,
+                    (unsigned long long)allocations, checksum);
+        if (stats.trackFrames == 0 || stats.adcFrames == 0 || pipeline.malformedCount() > 0) {
+            std::fprintf(stderr, "alloccheck: the datagrams did not decode\n");
+            result = 1;
+        } else if (allocations > 0) {
+            std::fprintf(stderr, "alloccheck: steady-state ingest allocated %llu times\n",
+                         (unsigned long long)allocations);
+            result = 1;
+        }
+    }
+    return result;
+}
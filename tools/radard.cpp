@@ -0,0 +1,554 @@
+// radard - headless receive pipeline: one or more sensors, no display
+//
+//   radard [--config FILE] [--port N] [--bind ADDR] [--record PATH] [--raw-only | --decoded-only]
+//          [--compress] [--process] [--antennas N] [--samples N] [--cfar-db DB]
+//          [--min-range M] [--max-range M] [--cluster] [--track] [--export DIR]
+//          [--forward HOST:PORT] [--zone SPEC] [--dwell S] [--stats S]
+//
+// Every sensor gets its own UDP socket, thread and RadarPipeline: datagrams
+// are decoded, optionally clustered and tracked, checked against zones and
+// recorded. With --process the ADC frames run through FrameProcessor
+// (range/Doppler FFT, CFAR) and its detections, rather than the sensor's
+// track reports, feed the clusterer and tracker. --export writes the output
+// tracks, plus the detections and range profiles when processing, as column
+// files (ColumnExporter.h). Output tracks can be forwarded as binary
+// TARGET_TRACK_DATA messages, e.g. to a RadarVisualization instance elsewhere.
+//
+// Command-line options describe one sensor. A config file describes any
+// number, one [sensor NAME] section each with the same keys as the long
+// options (record_raw/record_decoded instead of --raw-only/--decoded-only):
+//
+//   stats = 10                       # before any section: global
+//
+//   [sensor front]
+//   port = 5000
+//   record = /data/front_%Y%m%d_%H%M%S.radrec
+//   compress = 1
+//   process = 1
+//   antennas = 4
+//   track = 1
+//   export = /data/front_%Y%m%d_%H%M%S
+//   forward = 10.0.0.20:5000
+//   zone = Gate: -10,20 10,20 10,40 -10,40
+//
+// Record and export paths go through strftime. SIGINT/SIGTERM stop the sensors and
+// close the recordings cleanly.
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ColumnExporter.h"
+#include "FrameProcessor.h"
+#include "RadarPipeline.h"
+#include "RecordingWriter.h"
+#include "WireFormat.h"
+
+namespace {
+
+struct SensorConfig {
+    std::string name = "sensor";
+    std::string bind = "0.0.0.0";
+    uint16_t port = 5000;
+    std::string record;
+    bool recordRaw = true;
+    bool recordDecoded = true;
+    bool compress = false;
+    bool process = false;
+    FrameProcessor::Settings processing;
+    bool cluster = false;
+    bool track = false;
+    std::string exportDirectory;
+    std::string forward;
+    std::vector<std::string> zones;
+    double dwell = 0.0;
+    int receiveBuffer = 8 << 20;
+};
+
+struct Sensor {
+    SensorConfig config;
+    int socket = -1;
+    sockaddr_storage forwardAddress{};
+    socklen_t forwardLength = 0;
+    RecordingWriter recorder;
+    ColumnExporter exporter;
+    RadarPipeline pipeline;
+    std::thread thread;
+
+    // Receive counts come from pipeline.receiveStats()
+    std::atomic<uint64_t> zoneEvents{0};
+    std::atomic<uint64_t> forwardErrors{0};
+    std::atomic<uint64_t> exportedBytes{0};     // Copied from the exporter by the sensor thread
+    std::atomic<bool> exportFailed{false};
+};
+
+const size_t MAX_DATAGRAM_SIZE = 65536;
+const int POLL_INTERVAL_MS = 200;    // How quickly a stop request is noticed
+
+volatile std::sig_atomic_t g_stop = 0;
+std::mutex g_logMutex;
+
+void onSignal(int)
+{
+    g_stop = 1;
+}
+
+void logLine(const char* format, ...)
+{
+    char when[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+    std::lock_guard<std::mutex> lock(g_logMutex);
+    std::fprintf(stderr, "%s radard: ", when);
+    va_list args;
+    va_start(args, format);
+    std::vfprintf(stderr, format, args);
+    va_end(args);
+    std::fputc('\n', stderr);
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: radard [--config FILE] [--port N] [--bind ADDR] [--record PATH]\n"
+                 "              [--raw-only | --decoded-only] [--compress] [--process] [--antennas N]\n"
+                 "              [--samples N] [--cfar-db DB] [--min-range M] [--max-range M]\n"
+                 "              [--cluster] [--track] [--export DIR] [--forward HOST:PORT]\n"
+                 "              [--zone SPEC] [--dwell S] [--stats S]\n"
+                 "  --config        sensors from a config file ([sensor NAME] sections)\n"
+                 "  --port, --bind  UDP port and address to receive on (default 5000, any)\n"
+                 "  --record        record to PATH (strftime patterns expanded)\n"
+                 "  --raw-only      record the datagrams only; --decoded-only the decoded frames only\n"
+                 "  --compress      compress recording chunks\n"
+                 "  --process       detect targets in the ADC frames (range/Doppler FFT, CFAR) and\n"
+                 "                  cluster/track those instead of the sensor's track reports\n"
+                 "  --antennas, --samples   ADC frame layout (default 1 antenna, chirp length from the frame)\n"
+                 "  --cfar-db       CFAR threshold above the training cells (default 12)\n"
+                 "  --min-range, --max-range   detection range window in m\n"
+                 "  --cluster       cluster detections; --track runs the host tracker\n"
+                 "  --export        write column files to DIR (strftime patterns expanded): output\n"
+                 "                  tracks, and with --process the detections and range profiles\n"
+                 "  --forward       send output tracks to HOST:PORT as TARGET_TRACK_DATA\n"
+                 "  --zone          \"NAME: x,y x,y x,y ...\" polygon in m (repeatable)\n"
+                 "  --dwell         zone dwell alarm after S seconds\n"
+                 "  --stats         status line every S seconds (default 10, 0 = off)\n");
+}
+
+bool parseBool(const std::string& value)
+{
+    return value == "1" || value == "true" || value == "yes" || value == "on";
+}
+
+std::string trim(const std::string& text)
+{
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return std::string();
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// One key of a sensor (or, for "stats", of the daemon)
+bool applySetting(SensorConfig& sensor, double& statsInterval, const std::string& key, const std::string& value)
+{
+    if (key == "port") {
+        const long port = std::strtol(value.c_str(), nullptr, 10);
+        if (port <= 0 || port > 65535) return false;
+        sensor.port = uint16_t(port);
+    } else if (key == "bind") {
+        sensor.bind = value;
+    } else if (key == "record") {
+        sensor.record = value;
+    } else if (key == "record_raw") {
+        sensor.recordRaw = parseBool(value);
+    } else if (key == "record_decoded") {
+        sensor.recordDecoded = parseBool(value);
+    } else if (key == "compress") {
+        sensor.compress = parseBool(value);
+    } else if (key == "process") {
+        sensor.process = parseBool(value);
+    } else if (key == "antennas") {
+        sensor.processing.antennas = std::strtoul(value.c_str(), nullptr, 10);
+        if (sensor.processing.antennas == 0) return false;
+    } else if (key == "samples") {
+        sensor.processing.samplesPerChirp = std::strtoul(value.c_str(), nullptr, 10);
+    } else if (key == "cfar_db") {
+        sensor.processing.cfarThresholdDb = std::strtof(value.c_str(), nullptr);
+    } else if (key == "min_range") {
+        sensor.processing.minRange = std::strtof(value.c_str(), nullptr);
+    } else if (key == "max_range") {
+        sensor.processing.maxRange = std::strtof(value.c_str(), nullptr);
+    } else if (key == "cluster") {
+        sensor.cluster = parseBool(value);
+    } else if (key == "track") {
+        sensor.track = parseBool(value);
+    } else if (key == "export") {
+        sensor.exportDirectory = value;
+    } else if (key == "forward") {
+        sensor.forward = value;
+    } else if (key == "zone") {
+        sensor.zones.push_back(value);
+    } else if (key == "dwell") {
+        sensor.dwell = std::atof(value.c_str());
+    } else if (key == "receive_buffer") {
+        sensor.receiveBuffer = std::atoi(value.c_str());
+    } else if (key == "stats") {
+        statsInterval = std::atof(value.c_str());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool readConfig(const std::string& path, std::vector<SensorConfig>& sensors, double& statsInterval)
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "radard: cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    SensorConfig defaults;   // Keys before the first section apply to every sensor
+    SensorConfig* current = &defaults;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            const std::string section = trim(line.substr(1, line.find(']') - 1));
+            if (section.compare(0, 6, "sensor") != 0) {
+                std::fprintf(stderr, "radard: %s:%d: unknown section [%s]\n", path.c_str(), number, section.c_str());
+                return false;
+            }
+            sensors.push_back(defaults);
+            current = &sensors.back();
+            const std::string name = trim(section.substr(6));
+            current->name = name.empty() ? "sensor" + std::to_string(sensors.size()) : name;
+            continue;
+        }
+
+        const size_t equals = line.find('=');
+        if (equals == std::string::npos
+            || !applySetting(*current, statsInterval, trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            std::fprintf(stderr, "radard: %s:%d: bad setting \"%s\"\n", path.c_str(), number, line.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// "NAME: x,y x,y x,y ..."
+bool addZone(ZoneEngine& zones, const std::string& spec)
+{
+    const size_t colon = spec.find(':');
+    const std::string name = colon == std::string::npos ? "Zone" : trim(spec.substr(0, colon));
+    std::istringstream points(colon == std::string::npos ? spec : spec.substr(colon + 1));
+
+    std::vector<ZoneVertex> vertices;
+    std::string point;
+    while (points >> point) {
+        ZoneVertex vertex;
+        if (std::sscanf(point.c_str(), "%f,%f", &vertex.x, &vertex.y) != 2) return false;
+        vertices.push_back(vertex);
+    }
+    if (vertices.size() < 3) return false;
+    zones.addZone(name, vertices);
+    return true;
+}
+
+bool resolve(const std::string& host, uint16_t port, bool passive, sockaddr_storage& address, socklen_t& length)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* result = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &result) != 0 || !result) {
+        return false;
+    }
+    std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+    length = socklen_t(result->ai_addrlen);
+    freeaddrinfo(result);
+    return true;
+}
+
+bool openSensor(Sensor& sensor)
+{
+    const SensorConfig& config = sensor.config;
+
+    sockaddr_storage address;
+    socklen_t length;
+    if (!resolve(config.bind, config.port, true, address, length)) {
+        logLine("[%s] cannot resolve %s", config.name.c_str(), config.bind.c_str());
+        return false;
+    }
+    sensor.socket = ::socket(address.ss_family, SOCK_DGRAM, 0);
+    if (sensor.socket < 0 || ::bind(sensor.socket, reinterpret_cast<sockaddr*>(&address), length) != 0) {
+        logLine("[%s] cannot bind UDP %s:%u: %s", config.name.c_str(), config.bind.c_str(),
+                unsigned(config.port), std::strerror(errno));
+        if (sensor.socket >= 0) {
+            ::close(sensor.socket);
+            sensor.socket = -1;
+        }
+        return false;
+    }
+    // Bursts of ADC datagrams must not overflow the socket while a frame is processed
+    ::setsockopt(sensor.socket, SOL_SOCKET, SO_RCVBUF, &config.receiveBuffer, sizeof(config.receiveBuffer));
+
+    if (!config.forward.empty()) {
+        const size_t colon = config.forward.rfind(':');
+        const long port = colon == std::string::npos ? 0 : std::strtol(config.forward.c_str() + colon + 1, nullptr, 10);
+        if (port <= 0 || port > 65535
+            || !resolve(config.forward.substr(0, colon), uint16_t(port), false,
+                        sensor.forwardAddress, sensor.forwardLength)) {
+            logLine("[%s] bad forward address %s", config.name.c_str(), config.forward.c_str());
+            return false;
+        }
+    }
+
+    for (const std::string& zone : config.zones) {
+        if (!addZone(sensor.pipeline.zoneEngine(), zone)) {
+            logLine("[%s] bad zone \"%s\"", config.name.c_str(), zone.c_str());
+            return false;
+        }
+    }
+    if (config.dwell > 0.0) {
+        sensor.pipeline.zoneEngine().setDwellTime(config.dwell);
+    }
+    sensor.pipeline.frameProcessor().setSettings(config.processing);
+    sensor.pipeline.setFrameProcessingEnabled(config.process);
+    sensor.pipeline.setClusteringEnabled(config.cluster);
+    DSP_Settings_t settings{};
+    settings.enable_tracking = config.track ? 1 : 0;
+    sensor.pipeline.configure(settings);
+
+    char path[4096];
+    const std::time_t now = std::time(nullptr);
+    if (!config.record.empty()) {
+        if (std::strftime(path, sizeof(path), config.record.c_str(), std::localtime(&now)) == 0) {
+            logLine("[%s] bad record path %s", config.name.c_str(), config.record.c_str());
+            return false;
+        }
+        std::string error;
+        sensor.recorder.setCodec(config.compress ? Recording::CodecShuffleLZ : Recording::CodecNone);
+        if (!sensor.recorder.open(path, &error)) {
+            logLine("[%s] %s", config.name.c_str(), error.c_str());
+            return false;
+        }
+        sensor.pipeline.setRecorder(&sensor.recorder, config.recordRaw, config.recordDecoded);
+        logLine("[%s] recording to %s", config.name.c_str(), path);
+    }
+
+    if (!config.exportDirectory.empty()) {
+        if (std::strftime(path, sizeof(path), config.exportDirectory.c_str(), std::localtime(&now)) == 0) {
+            logLine("[%s] bad export directory %s", config.name.c_str(), config.exportDirectory.c_str());
+            return false;
+        }
+        const int tables = ColumnExporter::Tracks
+                           | (config.process ? ColumnExporter::Detections | ColumnExporter::RangeProfiles : 0);
+        std::string error;
+        if (!sensor.exporter.open(path, tables, &error)) {
+            logLine("[%s] %s", config.name.c_str(), error.c_str());
+            return false;
+        }
+        sensor.pipeline.setExporter(&sensor.exporter);
+        logLine("[%s] exporting to %s", config.name.c_str(), path);
+    }
+
+    logLine("[%s] listening on UDP %s:%u%s%s%s", config.name.c_str(), config.bind.c_str(), unsigned(config.port),
+            config.process ? ", processing ADC frames" : "", config.cluster ? ", clustering" : "",
+            config.track ? ", tracking" : "");
+    return true;
+}
+
+void runSensor(Sensor& sensor, std::chrono::steady_clock::time_point start)
+{
+    std::vector<char> buffer(MAX_DATAGRAM_SIZE);
+    std::vector<uint8_t> message;
+    RadarPipeline& pipeline = sensor.pipeline;
+    TrackSnapshotPtr forwarded;
+    // New track reports, and with frame processing new ADC frames, drive host processing
+    const int hostInputs = DatagramDecoder::DecodedTracks
+                           | (pipeline.isFrameProcessingEnabled() ? DatagramDecoder::DecodedADCFrame : 0);
+
+    while (!g_stop) {
+        pollfd descriptor{sensor.socket, POLLIN, 0};
+        if (::poll(&descriptor, 1, POLL_INTERVAL_MS) <= 0) continue;
+
+        // Drain everything queued before going back to poll(), unless asked
+        // to stop: a sender that never pauses would otherwise keep us here
+        while (!g_stop) {
+            const ssize_t size = ::recv(sensor.socket, buffer.data(), buffer.size(), MSG_DONTWAIT);
+            if (size < 0) break;
+
+            const uint64_t timestamp = RecordingWriter::nowMicroseconds();
+            const int decoded = pipeline.processDatagram(buffer.data(), size_t(size), timestamp);
+            if (!(decoded & hostInputs)) continue;
+
+            // Host processing and zones run on the daemon's clock
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            pipeline.runHostProcessing(time);
+            if (sensor.exporter.isOpen()) {
+                sensor.exportedBytes.store(sensor.exporter.bytesWritten(), std::memory_order_relaxed);
+                sensor.exportFailed.store(sensor.exporter.writeFailed(), std::memory_order_relaxed);
+            }
+
+            for (const ZoneEvent& event : pipeline.evaluateZones(time)) {
+                sensor.zoneEvents.fetch_add(1, std::memory_order_relaxed);
+                const char* zoneName = "?";
+                for (const ZoneEngine::Zone& zone : pipeline.zoneEngine().zones()) {
+                    if (zone.id == event.zoneId) zoneName = zone.name.c_str();
+                }
+                const char* what = event.type == ZoneEvent::Enter ? "ALARM: target %u entered %s"
+                                 : event.type == ZoneEvent::Exit ? "target %u left %s"
+                                 : "ALARM: target %u loitering in %s";
+                char text[256];
+                std::snprintf(text, sizeof(text), what, unsigned(event.targetId), zoneName);
+                logLine("[%s] %s", sensor.config.name.c_str(), text);
+            }
+
+            if (sensor.forwardLength && pipeline.outputTracks() != forwarded) {
+                forwarded = pipeline.outputTracks();
+                WireFormat::serializeTracks(*forwarded, timestamp, message);
+                if (::sendto(sensor.socket, message.data(), message.size(), 0,
+                             reinterpret_cast<const sockaddr*>(&sensor.forwardAddress), sensor.forwardLength) < 0) {
+                    sensor.forwardErrors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+}
+
+void printStats(std::vector<std::unique_ptr<Sensor>>& sensors, double seconds)
+{
+    for (std::unique_ptr<Sensor>& sensor : sensors) {
+        char recording[128] = "";
+        if (!sensor->config.record.empty()) {
+            const RecordingWriter::Stats stats = sensor->recorder.stats();
+            std::snprintf(recording, sizeof(recording), ", recorded %.1f MB, %llu dropped",
+                          stats.bytes / (1024.0 * 1024.0), (unsigned long long)stats.dropped);
+        }
+        char exported[64] = "";
+        if (!sensor->config.exportDirectory.empty()) {
+            std::snprintf(exported, sizeof(exported), ", exported %.1f MB%s",
+                          sensor->exportedBytes.load() / (1024.0 * 1024.0),
+                          sensor->exportFailed.load() ? " (write failed)" : "");
+        }
+        const RadarPipeline::ReceiveStats received = sensor->pipeline.receiveStats();
+        logLine("[%s] %llu datagrams (%.1f MB/s avg), %llu track frames, %llu ADC frames, %llu malformed, "
+                "%llu ADC missing, %llu reordered, %llu zone events%s%s",
+                sensor->config.name.c_str(), (unsigned long long)received.datagrams,
+                seconds > 0.0 ? received.bytes / seconds / 1e6 : 0.0,
+                (unsigned long long)received.trackFrames, (unsigned long long)received.adcFrames,
+                (unsigned long long)sensor->pipeline.malformedCount(),
+                (unsigned long long)received.adcMissing, (unsigned long long)received.adcReordered,
+                (unsigned long long)sensor->zoneEvents.load(), recording, exported);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<SensorConfig> configs;
+    SensorConfig commandLine;
+    bool commandLineSensor = false;
+    double statsInterval = 10.0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        }
+
+        // --receive-buffer and the like map onto the config file keys
+        std::string key = arg.compare(0, 2, "--") == 0 ? arg.substr(2) : std::string();
+        std::replace(key.begin(), key.end(), '-', '_');
+        bool ok = !key.empty();
+        if (key == "raw_only" || key == "decoded_only") {
+            commandLine.recordRaw = key == "raw_only";
+            commandLine.recordDecoded = key == "decoded_only";
+            commandLineSensor = true;
+        } else if (key == "compress" || key == "process" || key == "cluster" || key == "track") {
+            applySetting(commandLine, statsInterval, key, "1");
+            commandLineSensor = true;
+        } else if (!ok || i + 1 >= argc) {
+            ok = false;
+        } else if (key == "config") {
+            if (!readConfig(argv[++i], configs, statsInterval)) return 2;
+        } else {
+            ok = applySetting(commandLine, statsInterval, key, argv[++i]);
+            commandLineSensor |= key != "stats";
+        }
+        if (!ok) {
+            std::fprintf(stderr, "radard: bad argument %s\n", arg.c_str());
+            usage();
+            return 2;
+        }
+    }
+    if (commandLineSensor || configs.empty()) {
+        configs.push_back(commandLine);
+    }
+
+    struct sigaction action{};
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::unique_ptr<Sensor>> sensors;
+    for (const SensorConfig& config : configs) {
+        sensors.push_back(std::make_unique<Sensor>());
+        sensors.back()->config = config;
+        if (!openSensor(*sensors.back())) return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::unique_ptr<Sensor>& sensor : sensors) {
+        sensor->thread = std::thread(runSensor, std::ref(*sensor), start);
+    }
+
+    auto lastStats = start;
+    while (!g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+        const auto now = std::chrono::steady_clock::now();
+        if (statsInterval > 0.0 && std::chrono::duration<double>(now - lastStats).count() >= statsInterval) {
+            lastStats = now;
+            printStats(sensors, std::chrono::duration<double>(now - start).count());
+        }
+    }
+
+    logLine("stopping");
+    for (std::unique_ptr<Sensor>& sensor : sensors) {
+        sensor->thread.join();
+        sensor->recorder.close();
+        sensor->exporter.close();
+        sensor->exportedBytes.store(sensor->exporter.bytesWritten());
+        sensor->exportFailed.store(sensor->exporter.writeFailed());
+        ::close(sensor->socket);
+    }
+    printStats(sensors, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return 0;
+}
@@ -0,0 +1,439 @@
+// recprocess - rerun the range/Doppler/CFAR chain over recorded ADC frames
+//
+//   recprocess FILE... [--output PATH] [--export DIR] [--window hann|hamming|blackman|rect] [--pad N]
+//              [--dc 0|1] [--static 0|1] [--cfar-guard N] [--cfar-train N] [--cfar-db DB]
+//              [--min-range M] [--max-range M] [--antennas N] [--samples N] [--sample-rate HZ]
+//              [--sweep S] [--bandwidth HZ] [--center-freq HZ] [--threads N] [--compress]
+//
+// Every chunk of every input is one unit of work. Worker threads claim
+// units in order from an atomic counter and may run up to a window of
+// units ahead of the commit;
+// the main thread commits finished units from that reorder buffer in unit
+// order while the workers continue. Detections are written in input order
+// at the original frame timestamps, so the output does not depend on the
+// thread count or on scheduling. With one input
+// --output names the new recording; with several it names a directory that
+// receives one recording per input, under the input's file name.
+//
+// --export writes column files (ColumnExporter.h) instead of or as well as
+// the recording: the new detections, every frame's range profile and the
+// tracks found in the input. With several inputs each gets a subdirectory.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ColumnExporter.h"
+#include "DatagramDecoder.h"
+#include "FrameProcessor.h"
+#include "RecordingReader.h"
+#include "RecordingWriter.h"
+
+namespace {
+
+const size_t UNITS_PER_THREAD = 8;    // Reorder buffer slots; bound the results held in memory
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: recprocess FILE... [--output PATH] [--export DIR] [options]\n"
+                 "  --output       new recording (one input) or directory (several inputs)\n"
+                 "  --export       column files of detections, range profiles and tracks\n"
+                 "  --window       hann (default), hamming, blackman or rect\n"
+                 "  --pad          range FFT zero-padding factor (default 1)\n"
+                 "  --dc           remove each chirp's mean (default 1)\n"
+                 "  --static       remove static clutter across chirps (default 0)\n"
+                 "  --cfar-guard   CFAR guard cells each side (default 2)\n"
+                 "  --cfar-train   CFAR training cells each side (default 8)\n"
+                 "  --cfar-db      CFAR threshold over the training mean (default 12)\n"
+                 "  --min-range, --max-range   detection range window in m\n"
+                 "  --antennas     receive antennas per frame (default 1)\n"
+                 "  --samples      samples per chirp (default: one chirp per antenna)\n"
+                 "  --sample-rate, --sweep, --bandwidth, --center-freq   FMCW parameters\n"
+                 "  --threads      worker threads (default: all cores)\n"
+                 "  --compress     compress the output chunks\n");
+}
+
+bool parseWindow(const std::string& name, RadarDSP::WindowType& window)
+{
+    if (name == "hann") window = RadarDSP::WindowHann;
+    else if (name == "hamming") window = RadarDSP::WindowHamming;
+    else if (name == "blackman") window = RadarDSP::WindowBlackman;
+    else if (name == "rect" || name == "none") window = RadarDSP::WindowRectangular;
+    else return false;
+    return true;
+}
+
+std::string baseName(const std::string& path)
+{
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::string stem(const std::string& path)
+{
+    const std::string name = baseName(path);
+    const size_t dot = name.find_last_of('.');
+    return dot == std::string::npos || dot == 0 ? name : name.substr(0, dot);
+}
+
+struct Input {
+    std::string path;
+    uint32_t typeMask;      // Records holding frames, as ReplayEngine picks them
+};
+
+struct Unit {
+    size_t input;
+    size_t chunk;
+};
+
+struct Frame {
+    uint64_t timestamp;
+    std::vector<Detection> detections;
+    std::vector<float> profileDb;   // Only when exporting
+    float binRange;
+};
+
+struct Tracks {
+    uint64_t timestamp;
+    TrackSnapshotPtr tracks;
+};
+
+// Everything one worker keeps between units
+struct Worker {
+    RecordingReader reader;
+    size_t input;
+    DatagramDecoder decoder;
+    FrameProcessor processor;
+    TrackSnapshotPtr tracks;
+    ADCFramePtr frame;
+};
+
+struct Result {
+    std::vector<Frame> frames;
+    std::vector<Tracks> tracks;     // Only when exporting
+    uint64_t sampleBytes;
+    bool failed;
+};
+
+TrackSnapshotPtr toSnapshot(const std::vector<Detection>& detections)
+{
+    std::shared_ptr<TargetTrackData> data = std::make_shared<TargetTrackData>();
+    data->resize(uint32_t(detections.size()));
+    for (size_t i = 0; i < detections.size(); ++i) {
+        TargetTrack& target = data->targets[i];
+        target = TargetTrack();
+        target.target_id = uint32_t(i + 1);
+        target.level = detections[i].level;
+        target.radius = detections[i].range;
+        target.azimuth = detections[i].azimuth;
+        target.radial_speed = detections[i].radial_speed;
+    }
+    return data;
+}
+
+void processUnit(const std::vector<Input>& inputs, const Unit& unit, bool exporting, Worker& worker, Result& result)
+{
+    result.frames.clear();
+    result.tracks.clear();
+    result.sampleBytes = 0;
+    result.failed = false;
+
+    if (worker.input != unit.input) {
+        worker.input = unit.input;
+        if (!worker.reader.open(inputs[unit.input].path)) {
+            worker.input = SIZE_MAX;
+            result.failed = true;
+            return;
+        }
+    }
+
+    const RecordingIndexEntry& entry = worker.reader.chunk(unit.chunk);
+    if (!worker.reader.seekToRecord(entry.firstRecord)) {
+        result.failed = true;
+        return;
+    }
+
+    const uint32_t typeMask = inputs[unit.input].typeMask;
+    RecordingReader::Record record;
+    for (uint32_t n = 0; n < entry.recordCount && worker.reader.next(record); ++n) {
+        if (record.type >= 32 || !((typeMask >> record.type) & 1u)) continue;
+        const int decoded = worker.decoder.decode(reinterpret_cast<const char*>(record.data), record.size,
+                                                  worker.tracks, worker.frame);
+        if ((decoded & DatagramDecoder::DecodedTracks) && exporting) {
+            result.tracks.push_back(Tracks{record.timestamp, worker.tracks});
+        }
+        if (!(decoded & DatagramDecoder::DecodedADCFrame)) continue;
+        if (!worker.processor.process(*worker.frame)) continue;
+
+        result.sampleBytes += worker.frame->complex_data.size() * sizeof(ComplexSample);
+        result.frames.push_back(Frame{record.timestamp, worker.processor.detections(),
+                                      exporting ? worker.processor.rangeProfileDb() : std::vector<float>(),
+                                      worker.processor.binRange()});
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> paths;
+    std::string output;
+    std::string exportDirectory;
+    FrameProcessor::Settings settings;
+    unsigned threads = 0;
+    bool compress = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (arg.compare(0, 2, "--") != 0) {
+            paths.push_back(arg);
+            continue;
+        } else if (arg == "--compress") {
+            compress = true;
+            continue;
+        } else if (!value) {
+            ok = false;
+        } else if (arg == "--output") {
+            output = value;
+        } else if (arg == "--export") {
+            exportDirectory = value;
+        } else if (arg == "--window") {
+            ok = parseWindow(value, settings.window);
+        } else if (arg == "--pad") {
+            settings.paddingFactor = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--dc") {
+            settings.removeDC = std::atoi(value) != 0;
+        } else if (arg == "--static") {
+            settings.removeStatic = std::atoi(value) != 0;
+        } else if (arg == "--cfar-guard") {
+            settings.cfarGuard = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--cfar-train") {
+            settings.cfarTraining = std::strtoul(value, nullptr, 10);
+            ok = settings.cfarTraining > 0;
+        } else if (arg == "--cfar-db") {
+            settings.cfarThresholdDb = std::strtof(value, nullptr);
+        } else if (arg == "--min-range") {
+            settings.minRange = std::strtof(value, nullptr);
+        } else if (arg == "--max-range") {
+            settings.maxRange = std::strtof(value, nullptr);
+        } else if (arg == "--antennas") {
+            settings.antennas = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--samples") {
+            settings.samplesPerChirp = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--sample-rate") {
+            settings.sampleRate = std::strtof(value, nullptr);
+        } else if (arg == "--sweep") {
+            settings.sweepTime = std::strtof(value, nullptr);
+        } else if (arg == "--bandwidth") {
+            settings.bandwidth = std::strtof(value, nullptr);
+        } else if (arg == "--center-freq") {
+            settings.centerFrequency = std::strtof(value, nullptr);
+        } else if (arg == "--threads") {
+            threads = unsigned(std::strtoul(value, nullptr, 10));
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "recprocess: bad argument %s\n", arg.c_str());
+            usage();
+            return 2;
+        }
+        ++i;
+    }
+    if (paths.empty() || (output.empty() && exportDirectory.empty())) {
+        usage();
+        return 2;
+    }
+
+    // Inputs are opened once here to plan the units
+    std::vector<Input> inputs;
+    std::vector<Unit> units;
+    uint64_t totalBytes = 0;
+    for (const std::string& path : paths) {
+        RecordingReader reader;
+        std::string error;
+        if (!reader.open(path, &error)) {
+            std::fprintf(stderr, "recprocess: %s\n", error.c_str());
+            return 1;
+        }
+        uint32_t seen = 0;
+        RecordingReader::Record record;
+        for (uint32_t i = 0; reader.chunkCount() > 0 && i < reader.chunk(0).recordCount && reader.next(record); ++i) {
+            seen |= 1u << record.type;
+        }
+        const uint32_t typeMask = (seen & (1u << Recording::RecordDatagram))
+            ? (1u << Recording::RecordDatagram) : (1u << Recording::RecordTracks) | (1u << Recording::RecordADCFrame);
+        for (size_t chunk = 0; chunk < reader.chunkCount(); ++chunk) {
+            units.push_back(Unit{inputs.size(), chunk});
+        }
+        inputs.push_back(Input{path, typeMask});
+        totalBytes += reader.fileSize();
+    }
+
+    auto outputPath = [&](size_t input) {
+        return paths.size() == 1 ? output : output + "/" + baseName(inputs[input].path);
+    };
+    auto exportPath = [&](size_t input) {
+        return paths.size() == 1 ? exportDirectory : exportDirectory + "/" + stem(inputs[input].path);
+    };
+    const bool exporting = !exportDirectory.empty();
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(new Worker());
+        workers.back()->input = SIZE_MAX;
+        workers.back()->processor.setSettings(settings);
+    }
+
+    RecordingWriter writer;
+    writer.setOffline(true);
+    writer.setCodec(compress ? Recording::CodecShuffleLZ : Recording::CodecNone);
+    ColumnExporter exporter;
+    bool exportFailed = false;
+    size_t writerInput = SIZE_MAX;
+
+    // Reorder buffer: unit u goes to slot u % window once unit u - window
+    // has been committed
+    const size_t window = size_t(threads) * UNITS_PER_THREAD;
+    std::vector<Result> results(window);
+    std::vector<uint8_t> ready(window, 0);
+    std::mutex mutex;
+    std::condition_variable readyChanged;   // A slot was filled
+    std::condition_variable spaceChanged;   // A slot was committed
+    std::atomic<size_t> nextUnit(0);
+    size_t committed = 0;
+    bool aborted = false;
+
+    uint64_t frames = 0;
+    uint64_t detections = 0;
+    uint64_t sampleBytes = 0;
+    uint64_t failedChunks = 0;
+    size_t inputsDone = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+
+    // Each worker claims the next unit, then waits until its slot is free
+    std::vector<std::thread> processing;
+    for (unsigned worker = 0; worker < threads; ++worker) {
+        processing.emplace_back([&, worker] {
+            for (;;) {
+                const size_t index = nextUnit.fetch_add(1, std::memory_order_relaxed);
+                if (index >= units.size()) return;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    spaceChanged.wait(lock, [&] { return aborted || index < committed + window; });
+                    if (aborted) return;
+                }
+                processUnit(inputs, units[index], exporting, *workers[worker], results[index % window]);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready[index % window] = 1;
+                }
+                readyChanged.notify_one();
+            }
+        });
+    }
+    auto joinProcessing = [&] {
+        for (std::thread& thread : processing) thread.join();
+    };
+    auto stopProcessing = [&] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
+        }
+        spaceChanged.notify_all();
+        joinProcessing();
+    };
+
+    // Commit in unit order
+    for (size_t index = 0; index < units.size(); ++index) {
+        const size_t slot = index % window;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readyChanged.wait(lock, [&] { return ready[slot] != 0; });
+        }
+
+        const Unit& unit = units[index];
+        Result& result = results[slot];
+        if (unit.input != writerInput) {
+            writer.close();
+            exporter.close();
+            exportFailed |= exporter.writeFailed();
+            writerInput = unit.input;
+            std::string error;
+            if ((!output.empty() && !writer.open(outputPath(unit.input), &error))
+                || (exporting && !exporter.open(exportPath(unit.input),
+                                                ColumnExporter::Tracks | ColumnExporter::Detections
+                                                | ColumnExporter::RangeProfiles, &error))) {
+                std::fprintf(stderr, "recprocess: %s\n", error.c_str());
+                stopProcessing();
+                return 1;
+            }
+            inputsDone = unit.input;
+        }
+        if (result.failed) {
+            ++failedChunks;
+        } else {
+            for (const Frame& frame : result.frames) {
+                if (writer.isOpen()) writer.writeTracks(toSnapshot(frame.detections), frame.timestamp);
+                exporter.addDetections(frame.detections, frame.timestamp);
+                exporter.addRangeProfile(frame.profileDb, frame.binRange, frame.timestamp);
+                detections += frame.detections.size();
+            }
+            for (const Tracks& tracks : result.tracks) {
+                exporter.addTracks(*tracks.tracks, tracks.timestamp);
+            }
+            frames += result.frames.size();
+            sampleBytes += result.sampleBytes;
+            result.tracks.clear();      // Back to the decoder's pool
+        }
+
+        // Hand the slot back to the workers
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[slot] = 0;
+            ++committed;
+        }
+        spaceChanged.notify_all();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::seconds(1)) {
+            lastReport = now;
+            const double seconds = std::chrono::duration<double>(now - start).count();
+            std::fprintf(stderr, "recprocess: %zu/%zu chunks, file %zu/%zu, %.0f frames/s, %.2f GB/s\n",
+                         index + 1, units.size(), inputsDone + 1, inputs.size(),
+                         frames / seconds, sampleBytes / seconds / 1e9);
+        }
+    }
+    joinProcessing();
+    writer.close();
+    exporter.close();
+    if (exportFailed || exporter.writeFailed()) {
+        std::fprintf(stderr, "recprocess: writing the column files failed\n");
+        return 1;
+    }
+
+    const double seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-9);
+    std::printf("%zu file%s, %zu chunks, %.1f MB in; %llu frames, %llu detections; %.2f s on %u threads: "
+                "%.0f frames/s, %.2f GB/s of samples, %.2f GB/s of recording\n",
+                inputs.size(), inputs.size() == 1 ? "" : "s", units.size(), totalBytes / 1e6,
+                (unsigned long long)frames, (unsigned long long)detections, seconds, threads,
+                frames / seconds, sampleBytes / seconds / 1e9,
+                totalBytes / seconds / 1e9);
+    if (failedChunks > 0) {
+        std::fprintf(stderr, "recprocess: %llu chunks could not be read\n", (unsigned long long)failedChunks);
+    }
+    return failedChunks > 0 ? 1 : 0;
+}
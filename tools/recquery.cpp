@@ -0,0 +1,147 @@
+// recquery - find the parts of a .radrec recording that match content criteria
+//
+//   recquery FILE [--from S] [--to S] [--range MIN:MAX] [--speed MIN[:MAX]]
+//                 [--tracks N] [--peak DB] [--gap S] [--summary]
+//
+// Times are seconds from the start of the recording. Chunks are pruned on
+// their stored summaries; --summary stops there and prints the candidate
+// chunk spans instead of decoding them. Exits with 0 when something
+// matched and 1 when nothing did.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "RecordingQuery.h"
+#include "RecordingReader.h"
+
+namespace {
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: recquery FILE [--from S] [--to S] [--range MIN:MAX] [--speed MIN[:MAX]]\n"
+                 "                     [--tracks N] [--peak DB] [--gap S] [--summary]\n"
+                 "  --from, --to   time window, seconds from the recording start\n"
+                 "  --range        track range window in m\n"
+                 "  --speed        |radial speed| window in m/s\n"
+                 "  --tracks       at least N matching tracks in one snapshot\n"
+                 "  --peak         ADC range-spectrum peak of at least DB (dB full scale); with\n"
+                 "                 track criteria, both must match within the merge gap\n"
+                 "  --gap          merge matches closer than S seconds (default 1)\n"
+                 "  --summary      answer from chunk summaries only, without decoding\n");
+}
+
+// "a:b" or "a"; a missing bound keeps its default
+bool parseRange(const char* text, float& low, float& high)
+{
+    char* end = nullptr;
+    if (*text != ':') {
+        low = std::strtof(text, &end);
+        if (end == text) return false;
+        text = end;
+    }
+    if (*text == ':') {
+        ++text;
+        if (*text) {
+            high = std::strtof(text, &end);
+            if (end == text || *end) return false;
+        }
+    } else if (*text) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+
+    RecordingQuery::Criteria criteria;
+    double fromSeconds = -1.0;
+    double toSeconds = -1.0;
+    double gapSeconds = 1.0;
+    bool summaryOnly = false;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (arg == "--summary") {
+            summaryOnly = true;
+            continue;
+        } else if (!value) {
+            ok = false;
+        } else if (arg == "--from") {
+            fromSeconds = std::atof(value);
+        } else if (arg == "--to") {
+            toSeconds = std::atof(value);
+        } else if (arg == "--range") {
+            ok = parseRange(value, criteria.minRange, criteria.maxRange);
+        } else if (arg == "--speed") {
+            ok = parseRange(value, criteria.minSpeed, criteria.maxSpeed);
+        } else if (arg == "--tracks") {
+            criteria.minTracks = uint32_t(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--peak") {
+            criteria.minPeakDb = std::strtof(value, nullptr);
+        } else if (arg == "--gap") {
+            gapSeconds = std::atof(value);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "recquery: bad argument %s\n", arg.c_str());
+            usage();
+            return 2;
+        }
+        ++i;
+    }
+
+    RecordingReader reader;
+    std::string error;
+    if (!reader.open(argv[1], &error)) {
+        std::fprintf(stderr, "recquery: %s\n", error.c_str());
+        return 1;
+    }
+
+    const uint64_t origin = reader.firstTimestamp();
+    if (fromSeconds >= 0.0) criteria.startTime = origin + uint64_t(fromSeconds * 1e6);
+    if (toSeconds >= 0.0) criteria.endTime = origin + uint64_t(toSeconds * 1e6);
+
+    std::printf("%s: %llu records in %zu chunks, %.1f s, %.1f MB%s\n", argv[1],
+                (unsigned long long)reader.recordCount(), reader.chunkCount(),
+                (reader.lastTimestamp() - origin) / 1e6, reader.fileSize() / 1e6,
+                reader.hasIndex() ? "" : " (index rebuilt)");
+
+    RecordingQuery query(reader);
+    query.setMergeGap(uint64_t(gapSeconds * 1e6));
+    std::vector<RecordingQuery::Match> matches;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (summaryOnly) {
+        query.runSummaries(criteria, matches);
+    } else {
+        query.run(criteria, matches);
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (const RecordingQuery::Match& match : matches) {
+        std::printf("%10.3f s - %10.3f s  (%.3f s, %llu %s)\n",
+                    (match.firstTimestamp - origin) / 1e6, (match.lastTimestamp - origin) / 1e6,
+                    (match.lastTimestamp - match.firstTimestamp) / 1e6,
+                    (unsigned long long)match.frames, summaryOnly ? "records" : "frames");
+    }
+
+    const RecordingQuery::Stats& stats = query.stats();
+    std::printf("%zu match%s; %zu of %zu chunks skipped by summary, %zu decoded, %llu records tested; %.1f ms\n",
+                matches.size(), matches.size() == 1 ? "" : "es",
+                stats.chunksSkipped, stats.chunks, stats.chunksDecoded,
+                (unsigned long long)stats.recordsTested, elapsedMs);
+    return matches.empty() ? 1 : 0;
+}
@@ -0,0 +1,443 @@
+// udploadgen - paced UDP load of track and ADC datagrams, for stress tests
+//
+//   udploadgen [--host H] [--port N] [--format binary|text] [--type tracks|adc|both]
+//              [--rate N] [--burst N] [--count N | --duration S] [--targets N]
+//              [--samples N] [--chirps N] [--antennas N] [--loss P] [--reorder P] [--seed N]
+//
+// Sends binary MessageHeader datagrams or the text format, to find the rate
+// at which a receiver starts losing data. Datagrams go out in bursts of
+// --burst, bursts on an absolute schedule of --rate datagrams per second
+// (sleep, then spin for the last stretch), so pacing errors do not add up.
+// With --type both, track and ADC datagrams alternate.
+//
+// Track datagrams carry --targets targets circling the sensor; ADC frames are
+// SceneSimulator frames of those targets, numbered by msgId from 1. --loss
+// skips a fraction of the datagrams and --reorder sends a fraction of them
+// after the next datagram of the same type; both are decided by --seed, and skipped ADC frames
+// still use up their msgId, so the receiver sees the gap. The first ADC frame
+// is always sent in order, and frames skipped after the last one sent are
+// not predicted as missing: a receiver cannot see a gap at either end.
+//
+// The final report lists what was sent and what a receiver on an idle
+// loopback should count (RadarVisualization's RX status, RadarPipeline's
+// receive stats).
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DataStructures.h"
+#include "DatagramDecoder.h"
+#include "SceneSimulator.h"
+#include "WireFormat.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t MAX_UDP_PAYLOAD = 65507;
+const size_t FRAME_VARIANTS = 32;          // Distinct ADC frames, cycled
+const double FRAME_INTERVAL = 0.05;        // s of target motion per frame variant
+const auto SPIN_TIME = std::chrono::microseconds(200);  // Busy-wait before each deadline
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int)
+{
+    g_stop = 1;
+}
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "usage: udploadgen [--host H] [--port N] [--format binary|text] [--type tracks|adc|both]\n"
+                 "                  [--rate N] [--burst N] [--count N | --duration S] [--targets N]\n"
+                 "                  [--samples N] [--chirps N] [--antennas N] [--loss P] [--reorder P] [--seed N]\n"
+                 "  --host, --port  destination (default 127.0.0.1:5000)\n"
+                 "  --format        binary MessageHeader datagrams (default) or the text format\n"
+                 "  --type          track datagrams, ADC datagrams or both, alternating (default)\n"
+                 "  --rate          datagrams per second (default 1000)\n"
+                 "  --burst         datagrams sent back to back per tick (default 1)\n"
+                 "  --count         datagrams to send; --duration S sends for S seconds (default 10 s)\n"
+                 "  --targets       targets per track datagram and ADC scene (default 8)\n"
+                 "  --samples, --chirps, --antennas   ADC frame shape (default 256 x 1 x 1)\n"
+                 "  --loss          fraction of datagrams deliberately not sent\n"
+                 "  --reorder       fraction of datagrams sent after the next one of their type\n"
+                 "  --seed          seed for the scene, loss and reordering (default 1)\n");
+}
+
+struct Config {
+    std::string host = "127.0.0.1";
+    uint16_t port = 5000;
+    bool text = false;
+    bool tracks = true;
+    bool adc = true;
+    double rate = 1000.0;
+    size_t burst = 1;
+    uint64_t count = 0;
+    double duration = 10.0;
+    size_t targets = 8;
+    size_t samples = 256;
+    size_t chirps = 1;
+    size_t antennas = 1;
+    double loss = 0.0;
+    double reorder = 0.0;
+    uint64_t seed = 1;
+};
+
+// Targets on circles around the sensor, so consecutive frames move smoothly
+void sceneAt(const Config& config, double time, std::vector<SceneSimulator::Target>& scene, TargetTrackData& tracks)
+{
+    scene.clear();
+    tracks.resize(uint32_t(config.targets));
+    for (size_t i = 0; i < config.targets; ++i) {
+        const float radius = 10.0f + 90.0f * float(i + 1) / float(config.targets + 1);
+        const float rate = 0.2f + 0.05f * float(i % 5);     // rad/s
+        const float angle = float(i) * 0.7f + rate * float(time);
+        const float x = radius * std::sin(angle);
+        const float y = 20.0f + radius * std::cos(angle);
+        const float range = std::sqrt(x * x + y * y);
+        // Radial speed of the circular motion, positive = approaching
+        const float speed = -radius * rate * (x * std::cos(angle) - y * std::sin(angle)) / range;
+
+        TargetTrack& track = tracks.targets[i];
+        track = TargetTrack();
+        track.target_id = uint32_t(i + 1);
+        track.level = 40.0f + float(i % 4) * 10.0f;
+        track.radius = range;
+        track.azimuth = std::atan2(x, y) * 180.0f / 3.14159265f;
+        track.radial_speed = speed;
+        scene.push_back(SceneSimulator::Target{range, track.azimuth, speed, 1.0f + float(i % 4)});
+    }
+}
+
+// Text track datagram, the sensor firmware's key/value layout (range in cm)
+void textTracks(const TargetTrackData& tracks, std::string& out)
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), "NumTargets: %u\n", unsigned(tracks.targets.size()));
+    out = line;
+    for (const TargetTrack& t : tracks.targets) {
+        std::snprintf(line, sizeof(line),
+                      "TgtId: %u Level: %.1f Range: %.1f Azimuth: %.2f Elevation: %.2f RadialSpeed: %.2f "
+                      "AzimuthSpeed: %.2f ElevationSpeed: %.2f\n",
+                      unsigned(t.target_id), t.level, t.radius * 100.0f, t.azimuth, t.elevation,
+                      t.radial_speed, t.azimuth_speed, t.elevation_speed);
+        out += line;
+    }
+}
+
+// Text ADC datagram with a fixed-width MsgId, patched in place per send
+const char MSG_ID_FORMAT[] = "MsgId: %010u";
+const size_t MSG_ID_DIGITS_OFFSET = 7;
+
+// Values as the firmware sends them (DatagramDecoder::TEXT_ADC_BLOCK): each
+// block's I values, then its Q values; NumSamples counts the values per chirp
+void textADCFrame(const RawADCFrameTest& frame, std::string& out)
+{
+    char value[64];
+    std::snprintf(value, sizeof(value), MSG_ID_FORMAT, 0u);
+    out = value;
+    std::snprintf(value, sizeof(value), " NumSamples: %u\n", unsigned(frame.num_samples_per_chirp * 2));
+    out += value;
+    const size_t count = frame.complex_data.size();
+    for (size_t block = 0; block < count; block += DatagramDecoder::TEXT_ADC_BLOCK) {
+        const size_t end = std::min(block + DatagramDecoder::TEXT_ADC_BLOCK, count);
+        for (size_t i = block; i < end; ++i) {
+            std::snprintf(value, sizeof(value), "ADC: %.5f\n", frame.complex_data[i].I);
+            out += value;
+        }
+        for (size_t i = block; i < end; ++i) {
+            std::snprintf(value, sizeof(value), "ADC: %.5f\n", frame.complex_data[i].Q);
+            out += value;
+        }
+    }
+}
+
+struct Datagram {
+    std::vector<uint8_t> bytes;
+    bool adc;
+};
+
+bool resolve(const std::string& host, uint16_t port, sockaddr_storage& address, socklen_t& length)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0 || !result) return false;
+    std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+    length = socklen_t(result->ai_addrlen);
+    freeaddrinfo(result);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = value != nullptr;
+        if (!ok) {
+        } else if (arg == "--host") {
+            config.host = value;
+        } else if (arg == "--port") {
+            const long port = std::strtol(value, nullptr, 10);
+            ok = port > 0 && port <= 65535;
+            config.port = uint16_t(port);
+        } else if (arg == "--format") {
+            ok = std::strcmp(value, "binary") == 0 || std::strcmp(value, "text") == 0;
+            config.text = std::strcmp(value, "text") == 0;
+        } else if (arg == "--type") {
+            const std::string type = value;
+            ok = type == "tracks" || type == "adc" || type == "both";
+            config.tracks = type != "adc";
+            config.adc = type != "tracks";
+        } else if (arg == "--rate") {
+            config.rate = std::atof(value);
+            ok = config.rate > 0.0;
+        } else if (arg == "--burst") {
+            config.burst = std::max<size_t>(std::strtoul(value, nullptr, 10), 1);
+        } else if (arg == "--count") {
+            config.count = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--duration") {
+            config.duration = std::atof(value);
+        } else if (arg == "--targets") {
+            config.targets = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--samples") {
+            config.samples = std::max<size_t>(std::strtoul(value, nullptr, 10), 1);
+        } else if (arg == "--chirps") {
+            config.chirps = std::max<size_t>(std::strtoul(value, nullptr, 10), 1);
+        } else if (arg == "--antennas") {
+            config.antennas = std::max<size_t>(std::strtoul(value, nullptr, 10), 1);
+        } else if (arg == "--loss") {
+            config.loss = std::atof(value);
+        } else if (arg == "--reorder") {
+            config.reorder = std::atof(value);
+        } else if (arg == "--seed") {
+            config.seed = std::strtoull(value, nullptr, 10);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "udploadgen: bad argument %s\n", arg.c_str());
+            usage();
+            return 2;
+        }
+        ++i;
+    }
+    if (config.count == 0) {
+        config.count = uint64_t(std::llround(config.rate * config.duration));
+    }
+
+    sockaddr_storage address;
+    socklen_t length;
+    if (!resolve(config.host, config.port, address, length)) {
+        std::fprintf(stderr, "udploadgen: cannot resolve %s\n", config.host.c_str());
+        return 1;
+    }
+    const int sock = ::socket(address.ss_family, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        std::fprintf(stderr, "udploadgen: socket: %s\n", std::strerror(errno));
+        return 1;
+    }
+    int sendBuffer = 8 << 20;
+    ::setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    // Everything is serialized up front; sending only patches ids and timestamps
+    SceneSimulator::Config sceneConfig;
+    sceneConfig.samplesPerChirp = config.samples;
+    sceneConfig.chirps = config.chirps;
+    sceneConfig.antennas = config.antennas;
+    sceneConfig.seed = config.seed;
+    SceneSimulator simulator(sceneConfig);
+
+    std::vector<Datagram> trackDatagrams;
+    std::vector<Datagram> adcDatagrams;
+    std::vector<SceneSimulator::Target> scene;
+    TargetTrackData tracks;
+    RawADCFrameTest frame;
+    std::string text;
+    for (size_t v = 0; v < FRAME_VARIANTS; ++v) {
+        sceneAt(config, double(v) * FRAME_INTERVAL, scene, tracks);
+        Datagram datagram;
+        if (config.tracks) {
+            if (config.text) {
+                textTracks(tracks, text);
+                datagram.bytes.assign(text.begin(), text.end());
+            } else {
+                WireFormat::serializeTracks(tracks, 0, datagram.bytes);
+            }
+            datagram.adc = false;
+            trackDatagrams.push_back(datagram);
+        }
+        if (config.adc) {
+            simulator.synthesize(scene, frame);
+            if (config.text) {
+                textADCFrame(frame, text);
+                datagram.bytes.assign(text.begin(), text.end());
+            } else {
+                WireFormat::serializeADCFrame(frame, 0, datagram.bytes);
+            }
+            datagram.adc = true;
+            adcDatagrams.push_back(datagram);
+        }
+        if (datagram.bytes.size() > MAX_UDP_PAYLOAD) {
+            std::fprintf(stderr, "udploadgen: %zu-byte datagrams exceed the UDP limit of %zu; "
+                         "use fewer samples, chirps or targets%s\n", datagram.bytes.size(), MAX_UDP_PAYLOAD,
+                         config.text ? " or the binary format" : "");
+            return 1;
+        }
+    }
+
+    struct sigaction action{};
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    std::mt19937_64 random(config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    uint64_t sent = 0;
+    uint64_t sentTracks = 0;
+    uint64_t sentADC = 0;
+    uint64_t bytes = 0;
+    uint64_t skipped = 0;
+    uint64_t skippedADC = 0;
+    uint64_t missingADC = 0;  // ADC frames skipped below the highest msgId sent
+    uint64_t reordered = 0;
+    uint64_t reorderedADC = 0;
+    uint64_t sendErrors = 0;
+    uint32_t adcId = 0;
+    double maxLateness = 0.0;
+    double totalLateness = 0.0;
+    uint64_t ticks = 0;
+
+    Datagram held;            // Reordered datagram, sent after the next one of its type
+    bool holding = false;
+    uint64_t heldSkippedADC = 0;
+
+    auto transmit = [&](const Datagram& datagram) {
+        if (::sendto(sock, datagram.bytes.data(), datagram.bytes.size(), 0,
+                     reinterpret_cast<const sockaddr*>(&address), length) < 0) {
+            ++sendErrors;
+            return;
+        }
+        ++sent;
+        bytes += datagram.bytes.size();
+        ++(datagram.adc ? sentADC : sentTracks);
+    };
+
+    const auto tickInterval = std::chrono::duration<double>(double(config.burst) / config.rate);
+    const Clock::time_point start = Clock::now();
+    auto lastReport = start;
+
+    for (uint64_t index = 0; index < config.count && !g_stop; ++ticks) {
+        const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(tickInterval * double(ticks));
+        if (deadline - Clock::now() > SPIN_TIME) {
+            std::this_thread::sleep_until(deadline - SPIN_TIME);
+        }
+        while (Clock::now() < deadline) {
+        }
+        const double lateness = std::chrono::duration<double>(Clock::now() - deadline).count();
+        maxLateness = std::max(maxLateness, lateness);
+        totalLateness += lateness;
+
+        for (size_t b = 0; b < config.burst && index < config.count; ++b, ++index) {
+            const bool adc = config.adc && (!config.tracks || index % 2 == 1);
+            std::vector<Datagram>& variants = adc ? adcDatagrams : trackDatagrams;
+            Datagram& datagram = variants[(index / (config.tracks && config.adc ? 2 : 1)) % variants.size()];
+
+            const uint64_t now = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            if (adc) {
+                ++adcId;
+                if (config.text) {
+                    char digits[16];
+                    std::snprintf(digits, sizeof(digits), "%010u", unsigned(adcId));
+                    std::memcpy(datagram.bytes.data() + MSG_ID_DIGITS_OFFSET, digits, 10);
+                } else {
+                    // msgId is the first payload field
+                    const uint8_t id[4] = {uint8_t(adcId), uint8_t(adcId >> 8), uint8_t(adcId >> 16), uint8_t(adcId >> 24)};
+                    std::memcpy(datagram.bytes.data() + sizeof(MessageHeader), id, sizeof(id));
+                }
+            }
+            if (!config.text) {
+                MessageHeader header;
+                WireFormat::deserializeHeader(datagram.bytes.data(), datagram.bytes.size(), header);
+                header.timestamp = now;
+                WireFormat::serializeHeader(header, datagram.bytes.data());
+            }
+
+            // The receiver's msgId sequence starts at the first ADC frame it sees
+            const bool firstADC = adc && adcId == 1;
+            if (!firstADC && unit(random) < config.loss) {
+                ++skipped;
+                if (adc) ++skippedADC;
+                continue;
+            }
+            if (!firstADC && !holding && unit(random) < config.reorder) {
+                held = datagram;
+                holding = true;
+                heldSkippedADC = skippedADC;
+                continue;
+            }
+            transmit(datagram);
+            if (adc) missingADC = skippedADC;
+            if (holding && held.adc == adc) {
+                transmit(held);
+                holding = false;
+                ++reordered;
+                if (adc) ++reorderedADC;
+            }
+        }
+
+        const auto now = Clock::now();
+        if (now - lastReport >= std::chrono::seconds(1)) {
+            lastReport = now;
+            const double seconds = std::chrono::duration<double>(now - start).count();
+            std::fprintf(stderr, "udploadgen: %llu sent, %.0f datagrams/s, %.1f MB/s\n",
+                         (unsigned long long)sent, sent / seconds, bytes / seconds / 1e6);
+        }
+    }
+    if (holding) {
+        // Nothing left to overtake it; an ADC frame held here is the newest sent
+        transmit(held);
+        if (held.adc) missingADC = heldSkippedADC;
+    }
+    ::close(sock);
+
+    const double seconds = std::max(std::chrono::duration<double>(Clock::now() - start).count(), 1e-9);
+    std::printf("sent %llu datagrams (%llu track, %llu ADC), %.1f MB in %.2f s: %.0f datagrams/s, %.1f MB/s\n",
+                (unsigned long long)sent, (unsigned long long)sentTracks, (unsigned long long)sentADC,
+                bytes / 1e6, seconds, sent / seconds, bytes / seconds / 1e6);
+    std::printf("deliberately skipped %llu (%llu ADC), reordered %llu (%llu ADC); %llu send errors\n",
+                (unsigned long long)skipped, (unsigned long long)skippedADC,
+                (unsigned long long)reordered, (unsigned long long)reorderedADC, (unsigned long long)sendErrors);
+    std::printf("pacing: %llu ticks of %llu, mean lateness %.1f us, max %.1f us\n",
+                (unsigned long long)ticks, (unsigned long long)config.burst,
+                totalLateness / std::max<uint64_t>(ticks, 1) * 1e6, maxLateness * 1e6);
+    std::printf("a lossless receiver counts %llu datagrams, %llu track frames, %llu ADC frames, "
+                "%llu ADC missing, %llu reordered\n",
+                (unsigned long long)sent, (unsigned long long)sentTracks, (unsigned long long)sentADC,
+                (unsigned long long)missingADC, (unsigned long long)reorderedADC);
+    return sendErrors > 0 ? 1 : 0;
+}